@@ -10,15 +10,21 @@ commands:
     animations          → Gets the current config'd info about animations
                           and beziers
     binds               → Lists all registered binds
-    clients             → Lists all windows with their properties
+    clients [since <gen>] → Lists all windows with their properties. With
+                          'since', only lists what changed after generation
+                          <gen>
     configerrors        → Lists all current config parsing errors
     cursorpos           → Gets the current cursor position in global layout
                           coordinates
+    damage              → Prints damage rect merging stats: rects merged
+                          and pixels saved over redrawing full extents
     decorations <window_regex> → Lists all decorations and their info
     devices             → Lists all connected keyboards and mice
     dismissnotify [amount] → Dismisses all or up to AMOUNT notifications
     dispatch <dispatcher> [args] → Issue a dispatch to call a keybind
                           dispatcher with arguments
+    geometry            → Prints window geometry cache stats: reads,
+                          recomputes and invalidations
     getoption <option>  → Gets the config option status (values)
     globalshortcuts     → Lists all global shortcuts
     hyprpaper ...       → Issue a hyprpaper request
@@ -31,9 +37,12 @@ commands:
                           kill an app by clicking on it. You can exit it
                           with ESCAPE
     layers              → Lists all the surface layers
+    layoutstats         → Prints the current layout's node count and the
+                          time spent adding, removing and recalculating
     layouts             → Lists all layouts available (including plugin'd ones)
     monitors            → Lists active outputs with their properties,
-                          'monitors all' lists active and inactive outputs
+                          'monitors all' lists active and inactive outputs.
+                          Also supports 'since <gen>'
     notify ...          → Sends a notification using the built-in Hyprland
                           notification system
     output ...          → Allows you to add and remove fake outputs to your
@@ -52,10 +61,13 @@ commands:
     splash              → Get the current splash
     switchxkblayout ... → Sets the xkb layout index for a keyboard
     systeminfo          → Get system info
+    timers              → Prints event loop timer stats: wakeups per second
+                          and dispatch latency over the last second
     version             → Prints the hyprland version, meaning flags, commit
                           and branch of build.
     workspacerules      → Lists all workspace rules
-    workspaces          → Lists all workspaces with their properties
+    workspaces          → Lists all workspaces with their properties. Also
+                          supports 'since <gen>'
 
 flags:
     -j                  → Output in JSON
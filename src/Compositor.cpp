@@ -1,9 +1,9 @@
 #include <ranges>
-#include <re2/re2.h>
 
 #include "Compositor.hpp"
 #include "debug/Log.hpp"
 #include "desktop/DesktopTypes.hpp"
+#include "desktop/WindowSelector.hpp"
 #include "helpers/Splashes.hpp"
 #include "config/ConfigValue.hpp"
 #include "config/ConfigWatcher.hpp"
@@ -41,6 +41,7 @@
 #include "protocols/core/Compositor.hpp"
 #include "protocols/core/Subcompositor.hpp"
 #include "desktop/LayerSurface.hpp"
+#include "desktop/WindowHitIndex.hpp"
 #include "render/Renderer.hpp"
 #include "xwayland/XWayland.hpp"
 #include "helpers/ByteOperations.hpp"
@@ -176,7 +177,20 @@ void CCompositor::setMallocThreshold() {
 #endif
 }
 
-CCompositor::CCompositor(bool onlyConfig) : m_onlyConfigVerification(onlyConfig), m_iHyprlandPID(getpid()) {
+static uint32_t windowHandle(const PHLWINDOW& pWindow) {
+    return (uint32_t)(((uint64_t)pWindow.get()) & 0xFFFFFFFF);
+}
+
+CCompositor::CCompositor(bool onlyConfig) :
+    m_workspacesByID(m_workspaces, [](const PHLWORKSPACE& w, const WORKSPACEID& id) { return w->m_id == id && !w->inert(); }),
+    m_workspacesByName(m_workspaces, [](const PHLWORKSPACE& w, const std::string& name) { return w->m_name == name && !w->inert(); }),
+    m_windowsByHandle(m_windows, [](const PHLWINDOW& w, const uint32_t& handle) { return windowHandle(w) == handle; }),
+    m_windowsByAddress(m_windows, [](const PHLWINDOW& w, const uintptr_t& address) { return (uintptr_t)w.get() == address; }),
+    m_monitorsByID(m_monitors, [](const PHLMONITOR& m, const MONITORID& id) { return m->ID == id; }),
+    m_monitorsByName(m_monitors, [](const PHLMONITOR& m, const std::string& name) { return m->szName == name; }), m_onlyConfigVerification(onlyConfig),
+    m_iHyprlandPID(getpid()) {
+    m_windowHitIndex = makeUnique<CWindowHitIndex>();
+
     if (onlyConfig)
         return;
 
@@ -782,22 +796,11 @@ void CCompositor::startCompositor() {
 }
 
 PHLMONITOR CCompositor::getMonitorFromID(const MONITORID& id) {
-    for (auto const& m : m_monitors) {
-        if (m->ID == id) {
-            return m;
-        }
-    }
-
-    return nullptr;
+    return m_monitorsByID.get(id);
 }
 
 PHLMONITOR CCompositor::getMonitorFromName(const std::string& name) {
-    for (auto const& m : m_monitors) {
-        if (m->szName == name) {
-            return m;
-        }
-    }
-    return nullptr;
+    return m_monitorsByName.get(name);
 }
 
 PHLMONITOR CCompositor::getMonitorFromDesc(const std::string& desc) {
@@ -854,6 +857,7 @@ void CCompositor::removeWindowFromVectorSafe(PHLWINDOW pWindow) {
     if (!pWindow->m_fadingOut) {
         EMIT_HOOK_EVENT("destroyWindow", pWindow);
 
+        unindexWindow(pWindow);
         std::erase_if(m_windows, [&](SP<CWindow>& el) { return el == pWindow; });
         std::erase_if(m_windowsFadingOut, [&](PHLWINDOWREF el) { return el.lock() == pWindow; });
     }
@@ -871,9 +875,12 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
     static auto PSPECIALFALLTHRU  = CConfigValue<Hyprlang::INT>("input:special_fallthrough");
     const auto  BORDER_GRAB_AREA  = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
 
+    // floating windows are checked at the pointer, the rest at pos. Same order as m_windows.
+    const auto CANDIDATES = m_windowHitIndex->candidatesAt({pos, g_pPointerManager->position()}, BORDER_GRAB_AREA);
+
     // pinned windows on top of floating regardless
     if (properties & ALLOW_FLOATING) {
-        for (auto const& w : m_windows | std::views::reverse) {
+        for (auto const& w : CANDIDATES | std::views::reverse) {
             if (w->m_isFloating && w->m_isMapped && !w->isHidden() && !w->m_X11ShouldntFocus && w->m_pinned && !w->m_windowData.noFocus.valueOrDefault() && w != pIgnoreWindow) {
                 const auto BB  = w->getWindowBoxUnified(properties);
                 CBox       box = BB.copy().expand(!w->isX11OverrideRedirect() ? BORDER_GRAB_AREA : 0);
@@ -890,7 +897,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
 
     auto windowForWorkspace = [&](bool special) -> PHLWINDOW {
         auto floating = [&](bool aboveFullscreen) -> PHLWINDOW {
-            for (auto const& w : m_windows | std::views::reverse) {
+            for (auto const& w : CANDIDATES | std::views::reverse) {
 
                 if (special && !w->onSpecialWorkspace()) // because special floating may creep up into regular
                     continue;
@@ -959,7 +966,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             return found;
 
         // for windows, we need to check their extensions too, first.
-        for (auto const& w : m_windows) {
+        for (auto const& w : CANDIDATES) {
             if (special != w->onSpecialWorkspace())
                 continue;
 
@@ -973,7 +980,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             }
         }
 
-        for (auto const& w : m_windows) {
+        for (auto const& w : CANDIDATES) {
             if (special != w->onSpecialWorkspace())
                 continue;
 
@@ -1204,8 +1211,15 @@ void CCompositor::focusWindow(PHLWINDOW pWindow, SP<CWLSurfaceResource> pSurface
         const auto HISTORYPIVOT = std::ranges::find_if(m_windowFocusHistory, [&](const auto& other) { return other.lock() == pWindow; });
         if (HISTORYPIVOT == m_windowFocusHistory.end())
             Debug::log(ERR, "BUG THIS: {} has no pivot in history", pWindow);
-        else
+        else {
+            // every window up to the pivot gets a new focus history id
+            for (auto it = m_windowFocusHistory.begin(); it != HISTORYPIVOT + 1; ++it) {
+                if (const auto PWINDOW = it->lock())
+                    PWINDOW->invalidateHyprctlSnapshot();
+            }
+
             std::rotate(m_windowFocusHistory.begin(), HISTORYPIVOT, HISTORYPIVOT + 1);
+        }
     }
 
     if (*PFOLLOWMOUSE == 0)
@@ -1318,22 +1332,11 @@ PHLWINDOW CCompositor::getWindowFromSurface(SP<CWLSurfaceResource> pSurface) {
 }
 
 PHLWINDOW CCompositor::getWindowFromHandle(uint32_t handle) {
-    for (auto const& w : m_windows) {
-        if ((uint32_t)(((uint64_t)w.get()) & 0xFFFFFFFF) == handle) {
-            return w;
-        }
-    }
-
-    return nullptr;
+    return m_windowsByHandle.get(handle);
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByID(const WORKSPACEID& id) {
-    for (auto const& w : m_workspaces) {
-        if (w->m_id == id && !w->inert())
-            return w;
-    }
-
-    return nullptr;
+    return m_workspacesByID.get(id);
 }
 
 void CCompositor::sanityCheckWorkspaces() {
@@ -1343,6 +1346,7 @@ void CCompositor::sanityCheckWorkspaces() {
 
         // If ref == 1, only the compositor holds a ref, which means it's inactive and has no mapped windows.
         if (!WORKSPACE->m_persistent && WORKSPACE.strongRef() == 1) {
+            unindexWorkspace(WORKSPACE);
             it = m_workspaces.erase(it);
             continue;
         }
@@ -1732,12 +1736,7 @@ WORKSPACEID CCompositor::getNextAvailableNamedWorkspace() {
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByName(const std::string& name) {
-    for (auto const& w : m_workspaces) {
-        if (w->m_name == name && !w->inert())
-            return w;
-    }
-
-    return nullptr;
+    return m_workspacesByName.get(name);
 }
 
 PHLWORKSPACE CCompositor::getWorkspaceByString(const std::string& str) {
@@ -1752,6 +1751,88 @@ PHLWORKSPACE CCompositor::getWorkspaceByString(const std::string& str) {
     return nullptr;
 }
 
+void CCompositor::indexWindow(PHLWINDOW pWindow) {
+    m_windowsByHandle.add(windowHandle(pWindow), pWindow);
+    m_windowsByAddress.add((uintptr_t)pWindow.get(), pWindow);
+}
+
+void CCompositor::unindexWindow(PHLWINDOW pWindow) {
+    m_windowsByHandle.remove(windowHandle(pWindow), pWindow);
+    m_windowsByAddress.remove((uintptr_t)pWindow.get(), pWindow);
+    unindexMappedWindow(pWindow);
+}
+
+void CCompositor::indexMappedWindow(PHLWINDOW pWindow) {
+    unindexMappedWindow(pWindow);
+
+    const auto PID = pWindow->getPID();
+    m_mappedWindowsByPID[PID].emplace_back(pWindow);
+    pWindow->m_indexedPID = PID;
+}
+
+void CCompositor::unindexMappedWindow(PHLWINDOW pWindow) {
+    if (!pWindow->m_indexedPID)
+        return;
+
+    // the pid can't be asked for anymore once the client is gone, hence the stored one
+    const auto IT = m_mappedWindowsByPID.find(*pWindow->m_indexedPID);
+    pWindow->m_indexedPID.reset();
+
+    if (IT == m_mappedWindowsByPID.end())
+        return;
+
+    std::erase_if(IT->second, [&pWindow](const auto& other) { return other.expired() || other.lock() == pWindow; });
+
+    if (IT->second.empty())
+        m_mappedWindowsByPID.erase(IT);
+}
+
+std::vector<PHLWINDOW> CCompositor::getMappedWindowsByPID(pid_t pid) {
+    const auto IT = m_mappedWindowsByPID.find(pid);
+    if (IT == m_mappedWindowsByPID.end())
+        return {};
+
+    std::vector<PHLWINDOW> result;
+    for (auto const& ref : IT->second) {
+        const auto PWINDOW = ref.lock();
+        if (PWINDOW && PWINDOW->m_isMapped)
+            result.emplace_back(PWINDOW);
+    }
+
+    if (result.size() < 2)
+        return result;
+
+    // a client with several windows, keep the order callers would've found them in
+    std::vector<PHLWINDOW> ordered;
+    ordered.reserve(result.size());
+    for (auto const& w : m_windows) {
+        if (std::ranges::find(result, w) != result.end())
+            ordered.emplace_back(w);
+    }
+
+    return ordered;
+}
+
+void CCompositor::indexWorkspace(PHLWORKSPACE pWorkspace) {
+    m_workspacesByID.add(pWorkspace->m_id, pWorkspace);
+    m_workspacesByName.add(pWorkspace->m_name, pWorkspace);
+}
+
+void CCompositor::unindexWorkspace(PHLWORKSPACE pWorkspace) {
+    m_workspacesByID.remove(pWorkspace->m_id, pWorkspace);
+    m_workspacesByName.remove(pWorkspace->m_name, pWorkspace);
+}
+
+void CCompositor::indexMonitor(PHLMONITOR pMonitor) {
+    m_monitorsByID.add(pMonitor->ID, pMonitor);
+    m_monitorsByName.add(pMonitor->szName, pMonitor);
+}
+
+void CCompositor::unindexMonitor(PHLMONITOR pMonitor) {
+    m_monitorsByID.remove(pMonitor->ID, pMonitor);
+    m_monitorsByName.remove(pMonitor->szName, pMonitor);
+}
+
 bool CCompositor::isPointOnAnyMonitor(const Vector2D& point) {
     return std::ranges::any_of(
         m_monitors, [&](const PHLMONITOR& m) { return VECINRECT(point, m->vecPosition.x, m->vecPosition.y, m->vecSize.x + m->vecPosition.x, m->vecSize.y + m->vecPosition.y); });
@@ -2415,114 +2496,8 @@ void CCompositor::scheduleFrameForMonitor(PHLMONITOR pMonitor, IOutput::schedule
     pMonitor->output->scheduleFrame(reason);
 }
 
-PHLWINDOW CCompositor::getWindowByRegex(const std::string& regexp_) {
-    auto regexp = trim(regexp_);
-
-    if (regexp.starts_with("active"))
-        return m_lastWindow.lock();
-    else if (regexp.starts_with("floating") || regexp.starts_with("tiled")) {
-        // first floating on the current ws
-        if (!valid(m_lastWindow))
-            return nullptr;
-
-        const bool FLOAT = regexp.starts_with("floating");
-
-        for (auto const& w : m_windows) {
-            if (!w->m_isMapped || w->m_isFloating != FLOAT || w->m_workspace != m_lastWindow->m_workspace || w->isHidden())
-                continue;
-
-            return w;
-        }
-
-        return nullptr;
-    }
-
-    eFocusWindowMode mode = MODE_CLASS_REGEX;
-
-    std::string      regexCheck;
-    std::string      matchCheck;
-    if (regexp.starts_with("class:")) {
-        regexCheck = regexp.substr(6);
-    } else if (regexp.starts_with("initialclass:")) {
-        mode       = MODE_INITIAL_CLASS_REGEX;
-        regexCheck = regexp.substr(13);
-    } else if (regexp.starts_with("title:")) {
-        mode       = MODE_TITLE_REGEX;
-        regexCheck = regexp.substr(6);
-    } else if (regexp.starts_with("initialtitle:")) {
-        mode       = MODE_INITIAL_TITLE_REGEX;
-        regexCheck = regexp.substr(13);
-    } else if (regexp.starts_with("tag:")) {
-        mode       = MODE_TAG_REGEX;
-        regexCheck = regexp.substr(4);
-    } else if (regexp.starts_with("address:")) {
-        mode       = MODE_ADDRESS;
-        matchCheck = regexp.substr(8);
-    } else if (regexp.starts_with("pid:")) {
-        mode       = MODE_PID;
-        matchCheck = regexp.substr(4);
-    }
-
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (!w->m_isMapped || (w->isHidden() && !g_pLayoutManager->getCurrentLayout()->isWindowReachable(w)))
-            continue;
-
-        switch (mode) {
-            case MODE_CLASS_REGEX: {
-                const auto windowClass = w->m_class;
-                if (!RE2::FullMatch(windowClass, regexCheck))
-                    continue;
-                break;
-            }
-            case MODE_INITIAL_CLASS_REGEX: {
-                const auto initialWindowClass = w->m_initialClass;
-                if (!RE2::FullMatch(initialWindowClass, regexCheck))
-                    continue;
-                break;
-            }
-            case MODE_TITLE_REGEX: {
-                const auto windowTitle = w->m_title;
-                if (!RE2::FullMatch(windowTitle, regexCheck))
-                    continue;
-                break;
-            }
-            case MODE_INITIAL_TITLE_REGEX: {
-                const auto initialWindowTitle = w->m_initialTitle;
-                if (!RE2::FullMatch(initialWindowTitle, regexCheck))
-                    continue;
-                break;
-            }
-            case MODE_TAG_REGEX: {
-                bool tagMatched = false;
-                for (auto const& t : w->m_tags.getTags()) {
-                    if (RE2::FullMatch(t, regexCheck)) {
-                        tagMatched = true;
-                        break;
-                    }
-                }
-                if (!tagMatched)
-                    continue;
-                break;
-            }
-            case MODE_ADDRESS: {
-                std::string addr = std::format("0x{:x}", (uintptr_t)w.get());
-                if (matchCheck != addr)
-                    continue;
-                break;
-            }
-            case MODE_PID: {
-                std::string pid = std::format("{}", w->getPID());
-                if (matchCheck != pid)
-                    continue;
-                break;
-            }
-            default: break;
-        }
-
-        return w;
-    }
-
-    return nullptr;
+PHLWINDOW CCompositor::getWindowByRegex(const std::string& regexp) {
+    return CWindowSelector::get(regexp)->find();
 }
 
 void CCompositor::warpCursorTo(const Vector2D& pos, bool force) {
@@ -2645,6 +2620,7 @@ PHLWORKSPACE CCompositor::createNewWorkspace(const WORKSPACEID& id, const MONITO
     }
 
     const auto PWORKSPACE = m_workspaces.emplace_back(CWorkspace::create(id, PMONITOR, NAME, SPECIAL, isEmpty));
+    indexWorkspace(PWORKSPACE);
 
     PWORKSPACE->m_alpha->setValueAndWarp(0);
 
@@ -7,11 +7,13 @@
 #include "managers/SessionLockManager.hpp"
 #include "desktop/Window.hpp"
 #include "protocols/types/ColorManagement.hpp"
+#include "helpers/LookupIndex.hpp"
 
 #include <aquamarine/backend/Backend.hpp>
 #include <aquamarine/output/Output.hpp>
 
 class CWLSurfaceResource;
+class CWindowHitIndex;
 struct SWorkspaceRule;
 
 enum eManagersInitStage : uint8_t {
@@ -49,6 +51,19 @@ class CCompositor {
     std::unordered_map<std::string, MONITORID>   m_monitorIDMap;
     std::unordered_map<std::string, WORKSPACEID> m_seenMonitorWorkspaceMap; // map of seen monitor names to workspace IDs
 
+    UP<CWindowHitIndex>                          m_windowHitIndex;
+
+    // for the getters below, kept in sync through index*() / unindex*()
+    CLookupIndex<WORKSPACEID, CWorkspace>        m_workspacesByID;
+    CLookupIndex<std::string, CWorkspace>        m_workspacesByName;
+    CLookupIndex<uint32_t, CWindow>              m_windowsByHandle;
+    CLookupIndex<uintptr_t, CWindow>             m_windowsByAddress;
+    CLookupIndex<MONITORID, CMonitor>            m_monitorsByID;
+    CLookupIndex<std::string, CMonitor>          m_monitorsByName;
+
+    // mapped windows by pid, kept in sync through indexMappedWindow() / unindexMappedWindow()
+    std::unordered_map<pid_t, std::vector<PHLWINDOWREF>> m_mappedWindowsByPID;
+
     void                                         initServer(std::string socketName, int socketFd);
     void                                         startCompositor();
     void                                         stopCompositor();
@@ -93,9 +108,18 @@ class CCompositor {
     PHLMONITOR             getRealMonitorFromOutput(SP<Aquamarine::IOutput>);
     PHLWINDOW              getWindowFromSurface(SP<CWLSurfaceResource>);
     PHLWINDOW              getWindowFromHandle(uint32_t);
+    std::vector<PHLWINDOW> getMappedWindowsByPID(pid_t); // in m_windows order
     PHLWORKSPACE           getWorkspaceByID(const WORKSPACEID&);
     PHLWORKSPACE           getWorkspaceByName(const std::string&);
     PHLWORKSPACE           getWorkspaceByString(const std::string&);
+    void                   indexWindow(PHLWINDOW);         // after adding to m_windows
+    void                   unindexWindow(PHLWINDOW);       // before removing from m_windows
+    void                   indexMappedWindow(PHLWINDOW);   // after mapping
+    void                   unindexMappedWindow(PHLWINDOW); // when unmapping or removing
+    void                   indexWorkspace(PHLWORKSPACE);   // after adding to m_workspaces or renaming
+    void                   unindexWorkspace(PHLWORKSPACE); // before removing from m_workspaces or renaming
+    void                   indexMonitor(PHLMONITOR);       // after adding to m_monitors
+    void                   unindexMonitor(PHLMONITOR);     // before removing from m_monitors
     void                   sanityCheckWorkspaces();
     PHLWINDOW              getUrgentWindow();
     bool                   isWindowActive(PHLWINDOW);
@@ -1444,6 +1444,18 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{true},
     },
+    SConfigOptionDescription{
+        .value       = "render:damage_rect_cost",
+        .description = "How many pixels one damage rect is worth when redrawing. Rects are merged while that draws fewer extra pixels than this. 0 disables merging.",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{16384, 0, 1048576},
+    },
+    SConfigOptionDescription{
+        .value       = "render:upload_rect_cost",
+        .description = "Like damage_rect_cost, for uploads of shm textures.",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{4096, 0, 1048576},
+    },
 
     /*
      * cursor:
@@ -14,6 +14,8 @@
 #include "../protocols/OutputManagement.hpp"
 #include "../managers/AnimationManager.hpp"
 #include "../desktop/LayerSurface.hpp"
+#include "../desktop/WindowRuleIndex.hpp"
+#include "../helpers/proc/ProcessTree.hpp"
 #include "defaultConfig.hpp"
 
 #include "../render/Renderer.hpp"
@@ -40,10 +42,12 @@
 #include <xkbcommon/xkbcommon.h>
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <ranges>
+#include <typeindex>
 #include <unordered_set>
 #include <hyprutils/string/String.hpp>
 #include <filesystem>
@@ -265,6 +269,10 @@ static Hyprlang::CParseResult handleAnimation(const char* c, const char* v) {
     return result;
 }
 
+static Hyprlang::CParseResult handlePluginKeyword(const char* c, const char* v) {
+    return g_pConfigManager->handlePluginKeyword(c, v);
+}
+
 static Hyprlang::CParseResult handleBind(const char* c, const char* v) {
     const std::string      VALUE   = v;
     const std::string      COMMAND = c;
@@ -411,29 +419,39 @@ static Hyprlang::CParseResult handlePermission(const char* c, const char* v) {
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::INT& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::FLOAT& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::VEC2& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, const Hyprlang::STRING& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, val);
 }
 
 void CConfigManager::registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val) {
     m_configValueNumber++;
+    m_configValueNames.emplace_back(name);
     m_config->addConfigValue(name, std::move(val));
 }
 
+void CConfigManager::registerDeviceVar(const char* name, const Hyprlang::CConfigValue& val) {
+    m_deviceValueNames.emplace_back(name);
+    m_config->addSpecialConfigValue("device", name, val);
+}
+
 CConfigManager::CConfigManager() {
     const auto ERR = verifyConfigExists();
 
@@ -739,6 +757,8 @@ CConfigManager::CConfigManager() {
     registerConfigVar("render:ctm_animation", Hyprlang::INT{2});
     registerConfigVar("render:cm_fs_passthrough", Hyprlang::INT{2});
     registerConfigVar("render:cm_enabled", Hyprlang::INT{1});
+    registerConfigVar("render:damage_rect_cost", Hyprlang::INT{16384});
+    registerConfigVar("render:upload_rect_cost", Hyprlang::INT{4096});
 
     registerConfigVar("ecosystem:no_update_news", Hyprlang::INT{0});
     registerConfigVar("ecosystem:no_donation_nag", Hyprlang::INT{0});
@@ -748,43 +768,43 @@ CConfigManager::CConfigManager() {
 
     // devices
     m_config->addSpecialCategory("device", {"name"});
-    m_config->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_config->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_config->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_config->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_config->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "transform", Hyprlang::INT{-1});
-    m_config->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_config->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_config->addSpecialConfigValue("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_config->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
-    m_config->addSpecialConfigValue("device", "flip_x", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "flip_y", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
+    registerDeviceVar("sensitivity", {0.F});
+    registerDeviceVar("accel_profile", {STRVAL_EMPTY});
+    registerDeviceVar("kb_file", {STRVAL_EMPTY});
+    registerDeviceVar("kb_layout", {"us"});
+    registerDeviceVar("kb_variant", {STRVAL_EMPTY});
+    registerDeviceVar("kb_options", {STRVAL_EMPTY});
+    registerDeviceVar("kb_rules", {STRVAL_EMPTY});
+    registerDeviceVar("kb_model", {STRVAL_EMPTY});
+    registerDeviceVar("repeat_rate", Hyprlang::INT{25});
+    registerDeviceVar("repeat_delay", Hyprlang::INT{600});
+    registerDeviceVar("natural_scroll", Hyprlang::INT{0});
+    registerDeviceVar("tap_button_map", {STRVAL_EMPTY});
+    registerDeviceVar("numlock_by_default", Hyprlang::INT{0});
+    registerDeviceVar("resolve_binds_by_sym", Hyprlang::INT{0});
+    registerDeviceVar("disable_while_typing", Hyprlang::INT{1});
+    registerDeviceVar("clickfinger_behavior", Hyprlang::INT{0});
+    registerDeviceVar("middle_button_emulation", Hyprlang::INT{0});
+    registerDeviceVar("tap-to-click", Hyprlang::INT{1});
+    registerDeviceVar("tap-and-drag", Hyprlang::INT{1});
+    registerDeviceVar("drag_lock", Hyprlang::INT{0});
+    registerDeviceVar("left_handed", Hyprlang::INT{0});
+    registerDeviceVar("scroll_method", {STRVAL_EMPTY});
+    registerDeviceVar("scroll_button", Hyprlang::INT{0});
+    registerDeviceVar("scroll_button_lock", Hyprlang::INT{0});
+    registerDeviceVar("scroll_points", {STRVAL_EMPTY});
+    registerDeviceVar("transform", Hyprlang::INT{-1});
+    registerDeviceVar("output", {STRVAL_EMPTY});
+    registerDeviceVar("enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    registerDeviceVar("region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    registerDeviceVar("absolute_region_position", Hyprlang::INT{0}); // only for tablets
+    registerDeviceVar("region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    registerDeviceVar("relative_input", Hyprlang::INT{0});           // only for tablets
+    registerDeviceVar("active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    registerDeviceVar("active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    registerDeviceVar("flip_x", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceVar("flip_y", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceVar("keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
 
     // keywords
     m_config->registerHandler(&::handleExec, "exec", {false});
@@ -907,12 +927,100 @@ std::string CConfigManager::getErrors() {
     return m_configErrors;
 }
 
+static std::string configValueString(Hyprlang::CConfigValue* val) {
+    if (!val)
+        return "";
+
+    const auto  VAL  = val->getValue();
+    const auto  TYPE = std::type_index(VAL.type());
+    std::string str;
+
+    if (TYPE == typeid(Hyprlang::INT))
+        str = std::to_string(std::any_cast<Hyprlang::INT>(VAL));
+    else if (TYPE == typeid(Hyprlang::FLOAT))
+        str = std::format("{}", std::any_cast<Hyprlang::FLOAT>(VAL));
+    else if (TYPE == typeid(Hyprlang::VEC2))
+        str = std::format("{} {}", std::any_cast<Hyprlang::VEC2>(VAL).x, std::any_cast<Hyprlang::VEC2>(VAL).y);
+    else if (TYPE == typeid(Hyprlang::STRING))
+        str = std::any_cast<Hyprlang::STRING>(VAL);
+    else if (TYPE == typeid(void*))
+        str = ((ICustomConfigValueData*)std::any_cast<void*>(VAL))->toString();
+
+    // device values fall back to the global ones when unset
+    return val->m_bSetByUser ? str : str + " (unset)";
+}
+
+bool SConfigDiff::optionsUnder(const std::vector<std::string>& prefixes) const {
+    if (everything)
+        return true;
+
+    return std::ranges::any_of(options, [&prefixes](const auto& o) { return std::ranges::any_of(prefixes, [&o](const auto& p) { return o.starts_with(p); }); });
+}
+
+CConfigManager::SAppliedConfig CConfigManager::snapshotConfig() {
+    SAppliedConfig snapshot;
+    snapshot.valid = true;
+    snapshot.options.reserve(m_configValueNames.size());
+
+    for (auto const& name : m_configValueNames) {
+        snapshot.options[name] = configValueString(m_config->getConfigValuePtr(name.c_str()));
+    }
+
+    for (auto const& dev : m_config->listKeysForSpecialCategory("device")) {
+        for (auto const& name : m_deviceValueNames) {
+            snapshot.options[std::format("device[{}]:{}", dev, name)] = configValueString(m_config->getSpecialConfigValuePtr("device", name.c_str(), dev.c_str()));
+        }
+    }
+
+    for (auto const& var : m_pluginVariables) {
+        snapshot.options["plugin:" + var.name] = configValueString(m_config->getSpecialConfigValuePtr("plugin", var.name.c_str(), nullptr));
+    }
+
+    snapshot.rules   = m_ruleSources;
+    snapshot.plugins = m_declaredPlugins;
+
+    return snapshot;
+}
+
+SConfigDiff CConfigManager::diffAgainstApplied() {
+    auto        current = snapshotConfig();
+    SConfigDiff diff;
+
+    // a plugin coming or going can touch anything
+    if (m_appliedConfig.valid && !m_fullReload && current.plugins == m_appliedConfig.plugins) {
+        diff.everything = false;
+
+        for (auto const& [name, value] : current.options) {
+            if (auto it = m_appliedConfig.options.find(name); it == m_appliedConfig.options.end() || it->second != value)
+                diff.options.emplace_back(name);
+        }
+
+        for (auto const& [name, _] : m_appliedConfig.options) {
+            if (!current.options.contains(name))
+                diff.options.emplace_back(name);
+        }
+
+        diff.monitorRules   = current.rules.monitor != m_appliedConfig.rules.monitor;
+        diff.workspaceRules = current.rules.workspace != m_appliedConfig.rules.workspace;
+        diff.windowRules    = current.rules.window != m_appliedConfig.rules.window;
+        diff.layerRules     = current.rules.layer != m_appliedConfig.rules.layer;
+        diff.animations     = current.rules.animation != m_appliedConfig.rules.animation;
+        diff.pluginKeywords = current.rules.plugin != m_appliedConfig.rules.plugin;
+    }
+
+    m_appliedConfig = std::move(current);
+
+    return diff;
+}
+
 void CConfigManager::reload() {
     EMIT_HOOK_EVENT("preConfigReload", nullptr);
     setDefaultAnimationVars();
     resetHLConfig();
     m_configCurrentPath                   = getMainConfigPath();
+    m_parsingReload                       = true;
     const auto ERR                        = m_config->parse();
+    m_parsingReload                       = false;
     m_lastConfigVerificationWasSuccessful = !ERR.error;
     postConfigReload(ERR);
 }
@@ -975,6 +1083,8 @@ void CConfigManager::setDefaultAnimationVars() {
 std::optional<std::string> CConfigManager::resetHLConfig() {
     m_monitorRules.clear();
     m_windowRules.clear();
+    m_windowRuleIndex.reset();
+    m_ruleSources = {};
     g_pKeybindManager->clearKeybinds();
     g_pAnimationManager->removeAllBeziers();
     g_pAnimationManager->addBezierWithName("linear", Vector2D(0.0, 0.0), Vector2D(1.0, 1.0));
@@ -1010,25 +1120,50 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     static const auto PENABLEEXPLICIT     = CConfigValue<Hyprlang::INT>("render:explicit_sync");
     static int        prevEnabledExplicit = *PENABLEEXPLICIT;
 
+    const auto        DIFF         = diffAgainstApplied();
+    const bool        RULESCHANGED = DIFF.windowRules || DIFF.workspaceRules;
+    const bool        ANIMSCHANGED = DIFF.animations || DIFF.optionsUnder({"animations:"});
+    // plugin keywords (e.g. bar buttons) and animations feed decorations without any option changing
+    const bool        DECOSCHANGED = RULESCHANGED || DIFF.pluginKeywords || ANIMSCHANGED;
+
+    // only refresh what depends on something that changed, and time what does
+    std::string       refreshed, skipped;
+    const auto        refresh = [&refreshed, &skipped](const char* name, bool needed, const std::function<void()>& fn) {
+        if (!needed) {
+            skipped += std::format("{}{}", skipped.empty() ? "" : ", ", name);
+            return;
+        }
+
+        const auto BEGIN = std::chrono::steady_clock::now();
+        fn();
+        const auto US = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - BEGIN).count();
+        refreshed += std::format("{}{} {:.2f}ms", refreshed.empty() ? "" : ", ", name, US / 1000.F);
+    };
+
     updateWatcher();
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        w->uncacheWindowDecos();
-    }
+    // plugins can add decorations with their own options
+    refresh("layout", DECOSCHANGED || DIFF.optionsUnder({"general:", "decoration:", "group:", "dwindle:", "master:", "plugin:"}), [] {
+        for (auto const& w : g_pCompositor->m_windows) {
+            w->uncacheWindowDecos();
+        }
 
-    for (auto const& m : g_pCompositor->m_monitors)
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+        for (auto const& m : g_pCompositor->m_monitors)
+            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+    });
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
     if (!m_isFirstLaunch) {
-        g_pInputManager->setKeyboardLayout();
-        g_pInputManager->setPointerConfigs();
-        g_pInputManager->setTouchDeviceConfigs();
-        g_pInputManager->setTabletConfigs();
+        refresh("input", DIFF.optionsUnder({"input:", "device["}), [] {
+            g_pInputManager->setKeyboardLayout();
+            g_pInputManager->setPointerConfigs();
+            g_pInputManager->setTouchDeviceConfigs();
+            g_pInputManager->setTabletConfigs();
+        });
 
-        g_pHyprOpenGL->m_bReloadScreenShader = true;
+        refresh("screen shader", DIFF.optionsUnder({"decoration:screen_shader"}), [] { g_pHyprOpenGL->m_bReloadScreenShader = true; });
 
-        g_pHyprOpenGL->ensureBackgroundTexturePresence();
+        refresh("background", DIFF.optionsUnder({"misc:"}), [] { g_pHyprOpenGL->ensureBackgroundTexturePresence(); });
     }
 
     // parseError will be displayed next frame
@@ -1055,10 +1190,11 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     // and they'll be taken care of in the newMonitor event
     // ignore if nomonitorreload is set
     if (!m_isFirstLaunch && !m_noMonitorReload) {
-        // check
-        performMonitorReload();
-        ensureMonitorStatus();
-        ensureVRR();
+        refresh("monitors", DIFF.monitorRules || m_wantsMonitorReload || DIFF.optionsUnder({"misc:vrr", "render:", "cursor:", "debug:", "experimental:"}), [this] {
+            performMonitorReload();
+            ensureMonitorStatus();
+            ensureVRR();
+        });
     }
 
 #ifndef NO_XWAYLAND
@@ -1075,18 +1211,23 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 #endif
 
     if (!m_isFirstLaunch && !g_pCompositor->m_unsafeState)
-        refreshGroupBarGradients();
+        refresh("group bar", DIFF.optionsUnder({"group:"}), [this] { refreshGroupBarGradients(); });
 
-    // Updates dynamic window and workspace rules
-    for (auto const& w : g_pCompositor->m_workspaces) {
-        if (w->inert())
-            continue;
-        w->updateWindows();
-        w->updateWindowData();
-    }
+    // Updates dynamic window and workspace rules, updateWindowData also applies no_border_on_floating
+    refresh("rules", RULESCHANGED || DIFF.optionsUnder({"general:no_border_on_floating"}), [] {
+        for (auto const& w : g_pCompositor->m_workspaces) {
+            if (w->inert())
+                continue;
+            w->updateWindows();
+            w->updateWindowData();
+        }
+    });
+
+    refresh("layer rules", DIFF.layerRules, [this] { reapplyLayerRules(); });
 
     // Update window border colors
-    g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+    refresh("decoration values", DECOSCHANGED || DIFF.optionsUnder({"general:", "decoration:", "group:", "misc:", "plugin:"}),
+            [] { g_pCompositor->updateAllWindowsAnimatedDecorationValues(); });
 
     // update layout
     g_pLayoutManager->switchToLayout(std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("general:layout")));
@@ -1107,9 +1248,12 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 
     Debug::m_coloredLogs = reinterpret_cast<int64_t* const*>(m_config->getConfigValuePtr("debug:colored_stdout_logs")->getDataStaticPtr());
 
+    const bool BLURCHANGED = DIFF.optionsUnder({"decoration:"});
+
     for (auto const& m : g_pCompositor->m_monitors) {
         // mark blur dirty
-        g_pHyprOpenGL->markBlurDirtyForMonitor(m);
+        if (BLURCHANGED)
+            g_pHyprOpenGL->markBlurDirtyForMonitor(m);
 
         g_pCompositor->scheduleFrameForMonitor(m);
 
@@ -1123,12 +1267,16 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
 
     // Reset no monitor reload
     m_noMonitorReload = false;
+    m_fullReload      = false;
+
+    Debug::log(LOG, "Config reload: {} changed, refreshed: [{}], skipped: [{}]", DIFF.everything ? "everything" : std::format("{} options", DIFF.options.size()), refreshed,
+               skipped);
 
     // update plugins
     handlePluginLoads();
 
     // update persistent workspaces
-    if (!m_isFirstLaunch)
+    if (!m_isFirstLaunch && (DIFF.workspaceRules || DIFF.monitorRules))
         ensurePersistentWorkspacesPresent();
 
     EMIT_HOOK_EVENT("configReloaded", nullptr);
@@ -1155,11 +1303,11 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
 
     const auto        RET = m_config->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
-    // invalidate layouts if they changed
-    if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
-        for (auto const& m : g_pCompositor->m_monitors)
-            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
-    }
+    // what's live no longer matches what the last reload applied
+    if (!m_appliedConfig.options.erase(COMMAND))
+        m_appliedConfig.valid = false;
+
+    // layouts and decorations are refreshed by the caller, see keywordRefreshFor in HyprCtl.cpp
 
     if (COMMAND.contains("explicit")) {
         if (*PENABLEEXPLICIT != prevEnabledExplicit)
@@ -1168,9 +1316,6 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
             g_pHyprError->destroy();
     }
 
-    // Update window border colors
-    g_pCompositor->updateAllWindowsAnimatedDecorationValues();
-
     // manual crash
     if (std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:manual_crash")) && !m_manualCrashInitiated) {
         m_manualCrashInitiated = true;
@@ -1347,16 +1492,23 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
 
     std::vector<SP<CWindowRule>> returns;
 
-    Debug::log(LOG, "Searching for matching rules for {} (title: {})", pWindow->m_class, pWindow->m_title);
+    Debug::log(TRACE, "Searching for matching rules for {} (title: {})", pWindow->m_class, pWindow->m_title);
+
+    if (!m_windowRuleIndex)
+        m_windowRuleIndex = makeUnique<CWindowRuleIndex>(m_windowRules);
 
     // since some rules will be applied later, we need to store some flags
     bool hasFloating   = pWindow->m_isFloating;
     bool hasFullscreen = pWindow->isFullscreen();
 
     // local tags for dynamic tag rule match
-    auto tags = pWindow->m_tags;
+    auto                           tags = pWindow->m_tags;
+
+    CWindowRuleIndex::SWindowMatch regexMatch;
+
+    for (auto const& idx : m_windowRuleIndex->candidatesFor(pWindow, dynamic)) {
+        const auto& rule = m_windowRules[idx];
 
-    for (auto const& rule : m_windowRules) {
         // check if we have a matching rule
         if (!rule->m_v2) {
             try {
@@ -1400,31 +1552,13 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
                         continue;
                 }
 
-                if (!rule->m_fullscreenState.empty()) {
-                    const auto ARGS = CVarList(rule->m_fullscreenState, 2, ' ');
-                    //
-                    std::optional<eFullscreenMode> internalMode, clientMode;
-
-                    if (ARGS[0] == "*")
-                        internalMode = std::nullopt;
-                    else if (isNumber(ARGS[0]))
-                        internalMode = (eFullscreenMode)std::stoi(ARGS[0]);
-                    else
-                        throw std::runtime_error("szFullscreenState internal mode not valid");
-
-                    if (ARGS[1] == "*")
-                        clientMode = std::nullopt;
-                    else if (isNumber(ARGS[1]))
-                        clientMode = (eFullscreenMode)std::stoi(ARGS[1]);
-                    else
-                        throw std::runtime_error("szFullscreenState client mode not valid");
-
-                    if (internalMode.has_value() && pWindow->m_fullscreenState.internal != internalMode)
-                        continue;
+                const auto& COMPILED = rule->m_compiled;
 
-                    if (clientMode.has_value() && pWindow->m_fullscreenState.client != clientMode)
-                        continue;
-                }
+                if (COMPILED.fullscreenInternal.has_value() && pWindow->m_fullscreenState.internal != COMPILED.fullscreenInternal)
+                    continue;
+
+                if (COMPILED.fullscreenClient.has_value() && pWindow->m_fullscreenState.client != COMPILED.fullscreenClient)
+                    continue;
 
                 if (!rule->m_onWorkspace.empty()) {
                     const auto PWORKSPACE = pWindow->m_workspace;
@@ -1432,53 +1566,40 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
                         continue;
                 }
 
-                if (!rule->m_contentType.empty()) {
-                    try {
-                        const auto contentType = NContentType::fromString(rule->m_contentType);
-                        if (pWindow->getContentType() != contentType)
-                            continue;
-                    } catch (std::exception& e) { Debug::log(ERR, "Rule \"content:{}\" failed with: {}", rule->m_contentType, e.what()); }
-                }
+                if (COMPILED.contentType.has_value() && pWindow->getContentType() != COMPILED.contentType)
+                    continue;
 
                 if (!rule->m_xdgTag.empty()) {
                     if (pWindow->xdgTag().value_or("") != rule->m_xdgTag)
                         continue;
                 }
 
-                if (!rule->m_workspace.empty()) {
+                if (COMPILED.workspaceID.has_value() || COMPILED.workspaceName.has_value()) {
                     const auto PWORKSPACE = pWindow->m_workspace;
 
                     if (!PWORKSPACE)
                         continue;
 
-                    if (rule->m_workspace.starts_with("name:")) {
-                        if (PWORKSPACE->m_name != rule->m_workspace.substr(5))
-                            continue;
-                    } else {
-                        // number
-                        if (!isNumber(rule->m_workspace))
-                            throw std::runtime_error("szWorkspace not name: or number");
-
-                        const int64_t ID = std::stoll(rule->m_workspace);
+                    if (COMPILED.workspaceName.has_value() && PWORKSPACE->m_name != *COMPILED.workspaceName)
+                        continue;
 
-                        if (PWORKSPACE->m_id != ID)
-                            continue;
-                    }
+                    if (COMPILED.workspaceID.has_value() && PWORKSPACE->m_id != *COMPILED.workspaceID)
+                        continue;
                 }
 
                 if (!rule->m_tag.empty() && !tags.isTagged(rule->m_tag))
                     continue;
 
-                if (!rule->m_class.empty() && !rule->m_classRegex.passes(pWindow->m_class))
+                if (!rule->m_class.empty() && !m_windowRuleIndex->passes(idx, CWindowRuleIndex::FIELD_CLASS, pWindow->m_class, regexMatch))
                     continue;
 
-                if (!rule->m_title.empty() && !rule->m_titleRegex.passes(pWindow->m_title))
+                if (!rule->m_title.empty() && !m_windowRuleIndex->passes(idx, CWindowRuleIndex::FIELD_TITLE, pWindow->m_title, regexMatch))
                     continue;
 
-                if (!rule->m_initialTitle.empty() && !rule->m_initialTitleRegex.passes(pWindow->m_initialTitle))
+                if (!rule->m_initialTitle.empty() && !m_windowRuleIndex->passes(idx, CWindowRuleIndex::FIELD_INITIAL_TITLE, pWindow->m_initialTitle, regexMatch))
                     continue;
 
-                if (!rule->m_initialClass.empty() && !rule->m_initialClassRegex.passes(pWindow->m_initialClass))
+                if (!rule->m_initialClass.empty() && !m_windowRuleIndex->passes(idx, CWindowRuleIndex::FIELD_INITIAL_CLASS, pWindow->m_initialClass, regexMatch))
                     continue;
 
             } catch (std::exception& e) {
@@ -1488,7 +1609,7 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
         }
 
         // applies. Read the rule and behave accordingly
-        Debug::log(LOG, "Window rule {} -> {} matched {}", rule->m_rule, rule->m_value, pWindow);
+        Debug::log(TRACE, "Window rule {} -> {} matched {}", rule->m_rule, rule->m_value, pWindow);
 
         returns.emplace_back(rule);
 
@@ -1508,21 +1629,23 @@ std::vector<SP<CWindowRule>> CConfigManager::getMatchingRules(PHLWINDOW pWindow,
             hasFullscreen = true;
     }
 
-    std::vector<uint64_t> PIDs = {(uint64_t)pWindow->getPID()};
-    while (getPPIDof(PIDs.back()) > 10)
-        PIDs.push_back(getPPIDof(PIDs.back()));
+    // nothing to match the process tree against
+    if (m_execRequestedRules.empty())
+        return returns;
 
-    bool anyExecFound = false;
+    const auto PIDs = NProcessTree::ancestryOf(pWindow->getPID());
+
+    bool       anyExecFound = false;
 
     for (auto const& er : m_execRequestedRules) {
-        if (std::ranges::any_of(PIDs, [&](const auto& pid) { return pid == er.iPid; })) {
+        if (std::ranges::any_of(PIDs, [&](const auto& pid) { return (uint64_t)pid == er.iPid; })) {
             returns.emplace_back(makeShared<CWindowRule>(er.szRule, "", false, true));
             anyExecFound = true;
         }
     }
 
     if (anyExecFound && !shadowExec) // remove exec rules to unclog searches in the future, why have the garbage here.
-        std::erase_if(m_execRequestedRules, [&](const SExecRequestedRule& other) { return std::ranges::any_of(PIDs, [&](const auto& pid) { return pid == other.iPid; }); });
+        std::erase_if(m_execRequestedRules, [&](const SExecRequestedRule& other) { return std::ranges::any_of(PIDs, [&](const auto& pid) { return (uint64_t)pid == other.iPid; }); });
 
     return returns;
 }
@@ -1824,7 +1947,8 @@ void CConfigManager::addPluginConfigVar(HANDLE handle, const std::string& name,
 
 void CConfigManager::addPluginKeyword(HANDLE handle, const std::string& name, Hyprlang::PCONFIGHANDLERFUNC fn, Hyprlang::SHandlerOptions opts) {
     m_pluginKeywords.emplace_back(SPluginKeyword{handle, name, fn});
-    m_config->registerHandler(fn, name.c_str(), opts);
+    // goes through handlePluginKeyword, so reloads can tell what plugin keywords changed
+    m_config->registerHandler(&::handlePluginKeyword, name.c_str(), opts);
 }
 
 void CConfigManager::removePluginConfig(HANDLE handle) {
@@ -1960,6 +2084,7 @@ static bool parseModeLine(const std::string& modeline, drmModeModeInfo& mode) {
 }
 
 std::optional<std::string> CConfigManager::handleMonitor(const std::string& command, const std::string& args) {
+    m_ruleSources.monitor.emplace_back(args);
 
     // get the monitor config
     SMonitorRule newrule;
@@ -2175,6 +2300,8 @@ std::optional<std::string> CConfigManager::handleMonitor(const std::string& comm
 }
 
 std::optional<std::string> CConfigManager::handleBezier(const std::string& command, const std::string& args) {
+    m_ruleSources.animation.emplace_back(command + "=" + args);
+
     const auto  ARGS = CVarList(args);
 
     std::string bezierName = ARGS[0];
@@ -2204,6 +2331,8 @@ std::optional<std::string> CConfigManager::handleBezier(const std::string& comma
 }
 
 std::optional<std::string> CConfigManager::handleAnimation(const std::string& command, const std::string& args) {
+    m_ruleSources.animation.emplace_back(command + "=" + args);
+
     const auto ARGS = CVarList(args);
 
     // Master on/off
@@ -2413,6 +2542,8 @@ std::optional<std::string> CConfigManager::handleUnbind(const std::string& comma
 }
 
 std::optional<std::string> CConfigManager::handleWindowRule(const std::string& command, const std::string& value) {
+    m_ruleSources.window.emplace_back(command + "=" + value);
+
     const auto RULE  = trim(value.substr(0, value.find_first_of(',')));
     const auto VALUE = value.substr(value.find_first_of(',') + 1);
 
@@ -2556,6 +2687,10 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
     if (XDGTAGPOS != std::string::npos)
         rule->m_xdgTag = extract(XDGTAGPOS + 8);
 
+    rule->compile();
+
+    m_windowRuleIndex.reset();
+
     if (RULE == "unset") {
         std::erase_if(m_windowRules, [&](const auto& other) {
             if (!other->m_v2)
@@ -2618,6 +2753,8 @@ std::optional<std::string> CConfigManager::handleWindowRule(const std::string& c
 }
 
 std::optional<std::string> CConfigManager::handleLayerRule(const std::string& command, const std::string& value) {
+    m_ruleSources.layer.emplace_back(value);
+
     const auto RULE  = trim(value.substr(0, value.find_first_of(',')));
     const auto VALUE = trim(value.substr(value.find_first_of(',') + 1));
 
@@ -2641,12 +2778,18 @@ std::optional<std::string> CConfigManager::handleLayerRule(const std::string& co
 
     m_layerRules.emplace_back(rule);
 
+    // a reload reapplies them once, after parsing, if they changed
+    if (!m_parsingReload)
+        reapplyLayerRules();
+
+    return {};
+}
+
+void CConfigManager::reapplyLayerRules() {
     for (auto const& m : g_pCompositor->m_monitors)
         for (auto const& lsl : m->m_aLayerSurfaceLayers)
             for (auto const& ls : lsl)
                 ls->applyRules();
-
-    return {};
 }
 
 void CConfigManager::updateBlurredLS(const std::string& name, const bool forceBlur) {
@@ -2684,6 +2827,8 @@ std::optional<std::string> CConfigManager::handleBlurLS(const std::string& comma
 }
 
 std::optional<std::string> CConfigManager::handleWorkspaceRules(const std::string& command, const std::string& value) {
+    m_ruleSources.workspace.emplace_back(value);
+
     // This can either be the monitor or the workspace identifier
     const auto FIRST_DELIM = value.find_first_of(',');
 
@@ -2926,6 +3071,30 @@ std::optional<std::string> CConfigManager::handlePermission(const std::string& c
     return {};
 }
 
+Hyprlang::CParseResult CConfigManager::handlePluginKeyword(const std::string& command, const std::string& value) {
+    m_ruleSources.plugin.emplace_back(command + "=" + value);
+
+    // keywords that allow flags get them appended, the longest keyword the command starts with is the one
+    const SPluginKeyword* keyword = nullptr;
+    for (auto const& k : m_pluginKeywords) {
+        if (k.name == command) {
+            keyword = &k;
+            break;
+        }
+
+        if (command.starts_with(k.name) && (!keyword || k.name.length() > keyword->name.length()))
+            keyword = &k;
+    }
+
+    if (!keyword || !keyword->fn) {
+        Hyprlang::CParseResult result;
+        result.setError(std::format("no plugin handles the keyword {}", command).c_str());
+        return result;
+    }
+
+    return keyword->fn(command.c_str(), value.c_str());
+}
+
 const std::vector<SConfigOptionDescription>& CConfigManager::getAllDescriptions() {
     return CONFIG_OPTIONS;
 }
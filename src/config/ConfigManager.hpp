@@ -27,6 +27,8 @@
 
 #define HANDLE void*
 
+class CWindowRuleIndex;
+
 struct SWorkspaceRule {
     std::string                        monitor         = "";
     std::string                        workspaceString = "";
@@ -69,6 +71,20 @@ struct SExecRequestedRule {
     uint64_t    iPid   = 0;
 };
 
+// what a reload changed compared to the config the previous reload applied
+struct SConfigDiff {
+    bool                     everything = true; // nothing to compare against
+    std::vector<std::string> options;
+    bool                     monitorRules   = true;
+    bool                     workspaceRules = true;
+    bool                     windowRules    = true;
+    bool                     layerRules     = true;
+    bool                     animations     = true; // animation and bezier keywords
+    bool                     pluginKeywords = true;
+
+    bool                     optionsUnder(const std::vector<std::string>& prefixes) const;
+};
+
 enum eConfigOptionType : uint8_t {
     CONFIG_OPTION_BOOL         = 0,
     CONFIG_OPTION_INT          = 1, /* e.g. 0/1/2*/
@@ -255,11 +271,13 @@ class CConfigManager {
     std::optional<std::string> handleEnv(const std::string&, const std::string&);
     std::optional<std::string> handlePlugin(const std::string&, const std::string&);
     std::optional<std::string> handlePermission(const std::string&, const std::string&);
+    Hyprlang::CParseResult     handlePluginKeyword(const std::string&, const std::string&);
 
     std::string                m_configCurrentPath;
 
     bool                       m_wantsMonitorReload                  = false;
     bool                       m_noMonitorReload                     = false;
+    bool                       m_fullReload                          = false; // refresh everything, not only what changed
     bool                       m_isLaunchingExecOnce                 = false; // For exec-once to skip initial ws tracking
     bool                       m_lastConfigVerificationWasSuccessful = true;
 
@@ -281,11 +299,13 @@ class CConfigManager {
     std::vector<SPluginKeyword>                      m_pluginKeywords;
     std::vector<SPluginVariable>                     m_pluginVariables;
 
-    bool                                             m_isFirstLaunch = true; // For exec-once
+    bool                                             m_isFirstLaunch = true;  // For exec-once
+    bool                                             m_parsingReload = false; // inside reload()'s parse, rules get applied once it's done
 
     std::vector<SMonitorRule>                        m_monitorRules;
     std::vector<SWorkspaceRule>                      m_workspaceRules;
     std::vector<SP<CWindowRule>>                     m_windowRules;
+    UP<CWindowRuleIndex>                             m_windowRuleIndex; // built lazily from m_windowRules, reset when they change
     std::vector<SP<CLayerRule>>                      m_layerRules;
     std::vector<std::string>                         m_blurLSNamespaces;
 
@@ -299,9 +319,27 @@ class CConfigManager {
     std::string                                      m_configErrors = "";
 
     uint32_t                                         m_configValueNumber = 0;
+    std::vector<std::string>                         m_configValueNames;
+    std::vector<std::string>                         m_deviceValueNames;
+
+    // rule, animation and plugin keywords as written, in parse order, to tell whether a reload changed them
+    struct SRuleSources {
+        std::vector<std::string> monitor, workspace, window, layer, animation, plugin;
+    };
+
+    struct SAppliedConfig {
+        bool                                         valid = false;
+        std::unordered_map<std::string, std::string> options; // name -> value as text
+        SRuleSources                                 rules;
+        std::vector<std::string>                     plugins;
+    };
+
+    SRuleSources                                     m_ruleSources;
+    SAppliedConfig                                   m_appliedConfig; // what the last reload refreshed against
 
     // internal methods
     void                                      updateBlurredLS(const std::string&, const bool);
+    void                                      reapplyLayerRules();
     void                                      setDefaultAnimationVars();
     std::optional<std::string>                resetHLConfig();
     std::optional<std::string>                generateConfig(std::string configPath);
@@ -314,6 +352,10 @@ class CConfigManager {
     void                                      registerConfigVar(const char* name, const Hyprlang::VEC2& val);
     void                                      registerConfigVar(const char* name, const Hyprlang::STRING& val);
     void                                      registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&& val);
+    void                                      registerDeviceVar(const char* name, const Hyprlang::CConfigValue& val);
+
+    SAppliedConfig                            snapshotConfig();
+    SConfigDiff                               diffAgainstApplied();
 
     std::unordered_map<SFloatCache, Vector2D> m_mStoredFloatingSizes;
 
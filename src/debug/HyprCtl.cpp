@@ -14,7 +14,7 @@
 #include <sys/utsname.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <sys/poll.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <ranges>
 
@@ -24,8 +24,10 @@
 #include <numeric>
 
 #include <hyprutils/string/String.hpp>
+#include <hyprutils/utils/ScopeGuard.hpp>
 using namespace Hyprutils::String;
 using namespace Hyprutils::OS;
+using namespace Hyprutils::Utils;
 #include <aquamarine/input/Input.hpp>
 
 #include "../config/ConfigDataValues.hpp"
@@ -49,6 +51,8 @@ using namespace Hyprutils::OS;
 #include "../managers/LayoutManager.hpp"
 #include "../plugins/PluginSystem.hpp"
 #include "../managers/AnimationManager.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../helpers/math/RegionSimplify.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
@@ -85,14 +89,88 @@ static std::string availableModesForOutput(PHLMONITOR pMonitor, eHyprCtlOutputFo
     return result;
 }
 
+template <typename T>
+static void refreshSnapshot(SHyprCtlSnapshot<T>& snapshot, T&& state) {
+    snapshot.dirty = false;
+
+    if (snapshot.generation != 0 && snapshot.state == state)
+        return;
+
+    snapshot.state = std::move(state);
+    snapshot.json.reset();
+    snapshot.normal.reset();
+    snapshot.generation = ++g_pHyprCtl->m_snapshotGeneration;
+}
+
+template <typename T>
+static std::optional<std::string>& snapshotFragment(SHyprCtlSnapshot<T>& snapshot, eHyprCtlOutputFormat format) {
+    return format == eHyprCtlOutputFormat::FORMAT_JSON ? snapshot.json : snapshot.normal;
+}
+
+// parses the optional trailing "since <generation>" of a snapshot request. Returns false on a malformed arg.
+static bool parseSnapshotSince(const CVarList& vars, size_t idx, std::optional<uint64_t>& since) {
+    if (vars.size() <= idx)
+        return true;
+
+    if (vars[idx] != "since" || vars.size() != idx + 2)
+        return false;
+
+    try {
+        since = std::stoull(vars[idx + 1]);
+    } catch (std::exception& e) { return false; }
+
+    return true;
+}
+
+static SHyprCtlMonitorState getMonitorState(PHLMONITOR m) {
+    return SHyprCtlMonitorState{
+        .id                   = m->ID,
+        .name                 = m->szName,
+        .description          = m->szShortDescription,
+        .make                 = m->output->make,
+        .model                = m->output->model,
+        .serial               = m->output->serial,
+        .width                = (int)m->vecPixelSize.x,
+        .height               = (int)m->vecPixelSize.y,
+        .refreshRate          = m->refreshRate,
+        .x                    = (int)m->vecPosition.x,
+        .y                    = (int)m->vecPosition.y,
+        .activeWorkspaceID    = m->activeWorkspaceID(),
+        .activeWorkspaceName  = m->activeWorkspace ? m->activeWorkspace->m_name : "",
+        .specialWorkspaceID   = m->activeSpecialWorkspaceID(),
+        .specialWorkspaceName = m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_name : "",
+        .reserved             = {(int)m->vecReservedTopLeft.x, (int)m->vecReservedTopLeft.y, (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y},
+        .scale                = m->scale,
+        .transform            = (int)m->transform,
+        .focused              = m == g_pCompositor->m_lastMonitor,
+        .dpms                 = m->dpmsStatus,
+        .vrr                  = m->output->state->state().adaptiveSync,
+        .solitary             = (uintptr_t)m->solitaryClient.get(),
+        .activelyTearing      = m->tearingState.activelyTearing,
+        .directScanoutTo      = (uintptr_t)m->lastScanout.get(),
+        .disabled             = !m->m_bEnabled,
+        .drmFormat            = m->output->state->state().drmFormat,
+        .mirrorOf             = m->pMirrorOf ? (int64_t)m->pMirrorOf->ID : -1,
+        .modes                = m->output->modes.size(),
+    };
+}
+
 std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
-    std::string result;
     if (!m->output || m->ID == -1)
         return "";
 
+    refreshSnapshot(m->hyprctlSnapshot, getMonitorState(m));
+
+    auto& fragment = snapshotFragment(m->hyprctlSnapshot, format);
+    if (fragment)
+        return *fragment;
+
+    const auto& S        = m->hyprctlSnapshot.state;
+    const auto  MIRROROF = S.mirrorOf == -1 ? std::string{"none"} : std::format("{}", S.mirrorOf);
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
 
-        result += std::format(
+        fragment = std::format(
             R"#({{
     "id": {},
     "name": "{}",
@@ -128,41 +206,50 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
     "availableModes": [{}]
 }},)#",
 
-            m->ID, escapeJSONStrings(m->szName), escapeJSONStrings(m->szShortDescription), escapeJSONStrings(m->output->make), escapeJSONStrings(m->output->model),
-            escapeJSONStrings(m->output->serial), (int)m->vecPixelSize.x, (int)m->vecPixelSize.y, m->refreshRate, (int)m->vecPosition.x, (int)m->vecPosition.y,
-            m->activeWorkspaceID(), (!m->activeWorkspace ? "" : escapeJSONStrings(m->activeWorkspace->m_name)), m->activeSpecialWorkspaceID(),
-            escapeJSONStrings(m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_name : ""), (int)m->vecReservedTopLeft.x, (int)m->vecReservedTopLeft.y,
-            (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y, m->scale, (int)m->transform, (m == g_pCompositor->m_lastMonitor ? "true" : "false"),
-            (m->dpmsStatus ? "true" : "false"), (m->output->state->state().adaptiveSync ? "true" : "false"), (uint64_t)m->solitaryClient.get(),
-            (m->tearingState.activelyTearing ? "true" : "false"), (uint64_t)m->lastScanout.get(), (m->m_bEnabled ? "false" : "true"),
-            formatToString(m->output->state->state().drmFormat), m->pMirrorOf ? std::format("{}", m->pMirrorOf->ID) : "none", availableModesForOutput(m, format));
+            S.id, escapeJSONStrings(S.name), escapeJSONStrings(S.description), escapeJSONStrings(S.make), escapeJSONStrings(S.model), escapeJSONStrings(S.serial), S.width,
+            S.height, S.refreshRate, S.x, S.y, S.activeWorkspaceID, escapeJSONStrings(S.activeWorkspaceName), S.specialWorkspaceID, escapeJSONStrings(S.specialWorkspaceName),
+            S.reserved[0], S.reserved[1], S.reserved[2], S.reserved[3], S.scale, S.transform, (S.focused ? "true" : "false"), (S.dpms ? "true" : "false"),
+            (S.vrr ? "true" : "false"), (uint64_t)S.solitary, (S.activelyTearing ? "true" : "false"), (uint64_t)S.directScanoutTo, (S.disabled ? "true" : "false"),
+            formatToString(S.drmFormat), MIRROROF, availableModesForOutput(m, format));
 
     } else {
-        result += std::format("Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
-                              "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
-                              "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tactivelyTearing: {}\n\tdirectScanoutTo: {:x}\n\tdisabled: {}\n\tcurrentFormat: {}\n\tmirrorOf: "
-                              "{}\n\tavailableModes: {}\n\n",
-                              m->szName, m->ID, (int)m->vecPixelSize.x, (int)m->vecPixelSize.y, m->refreshRate, (int)m->vecPosition.x, (int)m->vecPosition.y, m->szShortDescription,
-                              m->output->make, m->output->model, m->output->serial, m->activeWorkspaceID(), (!m->activeWorkspace ? "" : m->activeWorkspace->m_name),
-                              m->activeSpecialWorkspaceID(), (m->activeSpecialWorkspace ? m->activeSpecialWorkspace->m_name : ""), (int)m->vecReservedTopLeft.x,
-                              (int)m->vecReservedTopLeft.y, (int)m->vecReservedBottomRight.x, (int)m->vecReservedBottomRight.y, m->scale, (int)m->transform,
-                              (m == g_pCompositor->m_lastMonitor ? "yes" : "no"), (int)m->dpmsStatus, m->output->state->state().adaptiveSync, (uint64_t)m->solitaryClient.get(),
-                              m->tearingState.activelyTearing, (uint64_t)m->lastScanout.get(), !m->m_bEnabled, formatToString(m->output->state->state().drmFormat),
-                              m->pMirrorOf ? std::format("{}", m->pMirrorOf->ID) : "none", availableModesForOutput(m, format));
+        fragment = std::format("Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
+                               "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
+                               "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tactivelyTearing: {}\n\tdirectScanoutTo: {:x}\n\tdisabled: {}\n\tcurrentFormat: {}\n\tmirrorOf: "
+                               "{}\n\tavailableModes: {}\n\n",
+                               S.name, S.id, S.width, S.height, S.refreshRate, S.x, S.y, S.description, S.make, S.model, S.serial, S.activeWorkspaceID, S.activeWorkspaceName,
+                               S.specialWorkspaceID, S.specialWorkspaceName, S.reserved[0], S.reserved[1], S.reserved[2], S.reserved[3], S.scale, S.transform,
+                               (S.focused ? "yes" : "no"), (int)S.dpms, S.vrr, (uint64_t)S.solitary, S.activelyTearing, (uint64_t)S.directScanoutTo, S.disabled,
+                               formatToString(S.drmFormat), MIRROROF, availableModesForOutput(m, format));
     }
 
-    return result;
+    return *fragment;
 }
 
 static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string request) {
-    CVarList vars(request, 0, ' ');
-    auto     allMonitors = false;
+    CVarList                vars(request, 0, ' ');
+    auto                    allMonitors = false;
+    std::optional<uint64_t> since;
+
+    if (vars.size() >= 2 && vars[1] == "all")
+        allMonitors = true;
 
-    if (vars.size() > 2)
+    // any other single argument has always been ignored
+    if (!parseSnapshotSince(vars, allMonitors || vars.size() == 2 ? 2 : 1, since))
         return "too many args";
 
-    if (vars.size() == 2 && vars[1] == "all")
-        allMonitors = true;
+    if (since) {
+        std::vector<CHyprCtl::SSnapshotEntry> entries;
+        for (auto const& m : allMonitors ? g_pCompositor->m_realMonitors : g_pCompositor->m_monitors) {
+            auto data = CHyprCtl::getMonitorData(m, format);
+            if (data.empty())
+                continue;
+
+            entries.emplace_back(CHyprCtl::SSnapshotEntry{std::to_string(m->ID), m->hyprctlSnapshot.generation, std::move(data)});
+        }
+
+        return g_pHyprCtl->getSnapshotDelta(allMonitors ? "monitors all" : "monitors", entries, *since, format);
+    }
 
     std::string result = "";
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
@@ -187,9 +274,7 @@ static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string requ
     return result;
 }
 
-static std::string getTagsData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    const auto tags = w->m_tags.getTags();
-
+static std::string getTagsData(const std::set<std::string>& tags, eHyprCtlOutputFormat format) {
     if (format == eHyprCtlOutputFormat::FORMAT_JSON)
         return std::accumulate(tags.begin(), tags.end(), std::string(),
                                [](const std::string& a, const std::string& b) { return a.empty() ? std::format("\"{}\"", b) : std::format("{}, \"{}\"", a, b); });
@@ -197,32 +282,64 @@ static std::string getTagsData(PHLWINDOW w, eHyprCtlOutputFormat format) {
         return std::accumulate(tags.begin(), tags.end(), std::string(), [](const std::string& a, const std::string& b) { return a.empty() ? b : a + ", " + b; });
 }
 
-static std::string getGroupedData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    const bool isJson = format == eHyprCtlOutputFormat::FORMAT_JSON;
+static std::vector<uintptr_t> getGroupMembers(PHLWINDOW w) {
+    std::vector<uintptr_t> result;
+
     if (w->m_groupData.pNextWindow.expired())
+        return result;
+
+    PHLWINDOW head = w->getGroupHead();
+    PHLWINDOW curr = head;
+    while (true) {
+        result.emplace_back((uintptr_t)curr.get());
+        curr = curr->m_groupData.pNextWindow.lock();
+        // We've wrapped around to the start
+        if (curr == head)
+            break;
+    }
+
+    return result;
+}
+
+static std::string getGroupedData(const std::vector<uintptr_t>& members, eHyprCtlOutputFormat format) {
+    const bool isJson = format == eHyprCtlOutputFormat::FORMAT_JSON;
+    if (members.empty())
         return isJson ? "" : "0";
 
     std::ostringstream result;
 
-    PHLWINDOW          head = w->getGroupHead();
-    PHLWINDOW          curr = head;
-    while (true) {
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (i != 0)
+            result << (isJson ? ", " : ",");
+
         if (isJson)
-            result << std::format("\"0x{:x}\"", (uintptr_t)curr.get());
+            result << std::format("\"0x{:x}\"", members[i]);
         else
-            result << std::format("{:x}", (uintptr_t)curr.get());
-        curr = curr->m_groupData.pNextWindow.lock();
-        // We've wrapped around to the start, break out without trailing comma
-        if (curr == head)
-            break;
-        result << (isJson ? ", " : ",");
+            result << std::format("{:x}", members[i]);
     }
 
     return result.str();
 }
 
-std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
+std::unordered_map<CWindow*, int> CHyprCtl::focusHistoryIDs() {
+    std::unordered_map<CWindow*, int> ids;
+    ids.reserve(g_pCompositor->m_windowFocusHistory.size());
+
+    for (size_t i = 0; i < g_pCompositor->m_windowFocusHistory.size(); ++i) {
+        if (const auto PWINDOW = g_pCompositor->m_windowFocusHistory[i].lock())
+            ids.emplace(PWINDOW.get(), i); // first one wins, like the scan
+    }
+
+    return ids;
+}
+
+static SHyprCtlWindowState getWindowState(PHLWINDOW w, const std::unordered_map<CWindow*, int>* focusHistoryIDs) {
+    auto getFocusHistoryID = [focusHistoryIDs](PHLWINDOW wnd) -> int {
+        if (focusHistoryIDs) {
+            const auto IT = focusHistoryIDs->find(wnd.get());
+            return IT == focusHistoryIDs->end() ? -1 : IT->second;
+        }
+
         for (size_t i = 0; i < g_pCompositor->m_windowFocusHistory.size(); ++i) {
             if (g_pCompositor->m_windowFocusHistory[i].lock() == wnd)
                 return i;
@@ -230,8 +347,63 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
         return -1;
     };
 
+    return SHyprCtlWindowState{
+        .address          = (uintptr_t)w.get(),
+        .mapped           = w->m_isMapped,
+        .hidden           = w->isHidden(),
+        .x                = (int)w->m_realPosition->goal().x,
+        .y                = (int)w->m_realPosition->goal().y,
+        .w                = (int)w->m_realSize->goal().x,
+        .h                = (int)w->m_realSize->goal().y,
+        .workspaceID      = w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
+        .workspaceName    = !w->m_workspace ? "" : w->m_workspace->m_name,
+        .floating         = w->m_isFloating,
+        .pseudo           = w->m_isPseudotiled,
+        .monitorID        = (int64_t)w->monitorID(),
+        .windowClass      = w->m_class,
+        .title            = w->m_title,
+        .initialClass     = w->m_initialClass,
+        .initialTitle     = w->m_initialTitle,
+        .pid              = w->getPID(),
+        .xwayland         = w->m_isX11,
+        .pinned           = w->m_pinned,
+        .fullscreen       = (uint8_t)w->m_fullscreenState.internal,
+        .fullscreenClient = (uint8_t)w->m_fullscreenState.client,
+        .grouped          = getGroupMembers(w),
+        .tags             = w->m_tags.getTags(),
+        .swallowing       = (uintptr_t)w->m_swallowed.get(),
+        .focusHistoryID   = getFocusHistoryID(w),
+        .inhibitingIdle   = g_pInputManager->isWindowInhibiting(w, false),
+        .xdgTag           = w->xdgTag().value_or(""),
+        .xdgDescription   = w->xdgDescription().value_or(""),
+    };
+}
+
+// plain members assigned all over the layouts and dispatchers, or derived from other objects. Reading them is
+// cheap, so they're compared instead of marking the snapshot at every assignment
+static bool windowScalarsChanged(PHLWINDOW w, const SHyprCtlWindowState& S) {
+    const auto POS  = w->m_realPosition->goal();
+    const auto SIZE = w->m_realSize->goal();
+
+    return S.mapped != w->m_isMapped || S.hidden != w->isHidden() || S.x != (int)POS.x || S.y != (int)POS.y || S.w != (int)SIZE.x || S.h != (int)SIZE.y ||
+        S.workspaceID != (w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID) || S.floating != w->m_isFloating || S.pseudo != w->m_isPseudotiled ||
+        S.monitorID != (int64_t)w->monitorID() || S.pinned != w->m_pinned || S.fullscreen != (uint8_t)w->m_fullscreenState.internal ||
+        S.fullscreenClient != (uint8_t)w->m_fullscreenState.client || S.swallowing != (uintptr_t)w->m_swallowed.get() ||
+        S.inhibitingIdle != g_pInputManager->isWindowInhibiting(w, false) || (w->m_groupData.pNextWindow ? getGroupMembers(w) != S.grouped : !S.grouped.empty());
+}
+
+std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format, const std::unordered_map<CWindow*, int>* focusHistoryIDs) {
+    if (w->m_hyprctlSnapshot.dirty || windowScalarsChanged(w, w->m_hyprctlSnapshot.state))
+        refreshSnapshot(w->m_hyprctlSnapshot, getWindowState(w, focusHistoryIDs));
+
+    auto& fragment = snapshotFragment(w->m_hyprctlSnapshot, format);
+    if (fragment)
+        return *fragment;
+
+    const auto& S = w->m_hyprctlSnapshot.state;
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(
+        fragment = std::format(
             R"#({{
     "address": "0x{:x}",
     "mapped": {},
@@ -262,29 +434,47 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     "xdgTag": "{}",
     "xdgDescription": "{}"
 }},)#",
-            (uintptr_t)w.get(), (w->m_isMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), (int)w->m_realPosition->goal().x, (int)w->m_realPosition->goal().y,
-            (int)w->m_realSize->goal().x, (int)w->m_realSize->goal().y, w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
-            escapeJSONStrings(!w->m_workspace ? "" : w->m_workspace->m_name), ((int)w->m_isFloating == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"),
-            (int64_t)w->monitorID(), escapeJSONStrings(w->m_class), escapeJSONStrings(w->m_title), escapeJSONStrings(w->m_initialClass), escapeJSONStrings(w->m_initialTitle),
-            w->getPID(), ((int)w->m_isX11 == 1 ? "true" : "false"), (w->m_pinned ? "true" : "false"), (uint8_t)w->m_fullscreenState.internal, (uint8_t)w->m_fullscreenState.client,
-            getGroupedData(w, format), getTagsData(w, format), (uintptr_t)w->m_swallowed.get(), getFocusHistoryID(w),
-            (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"), escapeJSONStrings(w->xdgTag().value_or("")), escapeJSONStrings(w->xdgDescription().value_or("")));
+            S.address, (S.mapped ? "true" : "false"), (S.hidden ? "true" : "false"), S.x, S.y, S.w, S.h, S.workspaceID, escapeJSONStrings(S.workspaceName),
+            (S.floating ? "true" : "false"), (S.pseudo ? "true" : "false"), S.monitorID, escapeJSONStrings(S.windowClass), escapeJSONStrings(S.title),
+            escapeJSONStrings(S.initialClass), escapeJSONStrings(S.initialTitle), S.pid, (S.xwayland ? "true" : "false"), (S.pinned ? "true" : "false"), S.fullscreen,
+            S.fullscreenClient, getGroupedData(S.grouped, format), getTagsData(S.tags, format), S.swallowing, S.focusHistoryID, (S.inhibitingIdle ? "true" : "false"),
+            escapeJSONStrings(S.xdgTag), escapeJSONStrings(S.xdgDescription));
     } else {
-        return std::format(
+        fragment = std::format(
             "Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: {}\n\ttitle: "
             "{}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
             "{}\n\txwayland: {}\n\tpinned: "
             "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: {}\n\ttags: {}\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\tinhibitingIdle: {}\n\txdgTag: "
             "{}\n\txdgDescription: {}\n\n",
-            (uintptr_t)w.get(), w->m_title, (int)w->m_isMapped, (int)w->isHidden(), (int)w->m_realPosition->goal().x, (int)w->m_realPosition->goal().y,
-            (int)w->m_realSize->goal().x, (int)w->m_realSize->goal().y, w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID, (!w->m_workspace ? "" : w->m_workspace->m_name),
-            (int)w->m_isFloating, (int)w->m_isPseudotiled, (int64_t)w->monitorID(), w->m_class, w->m_title, w->m_initialClass, w->m_initialTitle, w->getPID(), (int)w->m_isX11,
-            (int)w->m_pinned, (uint8_t)w->m_fullscreenState.internal, (uint8_t)w->m_fullscreenState.client, getGroupedData(w, format), getTagsData(w, format),
-            (uintptr_t)w->m_swallowed.get(), getFocusHistoryID(w), (int)g_pInputManager->isWindowInhibiting(w, false), w->xdgTag().value_or(""), w->xdgDescription().value_or(""));
+            S.address, S.title, (int)S.mapped, (int)S.hidden, S.x, S.y, S.w, S.h, S.workspaceID, S.workspaceName, (int)S.floating, (int)S.pseudo, S.monitorID, S.windowClass,
+            S.title, S.initialClass, S.initialTitle, S.pid, (int)S.xwayland, (int)S.pinned, S.fullscreen, S.fullscreenClient, getGroupedData(S.grouped, format),
+            getTagsData(S.tags, format), S.swallowing, S.focusHistoryID, (int)S.inhibitingIdle, S.xdgTag, S.xdgDescription);
     }
+
+    return *fragment;
 }
 
 static std::string clientsRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList                vars(request, 0, ' ');
+    std::optional<uint64_t> since;
+
+    if (!parseSnapshotSince(vars, 1, since))
+        return "invalid args";
+
+    // every window's state has its focus history id, don't scan the history for each
+    const auto FOCUSHISTORYIDS = CHyprCtl::focusHistoryIDs();
+
+    if (since) {
+        // delta requests always consider unmapped windows too, a window getting unmapped is a change of its "mapped" field
+        std::vector<CHyprCtl::SSnapshotEntry> entries;
+        for (auto const& w : g_pCompositor->m_windows) {
+            auto data = CHyprCtl::getWindowData(w, format, &FOCUSHISTORYIDS);
+            entries.emplace_back(CHyprCtl::SSnapshotEntry{std::format("0x{:x}", (uintptr_t)w.get()), w->m_hyprctlSnapshot.generation, std::move(data)});
+        }
+
+        return g_pHyprCtl->getSnapshotDelta("clients", entries, *since, format);
+    }
+
     std::string result = "";
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
@@ -293,7 +483,7 @@ static std::string clientsRequest(eHyprCtlOutputFormat format, std::string reque
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            result += CHyprCtl::getWindowData(w, format, &FOCUSHISTORYIDS);
         }
 
         trimTrailingComma(result);
@@ -304,17 +494,70 @@ static std::string clientsRequest(eHyprCtlOutputFormat format, std::string reque
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            result += CHyprCtl::getWindowData(w, format, &FOCUSHISTORYIDS);
         }
     }
     return result;
 }
 
-std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format) {
+std::unordered_map<WORKSPACEID, int> CHyprCtl::workspaceWindowCounts() {
+    std::unordered_map<WORKSPACEID, int> counts;
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        if (w->m_isMapped)
+            ++counts[w->workspaceID()];
+    }
+
+    return counts;
+}
+
+static int workspaceWindowCount(PHLWORKSPACE w, const std::unordered_map<WORKSPACEID, int>* windowCounts) {
+    if (!windowCounts)
+        return w->getWindows();
+
+    const auto IT = windowCounts->find(w->m_id);
+    return IT == windowCounts->end() ? 0 : IT->second;
+}
+
+static SHyprCtlWorkspaceState getWorkspaceState(PHLWORKSPACE w, int windows) {
     const auto PLASTW   = w->getLastFocusedWindow();
     const auto PMONITOR = w->m_monitor.lock();
+
+    return SHyprCtlWorkspaceState{
+        .id              = w->m_id,
+        .name            = w->m_name,
+        .monitor         = PMONITOR ? PMONITOR->szName : "?",
+        .monitorID       = PMONITOR ? std::to_string(PMONITOR->ID) : "null",
+        .windows         = windows,
+        .hasFullscreen   = w->m_hasFullscreenWindow,
+        .lastWindow      = (uintptr_t)PLASTW.get(),
+        .lastWindowTitle = PLASTW ? PLASTW->m_title : "",
+        .persistent      = w->m_persistent,
+    };
+}
+
+// the name and the last window's title mark the snapshot dirty, the rest is compared
+static bool workspaceScalarsChanged(PHLWORKSPACE w, const SHyprCtlWorkspaceState& S, int windows) {
+    const auto PMONITOR = w->m_monitor.lock();
+
+    return S.windows != windows || S.hasFullscreen != w->m_hasFullscreenWindow || S.persistent != w->m_persistent ||
+        S.lastWindow != (uintptr_t)w->getLastFocusedWindow().get() || (PMONITOR ? S.monitor != PMONITOR->szName : S.monitor != "?");
+}
+
+std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format, const std::unordered_map<WORKSPACEID, int>* windowCounts) {
+    const auto WINDOWS = workspaceWindowCount(w, windowCounts);
+
+    if (w->m_hyprctlSnapshot.dirty || workspaceScalarsChanged(w, w->m_hyprctlSnapshot.state, WINDOWS))
+        refreshSnapshot(w->m_hyprctlSnapshot, getWorkspaceState(w, WINDOWS));
+
+    auto& fragment = snapshotFragment(w->m_hyprctlSnapshot, format);
+    if (fragment)
+        return *fragment;
+
+    const auto& S = w->m_hyprctlSnapshot.state;
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(R"#({{
+        fragment = std::format(R"#({{
     "id": {},
     "name": "{}",
     "monitor": "{}",
@@ -325,15 +568,15 @@ std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat form
     "lastwindowtitle": "{}",
     "ispersistent": {}
 }})#",
-                           w->m_id, escapeJSONStrings(w->m_name), escapeJSONStrings(PMONITOR ? PMONITOR->szName : "?"),
-                           escapeJSONStrings(PMONITOR ? std::to_string(PMONITOR->ID) : "null"), w->getWindows(), w->m_hasFullscreenWindow ? "true" : "false",
-                           (uintptr_t)PLASTW.get(), PLASTW ? escapeJSONStrings(PLASTW->m_title) : "", w->m_persistent ? "true" : "false");
+                               S.id, escapeJSONStrings(S.name), escapeJSONStrings(S.monitor), escapeJSONStrings(S.monitorID), S.windows, S.hasFullscreen ? "true" : "false",
+                               S.lastWindow, escapeJSONStrings(S.lastWindowTitle), S.persistent ? "true" : "false");
     } else {
-        return std::format(
-            "workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\tispersistent: {}\n\n",
-            w->m_id, w->m_name, PMONITOR ? PMONITOR->szName : "?", PMONITOR ? std::to_string(PMONITOR->ID) : "null", w->getWindows(), (int)w->m_hasFullscreenWindow,
-            (uintptr_t)PLASTW.get(), PLASTW ? PLASTW->m_title : "", (int)w->m_persistent);
+        fragment = std::format(
+            "workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\tispersistent: {}\n\n", S.id,
+            S.name, S.monitor, S.monitorID, S.windows, (int)S.hasFullscreen, S.lastWindow, S.lastWindowTitle, (int)S.persistent);
     }
+
+    return *fragment;
 }
 
 static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputFormat format) {
@@ -400,12 +643,31 @@ static std::string activeWorkspaceRequest(eHyprCtlOutputFormat format, std::stri
 }
 
 static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList                vars(request, 0, ' ');
+    std::optional<uint64_t> since;
+
+    if (!parseSnapshotSince(vars, 1, since))
+        return "invalid args";
+
+    // count every workspace's windows in one walk
+    const auto WINDOWCOUNTS = CHyprCtl::workspaceWindowCounts();
+
+    if (since) {
+        std::vector<CHyprCtl::SSnapshotEntry> entries;
+        for (auto const& w : g_pCompositor->m_workspaces) {
+            auto data = CHyprCtl::getWorkspaceData(w, format, &WINDOWCOUNTS);
+            entries.emplace_back(CHyprCtl::SSnapshotEntry{std::to_string(w->m_id), w->m_hyprctlSnapshot.generation, std::move(data)});
+        }
+
+        return g_pHyprCtl->getSnapshotDelta("workspaces", entries, *since, format);
+    }
+
     std::string result = "";
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
         for (auto const& w : g_pCompositor->m_workspaces) {
-            result += CHyprCtl::getWorkspaceData(w, format);
+            result += CHyprCtl::getWorkspaceData(w, format, &WINDOWCOUNTS);
             result += ",";
         }
 
@@ -413,7 +675,7 @@ static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string re
         result += "]";
     } else {
         for (auto const& w : g_pCompositor->m_workspaces) {
-            result += CHyprCtl::getWorkspaceData(w, format);
+            result += CHyprCtl::getWorkspaceData(w, format, &WINDOWCOUNTS);
         }
     }
 
@@ -552,6 +814,90 @@ static std::string layoutsRequest(eHyprCtlOutputFormat format, std::string reque
     return result;
 }
 
+static std::string timersRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto& STATS = g_pEventLoopManager->getTimerStats();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(R"#({{
+    "timers": {},
+    "armed": {},
+    "wakeups": {},
+    "dispatched": {},
+    "coalesced": {},
+    "wakeupsPerSecond": {:.2f},
+    "avgLatencyUs": {:.2f},
+    "maxLatencyUs": {:.2f}
+}})#",
+                           STATS.timers, STATS.armed, STATS.wakeups, STATS.dispatched, STATS.coalesced, STATS.wakeupsPerSecond, STATS.avgLatencyUs, STATS.maxLatencyUs);
+    }
+
+    return std::format("timers: {} ({} armed)\nwakeups: {} ({:.2f}/s)\ndispatched: {} ({} coalesced)\ndispatch latency: avg {:.2f}us, max {:.2f}us\n", STATS.timers, STATS.armed,
+                       STATS.wakeups, STATS.wakeupsPerSecond, STATS.dispatched, STATS.coalesced, STATS.avgLatencyUs, STATS.maxLatencyUs);
+}
+
+static std::string damageRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto& STATS = NRegionSimplify::stats();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(R"#({{
+    "simplified": {},
+    "rectsIn": {},
+    "rectsOut": {},
+    "pixelsAdded": {},
+    "pixelsSaved": {}
+}})#",
+                           STATS.calls, STATS.rectsIn, STATS.rectsOut, STATS.pixelsAdded, STATS.pixelsSaved);
+    }
+
+    return std::format("regions simplified: {}\nrects: {} -> {}\npixels added by merging: {}\npixels saved over full extents: {}\n", STATS.calls, STATS.rectsIn, STATS.rectsOut,
+                       STATS.pixelsAdded, STATS.pixelsSaved);
+}
+
+static std::string geometryRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto STATS   = CWindow::geometryCacheStats();
+    const auto HITRATE = STATS.reads ? 100.0 * (STATS.reads - std::min(STATS.recomputes, STATS.reads)) / STATS.reads : 0.0;
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(R"#({{
+    "reads": {},
+    "recomputes": {},
+    "invalidations": {},
+    "hitRate": {:.2f}
+}})#",
+                           STATS.reads, STATS.recomputes, STATS.invalidations, HITRATE);
+    }
+
+    return std::format("reads: {}\nrecomputes: {}\ninvalidations: {}\nhit rate: {:.2f}%\n", STATS.reads, STATS.recomputes, STATS.invalidations, HITRATE);
+}
+
+static std::string layoutStatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto LAYOUT = g_pLayoutManager->getCurrentLayout();
+    const auto STATS  = LAYOUT->getStats();
+
+    const auto avg = [](const SLayoutStats::SOperation& op) { return op.calls ? op.totalMs / op.calls : 0.F; };
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        const auto op = [&avg](const SLayoutStats::SOperation& o) { return std::format(R"#({{"calls": {}, "avgMs": {:.3f}, "maxMs": {:.3f}}})#", o.calls, avg(o), o.maxMs); };
+
+        return std::format(R"#({{
+    "layout": "{}",
+    "nodes": {},
+    "workspaces": {},
+    "created": {},
+    "removed": {},
+    "recalculated": {}
+}})#",
+                           escapeJSONStrings(LAYOUT->getLayoutName()), STATS.nodes, STATS.workspaces, op(STATS.created), op(STATS.removed), op(STATS.recalculated));
+    }
+
+    const auto op = [&avg](const char* name, const SLayoutStats::SOperation& o) {
+        return std::format("{}: {} calls, avg {:.3f}ms, max {:.3f}ms\n", name, o.calls, avg(o), o.maxMs);
+    };
+
+    return std::format("layout: {}\nnodes: {} on {} workspaces\n", LAYOUT->getLayoutName(), STATS.nodes, STATS.workspaces) + op("created", STATS.created) +
+        op("removed", STATS.removed) + op("recalculated", STATS.recalculated);
+}
+
 static std::string configErrorsRequest(eHyprCtlOutputFormat format, std::string request) {
     std::string result     = "";
     std::string currErrors = g_pConfigManager->getErrors();
@@ -1062,67 +1408,142 @@ static std::string dispatchRequest(eHyprCtlOutputFormat format, std::string in)
     return res.success ? "ok" : res.error;
 }
 
-static std::string dispatchKeyword(eHyprCtlOutputFormat format, std::string in) {
-    // Find the first space to strip the keyword keyword
-    auto const firstSpacePos = in.find_first_of(' ');
-    if (firstSpacePos == std::string::npos) // Handle the case where there's no space found (invalid input)
-        return "Invalid input: no space found";
+enum eKeywordRefresh : uint8_t {
+    KEYWORD_REFRESH_INPUT         = (1 << 0),
+    KEYWORD_REFRESH_LAYOUT        = (1 << 1), // switch to the configured layout
+    KEYWORD_REFRESH_SCREEN_SHADER = (1 << 2),
+    KEYWORD_REFRESH_BLUR          = (1 << 3),
+    KEYWORD_REFRESH_WATCHER       = (1 << 4),
+    KEYWORD_REFRESH_MONITORS      = (1 << 5), // damage and recalculate the layout
+    KEYWORD_REFRESH_DECORATIONS   = (1 << 6), // animated decoration values
+    KEYWORD_REFRESH_RULES         = (1 << 7), // dynamic rules of visible windows
+};
+
+static uint8_t keywordRefreshFor(const std::string& COMMAND) {
+    // Update window border colors
+    uint8_t refresh = KEYWORD_REFRESH_DECORATIONS;
+
+    // a dynamic source can set anything
+    if (COMMAND.contains("input") || COMMAND.contains("device") || COMMAND == "source")
+        refresh |= KEYWORD_REFRESH_INPUT;
 
-    // Strip the keyword
-    in = in.substr(firstSpacePos + 1);
+    if (COMMAND.contains("general:layout"))
+        refresh |= KEYWORD_REFRESH_LAYOUT;
 
-    // Find the next space for the COMMAND and VALUE
-    auto const secondSpacePos = in.find_first_of(' ');
-    if (secondSpacePos == std::string::npos) // Handle the case where there's no second space (invalid input)
-        return "Invalid input: command and value not properly formatted";
+    if (COMMAND.contains("decoration:screen_shader") || COMMAND == "source")
+        refresh |= KEYWORD_REFRESH_SCREEN_SHADER;
 
-    // Extract COMMAND and VALUE
-    const auto COMMAND = in.substr(0, secondSpacePos);
-    const auto VALUE   = in.substr(secondSpacePos + 1);
+    if (COMMAND.contains("blur") || COMMAND == "source")
+        refresh |= KEYWORD_REFRESH_BLUR;
 
-    // If COMMAND is empty, handle accordingly
-    if (COMMAND.empty())
-        return "Invalid input: command is empty";
+    if (COMMAND.contains("misc:disable_autoreload"))
+        refresh |= KEYWORD_REFRESH_WATCHER;
 
-    std::string retval = g_pConfigManager->parseKeyword(COMMAND, VALUE);
+    // decorations will probably need a repaint, layouts need a recalc if they changed
+    if (COMMAND.contains("decoration:") || COMMAND.contains("border") || COMMAND == "workspace" || COMMAND.contains("zoom_factor") || COMMAND == "source" ||
+        COMMAND.starts_with("windowrule") || COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:"))
+        refresh |= KEYWORD_REFRESH_MONITORS;
 
-    // if we are executing a dynamic source we have to reload everything, so every if will have a check for source.
-    if (COMMAND == "monitor" || COMMAND == "source")
-        g_pConfigManager->m_wantsMonitorReload = true; // for monitor keywords
+    return refresh;
+}
+
+// returns what was refreshed
+static std::string runKeywordRefresh(uint8_t refresh) {
+    std::string done;
+    const auto  ran = [&done](const char* name) { done += std::format("{}{}", done.empty() ? "" : ", ", name); };
 
-    if (COMMAND.contains("input") || COMMAND.contains("device") || COMMAND == "source") {
+    if (refresh & KEYWORD_REFRESH_INPUT) {
         g_pInputManager->setKeyboardLayout();     // update kb layout
         g_pInputManager->setPointerConfigs();     // update mouse cfgs
         g_pInputManager->setTouchDeviceConfigs(); // update touch device cfgs
         g_pInputManager->setTabletConfigs();      // update tablets
+        ran("input");
     }
 
-    static auto PLAYOUT = CConfigValue<std::string>("general:layout");
+    if (refresh & KEYWORD_REFRESH_LAYOUT) {
+        static auto PLAYOUT = CConfigValue<std::string>("general:layout");
 
-    if (COMMAND.contains("general:layout"))
         g_pLayoutManager->switchToLayout(*PLAYOUT); // update layout
+        ran("layout");
+    }
 
-    if (COMMAND.contains("decoration:screen_shader") || COMMAND == "source")
+    if (refresh & KEYWORD_REFRESH_SCREEN_SHADER) {
         g_pHyprOpenGL->m_bReloadScreenShader = true;
+        ran("screen shader");
+    }
 
-    if (COMMAND.contains("blur") || COMMAND == "source") {
+    if (refresh & KEYWORD_REFRESH_BLUR) {
         for (auto& [m, rd] : g_pHyprOpenGL->m_mMonitorRenderResources) {
             rd.blurFBDirty = true;
         }
+        ran("blur");
     }
 
-    if (COMMAND.contains("misc:disable_autoreload"))
+    if (refresh & KEYWORD_REFRESH_WATCHER) {
         g_pConfigManager->updateWatcher();
+        ran("watcher");
+    }
 
-    // decorations will probably need a repaint
-    if (COMMAND.contains("decoration:") || COMMAND.contains("border") || COMMAND == "workspace" || COMMAND.contains("zoom_factor") || COMMAND == "source" ||
-        COMMAND.starts_with("windowrule")) {
+    if (refresh & KEYWORD_REFRESH_RULES) {
+        for (auto const& w : g_pCompositor->m_windows) {
+            if (!w->m_isMapped || !w->m_workspace || !w->m_workspace->isVisible())
+                continue;
+
+            w->updateDynamicRules();
+        }
+        ran("rules");
+    }
+
+    if (refresh & KEYWORD_REFRESH_DECORATIONS) {
+        g_pCompositor->updateAllWindowsAnimatedDecorationValues();
+        ran("decorations");
+    }
+
+    if (refresh & KEYWORD_REFRESH_MONITORS) {
         for (auto const& m : g_pCompositor->m_monitors) {
             g_pHyprRenderer->damageMonitor(m);
             g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
         }
+        ran("monitors");
     }
 
+    return done;
+}
+
+static std::string dispatchKeyword(eHyprCtlOutputFormat format, std::string in) {
+    // Find the first space to strip the keyword keyword
+    auto const firstSpacePos = in.find_first_of(' ');
+    if (firstSpacePos == std::string::npos) // Handle the case where there's no space found (invalid input)
+        return "Invalid input: no space found";
+
+    // Strip the keyword
+    in = in.substr(firstSpacePos + 1);
+
+    // Find the next space for the COMMAND and VALUE
+    auto const secondSpacePos = in.find_first_of(' ');
+    if (secondSpacePos == std::string::npos) // Handle the case where there's no second space (invalid input)
+        return "Invalid input: command and value not properly formatted";
+
+    // Extract COMMAND and VALUE
+    const auto COMMAND = in.substr(0, secondSpacePos);
+    const auto VALUE   = in.substr(secondSpacePos + 1);
+
+    // If COMMAND is empty, handle accordingly
+    if (COMMAND.empty())
+        return "Invalid input: command is empty";
+
+    std::string retval = g_pConfigManager->parseKeyword(COMMAND, VALUE);
+
+    // if we are executing a dynamic source we have to reload everything, so every if will have a check for source.
+    if (COMMAND == "monitor" || COMMAND == "source")
+        g_pConfigManager->m_wantsMonitorReload = true; // for monitor keywords
+
+    // in a batch, the refreshes run once after the last command
+    if (g_pHyprCtl->m_keywordBatch.active)
+        g_pHyprCtl->m_keywordBatch.pending |= keywordRefreshFor(COMMAND);
+    else
+        runKeywordRefresh(keywordRefreshFor(COMMAND));
+
     Debug::log(LOG, "Hyprctl: keyword {} : {}", COMMAND, VALUE);
 
     if (retval == "")
@@ -1138,6 +1559,9 @@ static std::string reloadRequest(eHyprCtlOutputFormat format, std::string reques
     if (REQMODE == "config-only")
         g_pConfigManager->m_noMonitorReload = true;
 
+    // asked for explicitly, things outside the config (shaders, keymaps) may have changed
+    g_pConfigManager->m_fullReload = true;
+
     g_pConfigManager->reload();
 
     return "ok";
@@ -1171,6 +1595,52 @@ static std::string cursorPosRequest(eHyprCtlOutputFormat format, std::string req
     return "error";
 }
 
+// whether a request, flags stripped, is a keyword
+static bool isKeywordRequest(const std::string& request) {
+    const auto FIRSTWORD = request.substr(0, request.find(' '));
+    const auto SEP       = FIRSTWORD.find('/');
+
+    return (SEP == std::string::npos ? FIRSTWORD : FIRSTWORD.substr(SEP + 1)) == "keyword";
+}
+
+// whether a request asks for json, e.g. j/activewindow
+static bool isJSONRequest(const std::string& request) {
+    const auto FIRSTWORD = request.substr(0, request.find(' '));
+    const auto SEP       = FIRSTWORD.find('/');
+
+    return SEP != std::string::npos && FIRSTWORD.substr(0, SEP).contains('j');
+}
+
+// returns what was refreshed
+static std::string flushKeywordBatch() {
+    const auto PENDING = std::exchange(g_pHyprCtl->m_keywordBatch.pending, 0);
+    if (!PENDING)
+        return "";
+
+    const auto DONE = runKeywordRefresh(PENDING);
+    Debug::log(LOG, "Hyprctl: batch refreshed {}", DONE);
+    return DONE;
+}
+
+// the report goes into the last command's reply, so there is still one reply per command
+static void appendRefreshReport(std::string& reply, const std::string& lastCommand, const std::string& refreshed) {
+    if (refreshed.empty())
+        return;
+
+    if (!isJSONRequest(lastCommand)) {
+        reply += std::format("\nrefreshed: {}", refreshed);
+        return;
+    }
+
+    // json objects get a field, anything else would stop parsing
+    const auto LASTBRACE = reply.find_last_not_of(" \t\n");
+    if (LASTBRACE == std::string::npos || LASTBRACE == 0 || reply[LASTBRACE] != '}')
+        return;
+
+    const auto OPENBRACE = reply.find_last_not_of(" \t\n", LASTBRACE - 1);
+    reply.insert(LASTBRACE, std::format("{}\"refreshed\": \"{}\"\n", OPENBRACE != std::string::npos && reply[OPENBRACE] != '{' ? ",\n" : "", escapeJSONStrings(refreshed)));
+}
+
 static std::string dispatchBatch(eHyprCtlOutputFormat format, std::string request) {
     // split by ; ignores ; inside [] and adds ; on last command
 
@@ -1180,6 +1650,23 @@ static std::string dispatchBatch(eHyprCtlOutputFormat format, std::string reques
     int               bracket   = 0;
     size_t            idx       = 0;
 
+    // consecutive keywords are applied as one transaction, their refreshes are coalesced and run
+    // before the next other command or at the end
+    const bool OUTERMOST              = !g_pHyprCtl->m_keywordBatch.active;
+    g_pHyprCtl->m_keywordBatch.active = true;
+
+    // getReply can throw, later standalone keywords must not keep deferring their refreshes
+    CScopeGuard x([OUTERMOST] {
+        if (!OUTERMOST)
+            return;
+
+        flushKeywordBatch();
+        g_pHyprCtl->m_keywordBatch.active = false;
+    });
+
+    std::string refreshed, lastCommand, lastReply;
+    size_t      replies = 0;
+
     for (size_t i = 0; i <= request.size(); ++i) {
         char ch = (i < request.size()) ? request[i] : ';';
         if (ch == '[')
@@ -1187,14 +1674,34 @@ static std::string dispatchBatch(eHyprCtlOutputFormat format, std::string reques
         else if (ch == ']')
             --bracket;
         else if (ch == ';' && bracket == 0) {
-            if (idx < i)
-                reply += g_pHyprCtl->getReply(trim(request.substr(idx, i - idx))).append(DELIMITER);
+            if (idx < i) {
+                const auto COMMAND = trim(request.substr(idx, i - idx));
+
+                // anything but a keyword acts on the current state, bring it up to date first
+                if (!isKeywordRequest(COMMAND)) {
+                    if (const auto DONE = flushKeywordBatch(); !DONE.empty())
+                        refreshed += std::format("{}{}", refreshed.empty() ? "" : ", ", DONE);
+                }
+
+                if (replies++ > 0)
+                    reply += lastReply.append(DELIMITER);
+
+                lastCommand = COMMAND;
+                lastReply   = g_pHyprCtl->getReply(COMMAND);
+            }
             idx = i + 1;
             continue;
         }
     }
 
-    return reply.substr(0, std::max(static_cast<int>(reply.size() - DELIMITER.size()), 0));
+    if (OUTERMOST) {
+        if (const auto DONE = flushKeywordBatch(); !DONE.empty())
+            refreshed += std::format("{}{}", refreshed.empty() ? "" : ", ", DONE);
+    }
+
+    appendRefreshReport(lastReply, lastCommand, refreshed);
+
+    return reply + lastReply;
 }
 
 static std::string dispatchSetCursor(eHyprCtlOutputFormat format, std::string request) {
@@ -1655,9 +2162,11 @@ static std::string reloadShaders(eHyprCtlOutputFormat format, std::string reques
 
 CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"workspaces", true, workspacesRequest});
+    registerCommand(SHyprCtlCommand{"workspaces since ", false, workspacesRequest});
     registerCommand(SHyprCtlCommand{"workspacerules", true, workspaceRulesRequest});
     registerCommand(SHyprCtlCommand{"activeworkspace", true, activeWorkspaceRequest});
     registerCommand(SHyprCtlCommand{"clients", true, clientsRequest});
+    registerCommand(SHyprCtlCommand{"clients since ", false, clientsRequest});
     registerCommand(SHyprCtlCommand{"kill", true, killRequest});
     registerCommand(SHyprCtlCommand{"activewindow", true, activeWindowRequest});
     registerCommand(SHyprCtlCommand{"layers", true, layersRequest});
@@ -1671,6 +2180,10 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"animations", true, animationsRequest});
     registerCommand(SHyprCtlCommand{"rollinglog", true, rollinglogRequest});
     registerCommand(SHyprCtlCommand{"layouts", true, layoutsRequest});
+    registerCommand(SHyprCtlCommand{"timers", true, timersRequest});
+    registerCommand(SHyprCtlCommand{"damage", true, damageRequest});
+    registerCommand(SHyprCtlCommand{"geometry", true, geometryRequest});
+    registerCommand(SHyprCtlCommand{"layoutstats", true, layoutStatsRequest});
     registerCommand(SHyprCtlCommand{"configerrors", true, configErrorsRequest});
     registerCommand(SHyprCtlCommand{"locked", true, getIsLocked});
     registerCommand(SHyprCtlCommand{"descriptions", true, getDescriptions});
@@ -1697,6 +2210,13 @@ CHyprCtl::CHyprCtl() {
 }
 
 CHyprCtl::~CHyprCtl() {
+    for (auto const& c : m_clients) {
+        if (c->eventSource)
+            wl_event_source_remove(c->eventSource);
+        if (c->timeoutSource)
+            wl_event_source_remove(c->timeoutSource);
+    }
+
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
     if (!m_socketPath.empty())
@@ -1777,33 +2297,89 @@ std::string CHyprCtl::getReply(std::string request) {
     if (reloadAll) {
         g_pConfigManager->m_wantsMonitorReload = true; // for monitor keywords
 
-        g_pInputManager->setKeyboardLayout();     // update kb layout
-        g_pInputManager->setPointerConfigs();     // update mouse cfgs
-        g_pInputManager->setTouchDeviceConfigs(); // update touch device cfgs
-        g_pInputManager->setTabletConfigs();      // update tablets
+        constexpr uint8_t ALL = KEYWORD_REFRESH_INPUT | KEYWORD_REFRESH_LAYOUT | KEYWORD_REFRESH_SCREEN_SHADER | KEYWORD_REFRESH_BLUR | KEYWORD_REFRESH_RULES |
+            KEYWORD_REFRESH_DECORATIONS | KEYWORD_REFRESH_MONITORS;
 
-        static auto PLAYOUT = CConfigValue<std::string>("general:layout");
+        if (m_keywordBatch.active)
+            m_keywordBatch.pending |= ALL;
+        else
+            runKeywordRefresh(ALL);
+    }
 
-        g_pLayoutManager->switchToLayout(*PLAYOUT); // update layout
+    return result;
+}
 
-        g_pHyprOpenGL->m_bReloadScreenShader = true;
+std::string CHyprCtl::getSnapshotDelta(const std::string& kind, const std::vector<SSnapshotEntry>& entries, uint64_t since, eHyprCtlOutputFormat format) {
+    constexpr size_t MAX_REMEMBERED_REMOVALS = 1024;
 
-        for (auto& [m, rd] : g_pHyprOpenGL->m_mMonitorRenderResources) {
-            rd.blurFBDirty = true;
+    const bool       FRESH   = !m_snapshotTrackers.contains(kind);
+    auto&            tracker = m_snapshotTrackers[kind];
+
+    std::unordered_map<std::string, uint64_t> live;
+    for (auto const& e : entries) {
+        live[e.id] = e.generation;
+    }
+
+    for (auto const& [id, _] : tracker.live) {
+        if (!live.contains(id))
+            tracker.removed.emplace_back(++m_snapshotGeneration, id);
+    }
+
+    tracker.live = std::move(live);
+
+    while (tracker.removed.size() > MAX_REMEMBERED_REMOVALS) {
+        tracker.forgottenUntil = tracker.removed.front().first;
+        tracker.removed.pop_front();
+    }
+
+    // if we can't tell what went away since `since`, the caller has to resync from scratch
+    const bool FULL = (FRESH && since != 0) || since < tracker.forgottenUntil || since > m_snapshotGeneration;
+
+    std::vector<std::string_view> changed, removed;
+    for (auto const& e : entries) {
+        if (FULL || e.generation > since)
+            changed.emplace_back(e.data);
+    }
+
+    if (!FULL) {
+        for (auto const& [gen, id] : tracker.removed) {
+            if (gen > since)
+                removed.emplace_back(id);
         }
+    }
 
-        for (auto const& w : g_pCompositor->m_windows) {
-            if (!w->m_isMapped || !w->m_workspace || !w->m_workspace->isVisible())
-                continue;
+    std::string result;
 
-            w->updateDynamicRules();
-            g_pCompositor->updateWindowAnimatedDecorationValues(w);
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        result = std::format("{{\n\"generation\": {},\n\"full\": {},\n\"changed\": [", m_snapshotGeneration, FULL ? "true" : "false");
+
+        for (auto const& c : changed) {
+            result += c.ends_with(',') ? c.substr(0, c.length() - 1) : c;
+            result += ",";
         }
 
-        for (auto const& m : g_pCompositor->m_monitors) {
-            g_pHyprRenderer->damageMonitor(m);
-            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
+        trimTrailingComma(result);
+        result += "],\n\"removed\": [";
+
+        for (auto const& r : removed) {
+            result += std::format("\"{}\",", escapeJSONStrings(std::string{r}));
+        }
+
+        trimTrailingComma(result);
+        result += "]\n}";
+    } else {
+        result = std::format("generation: {}\nfull: {}\n\n", m_snapshotGeneration, FULL ? "yes" : "no");
+
+        for (auto const& c : changed) {
+            result += c;
         }
+
+        result += "removed:";
+        for (auto const& r : removed) {
+            result += std::format(" {}", r);
+        }
+
+        result += "\n";
     }
 
     return result;
@@ -1814,16 +2390,29 @@ std::string CHyprCtl::makeDynamicCall(const std::string& input) {
 }
 
 static bool successWrite(int fd, const std::string& data, bool needLog = true) {
-    if (write(fd, data.c_str(), data.length()) > 0)
-        return true;
+    size_t written = 0;
 
-    if (errno == EAGAIN)
-        return true;
+    while (written < data.length()) {
+        const auto RET = write(fd, data.c_str() + written, data.length() - written);
 
-    if (needLog)
-        Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+        if (RET > 0) {
+            written += RET;
+            continue;
+        }
 
-    return false;
+        if (RET < 0 && errno == EINTR)
+            continue;
+
+        if (RET < 0 && errno == EAGAIN)
+            return true;
+
+        if (needLog)
+            Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+
+        return false;
+    }
+
+    return true;
 }
 
 static void runWritingDebugLogThread(const int conn) {
@@ -1853,74 +2442,232 @@ static bool isFollowUpRollingLogRequest(const std::string& request) {
     return request.contains("rollinglog") && request.contains("f");
 }
 
-static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
+// how long a client may take to send its request / read its reply before we drop it
+constexpr int    HYPRCTL_CLIENT_TIMEOUT_MS = 5000;
+constexpr size_t HYPRCTL_MAX_CLIENTS       = 256;
+
+int CHyprCtl::onServerEvent(int fd, uint32_t mask, void* data) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
         return 0;
 
-    if (!g_pHyprCtl->m_socketFD.isValid())
+    g_pHyprCtl->acceptClients();
+    return 0;
+}
+
+int CHyprCtl::onClientEvent(int fd, uint32_t mask, void* data) {
+    auto CLIENT = (SClient*)data;
+
+    if (mask & WL_EVENT_ERROR) {
+        g_pHyprCtl->removeClient(CLIENT);
+        return 0;
+    }
+
+    if ((mask & WL_EVENT_WRITABLE) && !g_pHyprCtl->flushClient(CLIENT))
         return 0;
 
-    sockaddr_in            clientAddress;
-    socklen_t              clientSize = sizeof(clientAddress);
+    if (mask & (WL_EVENT_READABLE | WL_EVENT_HANGUP))
+        g_pHyprCtl->readFromClient(CLIENT);
 
-    const auto             ACCEPTEDCONNECTION = accept4(g_pHyprCtl->m_socketFD.get(), (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC);
+    return 0;
+}
 
-    std::array<char, 1024> readBuffer;
+int CHyprCtl::onClientTimeout(void* data) {
+    auto CLIENT = (SClient*)data;
 
-    //
-    pollfd pollfds[1] = {
-        {
-            .fd     = ACCEPTEDCONNECTION,
-            .events = POLLIN,
-        },
-    };
+    Debug::log(WARN, "hyprctl client at fd {} timed out, dropping", CLIENT->fd.get());
 
-    int ret = poll(pollfds, 1, 5000);
+    g_pHyprCtl->removeClient(CLIENT);
+    return 0;
+}
 
-    if (ret <= 0) {
-        close(ACCEPTEDCONNECTION);
-        return 0;
+void CHyprCtl::acceptClients() {
+    if (!m_socketFD.isValid())
+        return;
+
+    while (true) {
+        sockaddr_in     clientAddress;
+        socklen_t       clientSize = sizeof(clientAddress);
+
+        CFileDescriptor ACCEPTEDCONNECTION{accept4(m_socketFD.get(), (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK)};
+
+        if (!ACCEPTEDCONNECTION.isValid()) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                Debug::log(ERR, "hyprctl socket failed receiving connection, errno: {}", errno);
+            return;
+        }
+
+        if (m_clients.size() >= HYPRCTL_MAX_CLIENTS) {
+            Debug::log(WARN, "hyprctl socket: too many clients, refusing connection");
+            continue;
+        }
+
+        auto& client          = m_clients.emplace_back(makeUnique<SClient>());
+        client->fd            = std::move(ACCEPTEDCONNECTION);
+        client->eventSource   = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, client->fd.get(), WL_EVENT_READABLE, onClientEvent, client.get());
+        client->timeoutSource = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, onClientTimeout, client.get());
+        wl_event_source_timer_update(client->timeoutSource, HYPRCTL_CLIENT_TIMEOUT_MS);
     }
+}
+
+void CHyprCtl::readFromClient(SClient* client) {
+    std::array<char, 4096> readBuffer;
+    bool                   eof = false;
 
-    std::string request;
     while (true) {
-        readBuffer.fill(0);
-        auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
-        if (messageSize < 1)
-            break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
-        if (messageSize < 1023)
-            break;
+        const auto MESSAGESIZE = read(client->fd.get(), readBuffer.data(), readBuffer.size());
+
+        if (MESSAGESIZE > 0) {
+            client->readBuffer.append(readBuffer.data(), MESSAGESIZE);
+            continue;
+        }
+
+        if (MESSAGESIZE < 0 && errno == EINTR)
+            continue;
+
+        if (MESSAGESIZE == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            eof = true;
+
+        break;
     }
 
-    std::string reply = "";
+    if (!client->persistent && client->readBuffer.contains('\0'))
+        client->persistent = true;
 
-    try {
-        reply = g_pHyprCtl->getReply(request);
-    } catch (std::exception& e) {
-        Debug::log(ERR, "Error in request: {}", e.what());
-        reply = "Err: " + std::string(e.what());
+    if (!client->persistent) {
+        if (!client->readBuffer.empty())
+            handleClientRequests(client);
+        else if (eof)
+            removeClient(client);
+
+        return;
+    }
+
+    if (!handleClientRequests(client))
+        return;
+
+    // the client went away. If it still has a reply pending, flushClient will drop it on write failure.
+    if (eof && client->writeBuffer.empty())
+        removeClient(client);
+}
+
+bool CHyprCtl::handleClientRequests(SClient* client) {
+    std::vector<std::string> requests;
+
+    if (client->persistent) {
+        size_t pos = 0;
+        while ((pos = client->readBuffer.find('\0')) != std::string::npos) {
+            requests.emplace_back(client->readBuffer.substr(0, pos));
+            client->readBuffer.erase(0, pos + 1);
+        }
+    } else {
+        // legacy clients send exactly one request per connection
+        requests.emplace_back(std::move(client->readBuffer));
+        client->readBuffer.clear();
     }
 
-    successWrite(ACCEPTEDCONNECTION, reply);
+    for (auto const& request : requests) {
+        std::string reply = "";
 
-    if (isFollowUpRollingLogRequest(request)) {
-        Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
-        Debug::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION);
-        runWritingDebugLogThread(ACCEPTEDCONNECTION);
-        Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
-    } else
-        close(ACCEPTEDCONNECTION);
+        try {
+            reply = getReply(request);
+        } catch (std::exception& e) {
+            Debug::log(ERR, "Error in request: {}", e.what());
+            reply = "Err: " + std::string(e.what());
+        }
+
+        client->writeBuffer += reply;
+
+        if (client->persistent)
+            client->writeBuffer += '\0';
+        else if (isFollowUpRollingLogRequest(request))
+            client->followLog = true;
+    }
 
     if (g_pConfigManager->m_wantsMonitorReload)
         g_pConfigManager->ensureMonitorStatus();
 
-    return 0;
+    return flushClient(client);
+}
+
+bool CHyprCtl::flushClient(SClient* client) {
+    bool progressed = false;
+
+    while (client->written < client->writeBuffer.length()) {
+        const auto RET = write(client->fd.get(), client->writeBuffer.c_str() + client->written, client->writeBuffer.length() - client->written);
+
+        if (RET > 0) {
+            client->written += RET;
+            progressed = true;
+            continue;
+        }
+
+        if (RET < 0 && errno == EINTR)
+            continue;
+
+        if (RET < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // wait until the client drains its socket. Don't read more requests meanwhile, a client that never reads
+            // would otherwise grow writeBuffer without bound. Only reading the reply buys it more time.
+            if (!client->writeBlocked || progressed)
+                wl_event_source_timer_update(client->timeoutSource, HYPRCTL_CLIENT_TIMEOUT_MS);
+
+            if (!client->writeBlocked)
+                wl_event_source_fd_update(client->eventSource, WL_EVENT_WRITABLE);
+
+            client->writeBlocked = true;
+            return true;
+        }
+
+        Debug::log(ERR, "Couldn't write to hyprctl socket. Error: {}", strerror(errno));
+        removeClient(client);
+        return false;
+    }
+
+    client->writeBuffer.clear();
+    client->written      = 0;
+    client->writeBlocked = false;
+
+    if (client->persistent) {
+        // idle persistent clients may stay connected indefinitely, only time out requests in flight
+        wl_event_source_fd_update(client->eventSource, WL_EVENT_READABLE);
+        wl_event_source_timer_update(client->timeoutSource, client->readBuffer.empty() ? 0 : HYPRCTL_CLIENT_TIMEOUT_MS);
+        return true;
+    }
+
+    if (client->followLog) {
+        Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
+
+        // the follow thread does blocking writes
+        const int CONN = client->fd.take();
+        fcntl(CONN, F_SETFL, fcntl(CONN, F_GETFL) & ~O_NONBLOCK);
+
+        removeClient(client);
+
+        Debug::SRollingLogFollow::get().startFor(CONN);
+        runWritingDebugLogThread(CONN);
+        Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
+        return false;
+    }
+
+    removeClient(client);
+    return false;
+}
+
+void CHyprCtl::removeClient(SClient* client) {
+    const auto IT = std::ranges::find_if(m_clients, [client](const auto& c) { return c.get() == client; });
+
+    if (IT == m_clients.end())
+        return;
+
+    if (client->eventSource)
+        wl_event_source_remove(client->eventSource);
+    if (client->timeoutSource)
+        wl_event_source_remove(client->timeoutSource);
+
+    m_clients.erase(IT);
 }
 
 void CHyprCtl::startHyprCtlSocket() {
-    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)};
 
     if (!m_socketFD.isValid()) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
@@ -1938,10 +2685,10 @@ void CHyprCtl::startHyprCtlSocket() {
         return;
     }
 
-    // 10 max queued.
-    listen(m_socketFD.get(), 10);
+    // clients are accepted in bursts, allow a deeper backlog than socket2
+    listen(m_socketFD.get(), 128);
 
     Debug::log(LOG, "Hypr socket started at {}", m_socketPath);
 
-    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, hyprCtlFDTick, nullptr);
+    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
 }
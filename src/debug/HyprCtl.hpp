@@ -3,7 +3,9 @@
 #include <fstream>
 #include "../helpers/MiscFunctions.hpp"
 #include "../desktop/Window.hpp"
+#include <deque>
 #include <functional>
+#include <unordered_map>
 #include <hyprutils/os/FileDescriptor.hpp>
 
 // exposed for main.cpp
@@ -27,14 +29,72 @@ class CHyprCtl {
         bool sysInfoConfig = false;
     } m_currentRequestParams;
 
-    static std::string getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format);
-    static std::string getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format);
+    // inside [[BATCH]], keywords only collect their refreshes (eKeywordRefresh), run before the next non-keyword or at the end
+    struct {
+        bool    active  = false;
+        uint8_t pending = 0;
+    } m_keywordBatch;
+
+    static std::string getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format, const std::unordered_map<CWindow*, int>* focusHistoryIDs = nullptr);
+    static std::string getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format, const std::unordered_map<WORKSPACEID, int>* windowCounts = nullptr);
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
+    // window -> index in the focus history, so getWindowData on every window doesn't scan it for each
+    static std::unordered_map<CWindow*, int> focusHistoryIDs();
+    // workspace id -> mapped windows on it, so getWorkspaceData on every workspace doesn't walk the windows for each
+    static std::unordered_map<WORKSPACEID, int> workspaceWindowCounts();
+
+    // bumped every time a cached object snapshot is rebuilt (or an object disappears)
+    uint64_t m_snapshotGeneration = 0;
+
+    struct SSnapshotEntry {
+        std::string id;
+        uint64_t    generation = 0;
+        std::string data;
+    };
+
+    // formats the objects of one kind that changed (or went away) since generation `since`
+    std::string getSnapshotDelta(const std::string& kind, const std::vector<SSnapshotEntry>& entries, uint64_t since, eHyprCtlOutputFormat format);
+
   private:
+    struct SClient {
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource   = nullptr;
+        wl_event_source*               timeoutSource = nullptr;
+
+        std::string                    readBuffer;
+        std::string                    writeBuffer;
+        size_t                         written      = 0;
+        bool                           writeBlocked = false; // waiting for WL_EVENT_WRITABLE, requests aren't read meanwhile
+
+        // persistent clients terminate each request (and get each reply terminated) with a NUL byte,
+        // and keep the connection open for further requests.
+        bool persistent = false;
+        bool followLog  = false;
+    };
+
     void                             startHyprCtlSocket();
 
-    std::vector<SP<SHyprCtlCommand>> m_commands;
+    static int                       onServerEvent(int fd, uint32_t mask, void* data);
+    static int                       onClientEvent(int fd, uint32_t mask, void* data);
+    static int                       onClientTimeout(void* data);
+
+    void                             acceptClients();
+    void                             readFromClient(SClient* client);
+    // these return false if the client was removed
+    bool                             handleClientRequests(SClient* client);
+    bool                             flushClient(SClient* client);
+    void                             removeClient(SClient* client);
+
+    struct SSnapshotTracker {
+        std::unordered_map<std::string, uint64_t>    live;
+        std::deque<std::pair<uint64_t, std::string>> removed;
+        uint64_t                                     forgottenUntil = 0; // removals up to this generation were dropped from the log
+    };
+
+    std::vector<SP<SHyprCtlCommand>>                  m_commands;
+    std::vector<UP<SClient>>                          m_clients;
+    std::unordered_map<std::string, SSnapshotTracker> m_snapshotTrackers;
     wl_event_source*                 m_eventSource = nullptr;
     std::string                      m_socketPath;
 };
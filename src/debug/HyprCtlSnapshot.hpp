@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+    Cached hyprctl serialization of a single window / workspace / monitor.
+
+    The snapshot keeps the state its fragments were built from. The state is only rebuilt while the
+    snapshot is dirty: windows and workspaces are marked where their strings, lists and focus order
+    change, and compare their plain scalar members (geometry goals, flags, ids) on read. Monitors
+    compare their whole state on read. A rebuild that changed anything drops the fragments and
+    stamps the snapshot with a new generation.
+*/
+template <typename TState>
+struct SHyprCtlSnapshot {
+    TState                     state;
+    std::optional<std::string> json, normal;
+    uint64_t                   generation = 0; // 0 means never built
+    bool                       dirty      = true;
+};
+
+struct SHyprCtlWindowState {
+    uintptr_t              address = 0;
+    bool                   mapped = false, hidden = false;
+    int                    x = 0, y = 0, w = 0, h = 0;
+    int64_t                workspaceID = 0;
+    std::string            workspaceName;
+    bool                   floating = false, pseudo = false;
+    int64_t                monitorID = 0;
+    std::string            windowClass, title, initialClass, initialTitle;
+    int                    pid = 0;
+    bool                   xwayland = false, pinned = false;
+    uint8_t                fullscreen = 0, fullscreenClient = 0;
+    std::vector<uintptr_t> grouped;
+    std::set<std::string>  tags;
+    uintptr_t              swallowing     = 0;
+    int                    focusHistoryID = -1;
+    bool                   inhibitingIdle = false;
+    std::string            xdgTag, xdgDescription;
+
+    bool                   operator==(const SHyprCtlWindowState&) const = default;
+};
+
+struct SHyprCtlWorkspaceState {
+    int64_t     id = 0;
+    std::string name, monitor, monitorID;
+    int         windows       = 0;
+    bool        hasFullscreen = false;
+    uintptr_t   lastWindow    = 0;
+    std::string lastWindowTitle;
+    bool        persistent = false;
+
+    bool        operator==(const SHyprCtlWorkspaceState&) const = default;
+};
+
+struct SHyprCtlMonitorState {
+    int64_t     id = 0;
+    std::string name, description, make, model, serial;
+    int         width = 0, height = 0;
+    float       refreshRate = 0;
+    int         x = 0, y = 0;
+    int64_t     activeWorkspaceID = 0;
+    std::string activeWorkspaceName;
+    int64_t     specialWorkspaceID = 0;
+    std::string specialWorkspaceName;
+    int         reserved[4] = {0};
+    float       scale       = 1;
+    int         transform   = 0;
+    bool        focused = false, dpms = false, vrr = false;
+    uintptr_t   solitary        = 0;
+    bool        activelyTearing = false;
+    uintptr_t   directScanoutTo = 0;
+    bool        disabled        = false;
+    uint32_t    drmFormat       = 0;
+    int64_t     mirrorOf        = -1;
+    size_t      modes           = 0; // output modes don't change after connect, only track how many there are
+
+    bool        operator==(const SHyprCtlMonitorState&) const = default;
+};
@@ -1,13 +1,13 @@
-#include <pango/pangocairo.h>
 #include "HyprDebugOverlay.hpp"
 #include "config/ConfigValue.hpp"
 #include "../Compositor.hpp"
-#include "../render/pass/TexPassElement.hpp"
+#include "../render/pass/TextPassElement.hpp"
+#include "../render/TextEngine.hpp"
 #include "../render/Renderer.hpp"
 #include "../managers/AnimationManager.hpp"
 
 CHyprDebugOverlay::CHyprDebugOverlay() {
-    m_texture = makeShared<CTexture>();
+    ;
 }
 
 void CHyprMonitorDebugOverlay::renderData(PHLMONITOR pMonitor, float durationUs) {
@@ -21,6 +21,10 @@ void CHyprMonitorDebugOverlay::renderData(PHLMONITOR pMonitor, float durationUs)
     if (m_lastRenderTimes.size() > (long unsigned int)pMonitor->refreshRate)
         m_lastRenderTimes.pop_front();
 
+    // the monitor's frame just ended
+    m_glCallsIssued  = g_pHyprOpenGL->m_glCallsLastFrame.issued;
+    m_glCallsSkipped = g_pHyprOpenGL->m_glCallsLastFrame.skipped;
+
     if (!m_monitor)
         m_monitor = pMonitor;
 }
@@ -124,79 +128,62 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     float varAnimMgrTick = maxAnimMgrTick - minAnimMgrTick;
     avgAnimMgrTick /= m_lastAnimationTicks.size() == 0 ? 1 : m_lastAnimationTicks.size();
 
-    const float           FPS      = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
-    const float           idealFPS = m_lastFrametimes.size();
+    const float FPS      = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
+    const float idealFPS = m_lastFrametimes.size();
 
-    static auto           fontFamily = CConfigValue<std::string>("misc:font_family");
-    PangoLayout*          layoutText = pango_cairo_create_layout(g_pDebugOverlay->m_cairo);
-    PangoFontDescription* pangoFD    = pango_font_description_new();
+    static auto fontFamily = CConfigValue<std::string>("misc:font_family");
 
-    pango_font_description_set_family(pangoFD, (*fontFamily).c_str());
-    pango_font_description_set_style(pangoFD, PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
+    const int   MARGIN_TOP  = 8;
+    const int   MARGIN_LEFT = 4;
 
-    float maxTextW = 0;
-    int   fontSize = 0;
-    auto  cr       = g_pDebugOverlay->m_cairo;
+    float       maxTextW = 0;
+    float       posY     = MARGIN_TOP + offset;
+    CHyprColor  color    = CHyprColor{1.f, 1.f, 1.f, 1.f};
 
-    auto  showText = [cr, layoutText, pangoFD, &maxTextW, &fontSize](const char* text, int size) {
-        if (fontSize != size) {
-            pango_font_description_set_absolute_size(pangoFD, size * PANGO_SCALE);
-            pango_layout_set_font_description(layoutText, pangoFD);
-            fontSize = size;
-        }
+    auto        showText = [&maxTextW, &posY, &color](const std::string& text, int size) {
+        const auto SHAPED = g_pHyprOpenGL->m_pTextEngine->shape(text, {.family = *fontFamily, .size = size});
 
-        pango_layout_set_text(layoutText, text, -1);
-        pango_cairo_show_layout(cr, layoutText);
+        CTextPassElement::STextData data;
+        data.text  = SHAPED;
+        data.pos   = {MARGIN_LEFT, posY};
+        data.color = color;
+        g_pHyprRenderer->m_sRenderPass.add(makeShared<CTextPassElement>(data));
 
-        int textW = 0, textH = 0;
-        pango_layout_get_size(layoutText, &textW, &textH);
-        textW /= PANGO_SCALE;
-        textH /= PANGO_SCALE;
-        if (textW > maxTextW)
-            maxTextW = textW;
+        if (SHAPED->size.x > maxTextW)
+            maxTextW = SHAPED->size.x;
 
         // move to next line
-        cairo_rel_move_to(cr, 0, fontSize + 1);
+        posY += size + 1;
     };
 
-    const int MARGIN_TOP  = 8;
-    const int MARGIN_LEFT = 4;
-    cairo_move_to(cr, MARGIN_LEFT, MARGIN_TOP + offset);
-    cairo_set_source_rgba(g_pDebugOverlay->m_cairo, 1.f, 1.f, 1.f, 1.f);
-
-    std::string text;
-    showText(m_monitor->szName.c_str(), 10);
+    showText(m_monitor->szName, 10);
 
     if (FPS > idealFPS * 0.95f)
-        cairo_set_source_rgba(g_pDebugOverlay->m_cairo, 0.2f, 1.f, 0.2f, 1.f);
+        color = CHyprColor{0.2f, 1.f, 0.2f, 1.f};
     else if (FPS > idealFPS * 0.8f)
-        cairo_set_source_rgba(g_pDebugOverlay->m_cairo, 1.f, 1.f, 0.2f, 1.f);
+        color = CHyprColor{1.f, 1.f, 0.2f, 1.f};
     else
-        cairo_set_source_rgba(g_pDebugOverlay->m_cairo, 1.f, 0.2f, 0.2f, 1.f);
-
-    text = std::format("{} FPS", (int)FPS);
-    showText(text.c_str(), 16);
-
-    cairo_set_source_rgba(g_pDebugOverlay->m_cairo, 1.f, 1.f, 1.f, 1.f);
+        color = CHyprColor{1.f, 0.2f, 0.2f, 1.f};
 
-    text = std::format("Avg Frametime: {:.2f}ms (var {:.2f}ms)", avgFrametime, varFrametime);
-    showText(text.c_str(), 10);
+    showText(std::format("{} FPS", (int)FPS), 16);
 
-    text = std::format("Avg Rendertime: {:.2f}ms (var {:.2f}ms)", avgRenderTime, varRenderTime);
-    showText(text.c_str(), 10);
+    color = CHyprColor{1.f, 1.f, 1.f, 1.f};
 
-    text = std::format("Avg Rendertime (No Overlay): {:.2f}ms (var {:.2f}ms)", avgRenderTimeNoOverlay, varRenderTimeNoOverlay);
-    showText(text.c_str(), 10);
+    showText(std::format("Avg Frametime: {:.2f}ms (var {:.2f}ms)", avgFrametime, varFrametime), 10);
+    showText(std::format("Avg Rendertime: {:.2f}ms (var {:.2f}ms)", avgRenderTime, varRenderTime), 10);
+    showText(std::format("Avg Rendertime (No Overlay): {:.2f}ms (var {:.2f}ms)", avgRenderTimeNoOverlay, varRenderTimeNoOverlay), 10);
+    showText(std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0)), 10);
 
-    text = std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0));
-    showText(text.c_str(), 10);
+    const auto& TICKSTATS = g_pAnimationManager->getTickStats();
+    showText(std::format("Last Anim Tick: {} vars in {:.1f}us ({:.2f}us per var)", TICKSTATS.vars, TICKSTATS.costUs, TICKSTATS.vars ? TICKSTATS.costUs / TICKSTATS.vars : 0.F),
+             10);
+    showText(std::format("GL state calls: {} issued, {} skipped", m_glCallsIssued, m_glCallsSkipped), 10);
 
-    pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-
-    double posX = 0, posY = 0;
-    cairo_get_current_point(cr, &posX, &posY);
+    const auto& TEXTSTATS = g_pHyprOpenGL->m_pTextEngine->stats();
+    const auto  HITRATE   = [](uint64_t hits, uint64_t misses) { return hits + misses == 0 ? 100.0 : 100.0 * hits / (hits + misses); };
+    showText(std::format("Text cache: {:.1f}% runs, {:.1f}% glyphs hit ({} atlases)", HITRATE(TEXTSTATS.runHits, TEXTSTATS.runMisses),
+                         HITRATE(TEXTSTATS.glyphHits, TEXTSTATS.glyphMisses), TEXTSTATS.atlases),
+             10);
 
     g_pHyprRenderer->damageBox(m_lastDrawnBox);
     m_lastDrawnBox = {(int)g_pCompositor->m_monitors.front()->vecPosition.x + MARGIN_LEFT - 1, (int)g_pCompositor->m_monitors.front()->vecPosition.y + offset + MARGIN_TOP - 1,
@@ -234,45 +221,10 @@ void CHyprDebugOverlay::frameData(PHLMONITOR pMonitor) {
 }
 
 void CHyprDebugOverlay::draw() {
-
-    const auto PMONITOR = g_pCompositor->m_monitors.front();
-
-    if (!m_cairoSurface || !m_cairo) {
-        m_cairoSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
-        m_cairo        = cairo_create(m_cairoSurface);
-    }
-
-    // clear the pixmap
-    cairo_save(m_cairo);
-    cairo_set_operator(m_cairo, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(m_cairo);
-    cairo_restore(m_cairo);
-
     // draw the things
     int offsetY = 0;
     for (auto const& m : g_pCompositor->m_monitors) {
         offsetY += m_monitorOverlays[m].draw(offsetY);
         offsetY += 5; // for padding between mons
     }
-
-    cairo_surface_flush(m_cairoSurface);
-
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(m_cairoSurface);
-    m_texture->allocate();
-    glBindTexture(GL_TEXTURE_2D, m_texture->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    CTexPassElement::SRenderData data;
-    data.tex = m_texture;
-    data.box = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
-    g_pHyprRenderer->m_sRenderPass.add(makeShared<CTexPassElement>(data));
 }
@@ -2,7 +2,6 @@
 
 #include "../defines.hpp"
 #include "../render/Texture.hpp"
-#include <cairo/cairo.h>
 #include <map>
 #include <deque>
 
@@ -24,6 +23,8 @@ class CHyprMonitorDebugOverlay {
     std::chrono::high_resolution_clock::time_point m_lastFrame;
     PHLMONITORREF                                  m_monitor;
     CBox                                           m_lastDrawnBox;
+    uint64_t                                       m_glCallsIssued  = 0; // in the last frame
+    uint64_t                                       m_glCallsSkipped = 0;
 
     friend class CHyprRenderer;
 };
@@ -39,11 +40,6 @@ class CHyprDebugOverlay {
   private:
     std::map<PHLMONITORREF, CHyprMonitorDebugOverlay> m_monitorOverlays;
 
-    cairo_surface_t*                                  m_cairoSurface = nullptr;
-    cairo_t*                                          m_cairo        = nullptr;
-
-    SP<CTexture>                                      m_texture;
-
     friend class CHyprMonitorDebugOverlay;
     friend class CHyprRenderer;
 };
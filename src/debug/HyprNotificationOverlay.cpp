@@ -4,6 +4,9 @@
 #include "../Compositor.hpp"
 #include "../config/ConfigValue.hpp"
 #include "../render/pass/TexPassElement.hpp"
+#include "../render/pass/RectPassElement.hpp"
+#include "../render/pass/TextPassElement.hpp"
+#include "../render/TextEngine.hpp"
 
 #include "../managers/AnimationManager.hpp"
 #include "../managers/HookSystemManager.hpp"
@@ -28,15 +31,6 @@ CHyprNotificationOverlay::CHyprNotificationOverlay() {
 
         g_pHyprRenderer->damageBox(m_lastDamage);
     });
-
-    m_texture = makeShared<CTexture>();
-}
-
-CHyprNotificationOverlay::~CHyprNotificationOverlay() {
-    if (m_cairo)
-        cairo_destroy(m_cairo);
-    if (m_cairoSurface)
-        cairo_surface_destroy(m_cairoSurface);
 }
 
 void CHyprNotificationOverlay::addNotification(const std::string& text, const CHyprColor& color, const float timeMs, const eIcons icon, const float fontSize) {
@@ -66,6 +60,46 @@ void CHyprNotificationOverlay::dismissNotifications(const int amount) {
     }
 }
 
+SP<CTexture> CHyprNotificationOverlay::iconGradient(eIcons icon) {
+    static constexpr auto GRADIENT_SIZE = 60;
+
+    auto&                 tex = m_iconGradients[icon];
+    if (tex)
+        return tex;
+
+    const auto ICONCOLOR    = ICONS_COLORS[icon];
+    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, GRADIENT_SIZE, 1);
+    const auto CAIRO        = cairo_create(CAIROSURFACE);
+
+    cairo_pattern_t* pattern = cairo_pattern_create_linear(0, 0, GRADIENT_SIZE, 0);
+    cairo_pattern_add_color_stop_rgba(pattern, 0, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, ICONCOLOR.a / 3.0);
+    cairo_pattern_add_color_stop_rgba(pattern, 1, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, 0);
+    cairo_rectangle(CAIRO, 0, 0, GRADIENT_SIZE, 1);
+    cairo_set_source(CAIRO, pattern);
+    cairo_fill(CAIRO);
+    cairo_pattern_destroy(pattern);
+
+    cairo_surface_flush(CAIROSURFACE);
+
+    tex = makeShared<CTexture>();
+    tex->allocate();
+    tex->m_vSize = {GRADIENT_SIZE, 1};
+
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, tex->m_iTexID);
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+#ifndef GLES2
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, GRADIENT_SIZE, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, cairo_image_surface_get_data(CAIROSURFACE));
+
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+
+    return tex;
+}
+
 CBox CHyprNotificationOverlay::drawNotifications(PHLMONITOR pMonitor) {
     static constexpr auto ANIM_DURATION_MS   = 600.0;
     static constexpr auto ANIM_LAG_MS        = 100.0;
@@ -82,15 +116,35 @@ CBox CHyprNotificationOverlay::drawNotifications(PHLMONITOR pMonitor) {
 
     static auto           fontFamily = CConfigValue<std::string>("misc:font_family");
 
-    PangoLayout*          layout  = pango_cairo_create_layout(m_cairo);
-    PangoFontDescription* pangoFD = pango_font_description_new();
+    if (!m_iconBackend) {
+        // needs a layout to ask pango about the glyphs
+        const auto   CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+        const auto   CAIRO        = cairo_create(CAIROSURFACE);
+        PangoLayout* layout       = pango_cairo_create_layout(CAIRO);
 
-    pango_font_description_set_family(pangoFD, (*fontFamily).c_str());
-    pango_font_description_set_style(pangoFD, PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
+        m_iconBackend = iconBackendFromLayout(layout);
 
-    const auto iconBackendID = iconBackendFromLayout(layout);
-    const auto PBEZIER       = g_pAnimationManager->getBezier("default");
+        g_object_unref(layout);
+        cairo_destroy(CAIRO);
+        cairo_surface_destroy(CAIROSURFACE);
+    }
+
+    const auto PBEZIER = g_pAnimationManager->getBezier("default");
+
+    const auto addRect = [](const CBox& box, const CHyprColor& color) {
+        CRectPassElement::SRectData data;
+        data.box   = box;
+        data.color = color;
+        g_pHyprRenderer->m_sRenderPass.add(makeShared<CRectPassElement>(data));
+    };
+
+    const auto addText = [](SP<SShapedText> text, const Vector2D& pos, const CHyprColor& color) {
+        CTextPassElement::STextData data;
+        data.text  = text;
+        data.pos   = pos;
+        data.color = color;
+        g_pHyprRenderer->m_sRenderPass.add(makeShared<CTextPassElement>(data));
+    };
 
     for (auto const& notif : m_notifications) {
         const auto ICONPADFORNOTIF = notif->icon == ICON_NONE ? 0 : ICON_PAD;
@@ -117,64 +171,36 @@ CBox CHyprNotificationOverlay::drawNotifications(PHLMONITOR pMonitor) {
         const float THIRDRECTPERC = notif->started.getMillis() / notif->timeMs;
 
         // get text size
-        const auto ICON      = ICONS_ARRAY[iconBackendID][notif->icon];
-        const auto ICONCOLOR = ICONS_COLORS[notif->icon];
-
-        int        iconW = 0, iconH = 0;
-        pango_font_description_set_absolute_size(pangoFD, PANGO_SCALE * FONTSIZE * ICON_SCALE);
-        pango_layout_set_font_description(layout, pangoFD);
-        pango_layout_set_text(layout, ICON.c_str(), -1);
-        pango_layout_get_size(layout, &iconW, &iconH);
-        iconW /= PANGO_SCALE;
-        iconH /= PANGO_SCALE;
-
-        int textW = 0, textH = 0;
-        pango_font_description_set_absolute_size(pangoFD, PANGO_SCALE * FONTSIZE);
-        pango_layout_set_font_description(layout, pangoFD);
-        pango_layout_set_text(layout, notif->text.c_str(), -1);
-        pango_layout_get_size(layout, &textW, &textH);
-        textW /= PANGO_SCALE;
-        textH /= PANGO_SCALE;
-
-        const auto NOTIFSIZE = Vector2D{textW + 20.0 + iconW + 2 * ICONPADFORNOTIF, textH + 10.0};
+        const auto ICON = ICONS_ARRAY[*m_iconBackend][notif->icon];
 
-        // draw rects
-        cairo_set_source_rgba(m_cairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
-        cairo_rectangle(m_cairo, MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, NOTIFSIZE.y);
-        cairo_fill(m_cairo);
+        const auto ICONTEXT = g_pHyprOpenGL->m_pTextEngine->shape(ICON, {.family = *fontFamily, .size = (int)(FONTSIZE * ICON_SCALE)});
+        const auto TEXT     = g_pHyprOpenGL->m_pTextEngine->shape(notif->text, {.family = *fontFamily, .size = FONTSIZE});
 
-        cairo_set_source_rgb(m_cairo, 0.f, 0.f, 0.f);
-        cairo_rectangle(m_cairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC, offsetY, NOTIFSIZE.x * SECONDRECTPERC, NOTIFSIZE.y);
-        cairo_fill(m_cairo);
+        const auto NOTIFSIZE = Vector2D{TEXT->size.x + 20.0 + ICONTEXT->size.x + 2 * ICONPADFORNOTIF, TEXT->size.y + 10.0};
 
-        cairo_set_source_rgba(m_cairo, notif->color.r, notif->color.g, notif->color.b, notif->color.a);
-        cairo_rectangle(m_cairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + 3, offsetY + NOTIFSIZE.y - 4, THIRDRECTPERC * (NOTIFSIZE.x - 6), 2);
-        cairo_fill(m_cairo);
+        // draw rects
+        addRect({MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, NOTIFSIZE.y}, notif->color);
+        addRect({MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC, offsetY, NOTIFSIZE.x * SECONDRECTPERC, NOTIFSIZE.y}, CHyprColor{0, 0, 0, 1});
+        addRect({MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + 3, offsetY + NOTIFSIZE.y - 4, THIRDRECTPERC * (NOTIFSIZE.x - 6), 2}, notif->color);
 
         // draw gradient
         if (notif->icon != ICON_NONE) {
-            cairo_pattern_t* pattern;
-            pattern = cairo_pattern_create_linear(MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY,
-                                                  MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC + GRADIENT_SIZE, offsetY);
-            cairo_pattern_add_color_stop_rgba(pattern, 0, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, ICONCOLOR.a / 3.0);
-            cairo_pattern_add_color_stop_rgba(pattern, 1, ICONCOLOR.r, ICONCOLOR.g, ICONCOLOR.b, 0);
-            cairo_rectangle(m_cairo, MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, GRADIENT_SIZE, NOTIFSIZE.y);
-            cairo_set_source(m_cairo, pattern);
-            cairo_fill(m_cairo);
-            cairo_pattern_destroy(pattern);
+            CTexPassElement::SRenderData data;
+            data.tex = iconGradient(notif->icon);
+            data.box = {MONSIZE.x - (NOTIFSIZE.x + NOTIF_LEFTBAR_SIZE) * FIRSTRECTPERC, offsetY, GRADIENT_SIZE, NOTIFSIZE.y};
+            g_pHyprRenderer->m_sRenderPass.add(makeShared<CTexPassElement>(data));
 
             // draw icon
-            cairo_set_source_rgb(m_cairo, 1.f, 1.f, 1.f);
-            cairo_move_to(m_cairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + ICONPADFORNOTIF - 1, offsetY - 2 + std::round((NOTIFSIZE.y - iconH) / 2.0));
-            pango_layout_set_text(layout, ICON.c_str(), -1);
-            pango_cairo_show_layout(m_cairo, layout);
+            addText(ICONTEXT,
+                    {std::round(MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + ICONPADFORNOTIF - 1), offsetY - 2 + std::round((NOTIFSIZE.y - ICONTEXT->size.y) / 2.0)},
+                    CHyprColor{1, 1, 1, 1});
         }
 
         // draw text
-        cairo_set_source_rgb(m_cairo, 1.f, 1.f, 1.f);
-        cairo_move_to(m_cairo, MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + iconW + 2 * ICONPADFORNOTIF, offsetY - 2 + std::round((NOTIFSIZE.y - textH) / 2.0));
-        pango_layout_set_text(layout, notif->text.c_str(), -1);
-        pango_cairo_show_layout(m_cairo, layout);
+        addText(TEXT,
+                {std::round(MONSIZE.x - NOTIFSIZE.x * SECONDRECTPERC + NOTIF_LEFTBAR_SIZE + ICONTEXT->size.x + 2 * ICONPADFORNOTIF),
+                 offsetY - 2 + std::round((NOTIFSIZE.y - TEXT->size.y) / 2.0)},
+                CHyprColor{1, 1, 1, 1});
 
         // adjust offset and move on
         offsetY += NOTIFSIZE.y + 10;
@@ -183,9 +209,6 @@ CBox CHyprNotificationOverlay::drawNotifications(PHLMONITOR pMonitor) {
             maxWidth = NOTIFSIZE.x;
     }
 
-    pango_font_description_free(pangoFD);
-    g_object_unref(layout);
-
     // cleanup notifs
     std::erase_if(m_notifications, [](const auto& notif) { return notif->started.getMillis() > notif->timeMs; });
 
@@ -193,36 +216,10 @@ CBox CHyprNotificationOverlay::drawNotifications(PHLMONITOR pMonitor) {
 }
 
 void CHyprNotificationOverlay::draw(PHLMONITOR pMonitor) {
-
-    const auto MONSIZE = pMonitor->vecTransformedSize;
-
-    if (m_lastMonitor != pMonitor || m_lastSize != MONSIZE || !m_cairo || !m_cairoSurface) {
-
-        if (m_cairo && m_cairoSurface) {
-            cairo_destroy(m_cairo);
-            cairo_surface_destroy(m_cairoSurface);
-        }
-
-        m_cairoSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, MONSIZE.x, MONSIZE.y);
-        m_cairo        = cairo_create(m_cairoSurface);
-        m_lastMonitor  = pMonitor;
-        m_lastSize     = MONSIZE;
-    }
-
     // Draw the notifications
     if (m_notifications.size() == 0)
         return;
 
-    // Render to the monitor
-
-    // clear the pixmap
-    cairo_save(m_cairo);
-    cairo_set_operator(m_cairo, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(m_cairo);
-    cairo_restore(m_cairo);
-
-    cairo_surface_flush(m_cairoSurface);
-
     CBox damage = drawNotifications(pMonitor);
 
     g_pHyprRenderer->damageBox(damage);
@@ -231,27 +228,6 @@ void CHyprNotificationOverlay::draw(PHLMONITOR pMonitor) {
     g_pCompositor->scheduleFrameForMonitor(pMonitor);
 
     m_lastDamage = damage;
-
-    // copy the data to an OpenGL texture we have
-    const auto DATA = cairo_image_surface_get_data(m_cairoSurface);
-    m_texture->allocate();
-    glBindTexture(GL_TEXTURE_2D, m_texture->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, MONSIZE.x, MONSIZE.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    CTexPassElement::SRenderData data;
-    data.tex = m_texture;
-    data.box = {0, 0, MONSIZE.x, MONSIZE.y};
-    data.a   = 1.F;
-
-    g_pHyprRenderer->m_sRenderPass.add(makeShared<CTexPassElement>(data));
 }
 
 bool CHyprNotificationOverlay::hasAny() {
@@ -5,6 +5,8 @@
 #include "../render/Texture.hpp"
 #include "../SharedDefs.hpp"
 
+#include <array>
+#include <optional>
 #include <vector>
 
 #include <cairo/cairo.h>
@@ -38,7 +40,6 @@ struct SNotification {
 class CHyprNotificationOverlay {
   public:
     CHyprNotificationOverlay();
-    ~CHyprNotificationOverlay();
 
     void draw(PHLMONITOR pMonitor);
     void addNotification(const std::string& text, const CHyprColor& color, const float timeMs, const eIcons icon = ICON_NONE, const float fontSize = 13.f);
@@ -46,18 +47,15 @@ class CHyprNotificationOverlay {
     bool hasAny();
 
   private:
-    CBox                           drawNotifications(PHLMONITOR pMonitor);
-    CBox                           m_lastDamage;
+    CBox                                    drawNotifications(PHLMONITOR pMonitor);
+    SP<CTexture>                            iconGradient(eIcons icon);
+    CBox                                    m_lastDamage;
 
-    std::vector<UP<SNotification>> m_notifications;
+    std::vector<UP<SNotification>>          m_notifications;
 
-    cairo_surface_t*               m_cairoSurface = nullptr;
-    cairo_t*                       m_cairo        = nullptr;
-
-    PHLMONITORREF                  m_lastMonitor;
-    Vector2D                       m_lastSize = Vector2D(-1, -1);
-
-    SP<CTexture>                   m_texture;
+    std::optional<eIconBackend>             m_iconBackend;
+    // fades from the icon color, the same for every notification with that icon
+    std::array<SP<CTexture>, ICON_NONE + 1> m_iconGradients;
 };
 
 inline UP<CHyprNotificationOverlay> g_pHyprNotificationOverlay;
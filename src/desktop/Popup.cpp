@@ -7,6 +7,7 @@
 #include "../managers/SeatManager.hpp"
 #include "../managers/eventLoop/EventLoopManager.hpp"
 #include "../desktop/LayerSurface.hpp"
+#include "../desktop/WindowHitIndex.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
@@ -76,6 +77,12 @@ void CPopup::initAllSignals() {
 void CPopup::onNewPopup(SP<CXDGPopupResource> popup) {
     const auto& POPUP = m_children.emplace_back(CPopup::create(popup, m_self));
     POPUP->m_self     = POPUP;
+
+    if (!m_windowOwner.expired()) {
+        g_pCompositor->m_windowHitIndex->invalidate(m_windowOwner.lock());
+        m_windowOwner->invalidateGeometry();
+    }
+
     Debug::log(LOG, "New popup at {:x}", (uintptr_t)POPUP);
 }
 
@@ -85,6 +92,11 @@ void CPopup::onDestroy() {
     if (!m_parent)
         return; // head node
 
+    if (!m_windowOwner.expired()) {
+        g_pCompositor->m_windowHitIndex->invalidate(m_windowOwner.lock());
+        m_windowOwner->invalidateGeometry();
+    }
+
     std::erase_if(m_parent->m_children, [this](const auto& other) { return other.get() == this; });
 }
 
@@ -95,6 +107,9 @@ void CPopup::onMap() {
     m_mapped   = true;
     m_lastSize = m_resource->surface->surface->current.size;
 
+    if (!m_windowOwner.expired())
+        m_windowOwner->invalidateGeometry();
+
     const auto COORDS   = coordsGlobal();
     const auto PMONITOR = g_pCompositor->getMonitorFromVector(COORDS);
 
@@ -130,6 +145,9 @@ void CPopup::onUnmap() {
 
     m_lastSize = m_resource->surface->surface->current.size;
 
+    if (!m_windowOwner.expired())
+        m_windowOwner->invalidateGeometry();
+
     const auto COORDS = coordsGlobal();
 
     CBox       box = m_wlSurface->resource()->extends();
@@ -172,6 +190,10 @@ void CPopup::onCommit(bool ignoreSiblings) {
     }
 
     if (!m_windowOwner.expired() && (!m_windowOwner->m_isMapped || !m_windowOwner->m_workspace->m_visible)) {
+        // the size compare below won't see this change once the workspace is visible again
+        if (m_lastSize != m_resource->surface->surface->current.size)
+            m_windowOwner->invalidateGeometry();
+
         m_lastSize = m_resource->surface->surface->current.size;
 
         static auto PLOGDAMAGE = CConfigValue<Hyprlang::INT>("debug:log_damage");
@@ -194,6 +216,9 @@ void CPopup::onCommit(bool ignoreSiblings) {
         g_pHyprRenderer->damageBox(box);
 
         m_lastPos = COORDSLOCAL;
+
+        if (!m_windowOwner.expired())
+            m_windowOwner->invalidateGeometry();
     }
 
     if (!ignoreSiblings && m_subsurfaceHead)
@@ -214,6 +239,9 @@ void CPopup::onReposition() {
 
     m_lastPos = coordsRelativeToParent();
 
+    if (!m_windowOwner.expired())
+        m_windowOwner->invalidateGeometry();
+
     reposition();
 }
 
@@ -375,3 +403,7 @@ WP<CPopup> CPopup::at(const Vector2D& globalCoords, bool allowsInput) {
 bool CPopup::inert() const {
     return m_inert;
 }
+
+bool CPopup::hasChildren() const {
+    return !m_children.empty();
+}
@@ -35,6 +35,7 @@ class CPopup {
 
     bool           visible();
     bool           inert() const;
+    bool           hasChildren() const;
 
     // will also loop over this node
     void       breadthfirst(std::function<void(WP<CPopup>, void*)> fn, void* data);
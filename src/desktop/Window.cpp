@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "Window.hpp"
 #include "../Compositor.hpp"
+#include "WindowHitIndex.hpp"
 #include "../render/decorations/CHyprDropShadowDecoration.hpp"
 #include "../render/decorations/CHyprGroupBarDecoration.hpp"
 #include "../render/decorations/CHyprBorderDecoration.hpp"
@@ -28,6 +29,7 @@
 #include "../managers/HookSystemManager.hpp"
 #include "../managers/EventManager.hpp"
 #include "../managers/input/InputManager.hpp"
+#include "../helpers/proc/ProcessTree.hpp"
 
 #include <hyprutils/string/String.hpp>
 
@@ -129,10 +131,72 @@ CWindow::~CWindow() {
     std::erase_if(g_pHyprOpenGL->m_mWindowFramebuffers, [&](const auto& other) { return other.first.expired() || other.first.get() == this; });
 }
 
+static CWindow::SGeometryCacheStats geometryStats;
+
+void CWindow::invalidateGeometry() {
+    if (!m_geometryCache.fullExtents && !m_geometryCache.decoReserved && !m_geometryCache.decoInput && !m_geometryCache.decoFull)
+        return;
+
+    geometryStats.invalidations++;
+
+    m_geometryCache.fullExtents.reset();
+    m_geometryCache.decoReserved.reset();
+    m_geometryCache.decoInput.reset();
+    m_geometryCache.decoFull.reset();
+}
+
+void CWindow::invalidateHyprctlSnapshot() {
+    m_hyprctlSnapshot.dirty = true;
+}
+
+CWindow::SGeometryCacheStats CWindow::geometryCacheStats() {
+    return geometryStats;
+}
+
+void CWindow::validateGeometryCache() {
+    geometryStats.reads++;
+
+    const auto PMONITOR    = m_monitor.lock();
+    const auto POSITION    = m_realPosition->value();
+    const auto SIZE        = m_realSize->value();
+    const auto SURFACESIZE = m_wlSurface && m_wlSurface->exists() ? m_wlSurface->resource()->current.size : Vector2D{};
+    const auto MONITORBOX  = PMONITOR ? CBox{PMONITOR->vecPosition, PMONITOR->vecSize} : CBox{};
+    const auto BORDERSIZE  = getRealBorderSize();
+    const auto DIMAROUND   = m_windowData.dimAround.valueOrDefault();
+
+    auto&      cache = m_geometryCache;
+
+    if (cache.position == POSITION && cache.size == SIZE && cache.surfaceSize == SURFACESIZE && cache.monitorBox == MONITORBOX && cache.borderSize == BORDERSIZE &&
+        cache.dimAround == DIMAROUND)
+        return;
+
+    invalidateGeometry();
+
+    cache.position    = POSITION;
+    cache.size        = SIZE;
+    cache.surfaceSize = SURFACESIZE;
+    cache.monitorBox  = MONITORBOX;
+    cache.borderSize  = BORDERSIZE;
+    cache.dimAround   = DIMAROUND;
+}
+
 SBoxExtents CWindow::getFullWindowExtents() {
     if (m_fadingOut)
         return m_originalClosedExtents;
 
+    validateGeometryCache();
+
+    if (m_geometryCache.fullExtents)
+        return *m_geometryCache.fullExtents;
+
+    geometryStats.recomputes++;
+
+    m_geometryCache.fullExtents = computeFullWindowExtents();
+
+    return *m_geometryCache.fullExtents;
+}
+
+SBoxExtents CWindow::computeFullWindowExtents() {
     const int BORDERSIZE = getRealBorderSize();
 
     if (m_windowData.dimAround.valueOrDefault()) {
@@ -143,7 +207,7 @@ SBoxExtents CWindow::getFullWindowExtents() {
 
     SBoxExtents maxExtents = {{BORDERSIZE + 2, BORDERSIZE + 2}, {BORDERSIZE + 2, BORDERSIZE + 2}};
 
-    const auto  EXTENTS = g_pDecorationPositioner->getWindowDecorationExtents(m_self.lock());
+    const auto  EXTENTS = decorationExtents(FULL_EXTENTS);
 
     if (EXTENTS.topLeft.x > maxExtents.topLeft.x)
         maxExtents.topLeft.x = EXTENTS.topLeft.x;
@@ -251,11 +315,11 @@ CBox CWindow::getWindowBoxUnified(uint64_t properties) {
 
     SBoxExtents EXTENTS = {{0, 0}, {0, 0}};
     if (properties & RESERVED_EXTENTS)
-        EXTENTS.addExtents(g_pDecorationPositioner->getWindowDecorationReserved(m_self.lock()));
+        EXTENTS.addExtents(decorationExtents(RESERVED_EXTENTS));
     if (properties & INPUT_EXTENTS)
-        EXTENTS.addExtents(g_pDecorationPositioner->getWindowDecorationExtents(m_self.lock(), true));
+        EXTENTS.addExtents(decorationExtents(INPUT_EXTENTS));
     if (properties & FULL_EXTENTS)
-        EXTENTS.addExtents(g_pDecorationPositioner->getWindowDecorationExtents(m_self.lock(), false));
+        EXTENTS.addExtents(decorationExtents(FULL_EXTENTS));
 
     CBox box = {m_realPosition->value().x, m_realPosition->value().y, m_realSize->value().x, m_realSize->value().y};
     box.addExtents(EXTENTS);
@@ -264,10 +328,29 @@ CBox CWindow::getWindowBoxUnified(uint64_t properties) {
 }
 
 SBoxExtents CWindow::getFullWindowReservedArea() {
-    return g_pDecorationPositioner->getWindowDecorationReserved(m_self.lock());
+    return decorationExtents(RESERVED_EXTENTS);
+}
+
+SBoxExtents CWindow::decorationExtents(eGetWindowProperties which) {
+    validateGeometryCache();
+
+    auto& cached = which == RESERVED_EXTENTS ? m_geometryCache.decoReserved : (which == INPUT_EXTENTS ? m_geometryCache.decoInput : m_geometryCache.decoFull);
+
+    if (cached)
+        return *cached;
+
+    geometryStats.recomputes++;
+
+    if (which == RESERVED_EXTENTS)
+        cached = g_pDecorationPositioner->getWindowDecorationReserved(m_self.lock());
+    else
+        cached = g_pDecorationPositioner->getWindowDecorationExtents(m_self.lock(), which == INPUT_EXTENTS);
+
+    return *cached;
 }
 
 void CWindow::updateWindowDecos() {
+    g_pCompositor->m_windowHitIndex->invalidate(m_self.lock());
 
     if (!m_isMapped || isHidden())
         return;
@@ -518,6 +601,14 @@ void CWindow::onUnmap() {
 
     std::erase_if(g_pCompositor->m_windowFocusHistory, [this](const auto& other) { return other.expired() || other == m_self; });
 
+    // the windows after it moved up in the focus history
+    for (auto const& w : g_pCompositor->m_windowFocusHistory) {
+        if (const auto PWINDOW = w.lock())
+            PWINDOW->invalidateHyprctlSnapshot();
+    }
+
+    invalidateHyprctlSnapshot();
+
     if (*PCLOSEONLASTSPECIAL && m_workspace && m_workspace->getWindows() == 0 && onSpecialWorkspace()) {
         const auto PMONITOR = m_monitor.lock();
         if (PMONITOR && PMONITOR->activeSpecialWorkspace && PMONITOR->activeSpecialWorkspace == m_workspace)
@@ -579,6 +670,8 @@ void CWindow::onMap() {
 
     g_pCompositor->m_windowFocusHistory.push_back(m_self);
 
+    invalidateHyprctlSnapshot();
+
     m_reportedSize = m_pendingReportedSize;
     m_animatingIn  = true;
 
@@ -803,6 +896,9 @@ void CWindow::applyDynamicRule(const SP<CWindowRule>& r) {
 }
 
 void CWindow::updateDynamicRules() {
+    // rules can set and drop tags
+    invalidateHyprctlSnapshot();
+
     m_windowData.alpha.unset(PRIORITY_WINDOW_RULE);
     m_windowData.alphaInactive.unset(PRIORITY_WINDOW_RULE);
     m_windowData.alphaFullscreen.unset(PRIORITY_WINDOW_RULE);
@@ -1483,6 +1579,12 @@ void CWindow::onUpdateMeta() {
     }
 
     if (doUpdate) {
+        invalidateHyprctlSnapshot();
+
+        // the workspace reports its last window's title
+        if (m_workspace)
+            m_workspace->m_hyprctlSnapshot.dirty = true;
+
         updateDynamicRules();
         g_pCompositor->updateWindowAnimatedDecorationValues(m_self.lock());
         updateToplevel();
@@ -1600,10 +1702,30 @@ void CWindow::warpCursor(bool force) {
         g_pCompositor->warpCursorTo(middle(), force);
 }
 
+struct SSwallowRegex {
+    std::string  source;
+    UP<re2::RE2> regex;
+};
+
+// compiled again only once the config value changes
+static const re2::RE2& swallowRegex(SSwallowRegex& compiled, const std::string& source) {
+    if (!compiled.regex || compiled.source != source) {
+        compiled.source = source;
+        compiled.regex  = makeUnique<re2::RE2>(source);
+
+        if (!compiled.regex->ok())
+            Debug::log(ERR, "getSwallower: regex {} failed to parse", source);
+    }
+
+    return *compiled.regex;
+}
+
 PHLWINDOW CWindow::getSwallower() {
-    static auto PSWALLOWREGEX   = CConfigValue<std::string>("misc:swallow_regex");
-    static auto PSWALLOWEXREGEX = CConfigValue<std::string>("misc:swallow_exception_regex");
-    static auto PSWALLOW        = CConfigValue<Hyprlang::INT>("misc:enable_swallow");
+    static auto          PSWALLOWREGEX   = CConfigValue<std::string>("misc:swallow_regex");
+    static auto          PSWALLOWEXREGEX = CConfigValue<std::string>("misc:swallow_exception_regex");
+    static auto          PSWALLOW        = CConfigValue<Hyprlang::INT>("misc:enable_swallow");
+
+    static SSwallowRegex swallowCompiled, exceptionCompiled;
 
     if (!*PSWALLOW || std::string{*PSWALLOWREGEX} == STRVAL_EMPTY || (*PSWALLOWREGEX).empty())
         return nullptr;
@@ -1613,28 +1735,30 @@ PHLWINDOW CWindow::getSwallower() {
     pid_t                  currentPid = getPID();
     // walk up the tree until we find someone, 25 iterations max.
     for (size_t i = 0; i < 25; ++i) {
-        currentPid = getPPIDof(currentPid);
+        currentPid = NProcessTree::parentOf(currentPid);
 
         if (!currentPid)
             break;
 
-        for (auto const& w : g_pCompositor->m_windows) {
-            if (!w->m_isMapped || w->isHidden())
-                continue;
-
-            if (w->getPID() == currentPid)
+        for (auto const& w : g_pCompositor->getMappedWindowsByPID(currentPid)) {
+            if (!w->isHidden())
                 candidates.push_back(w);
         }
     }
 
-    if (!(*PSWALLOWREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return !RE2::FullMatch(other->m_class, *PSWALLOWREGEX); });
+    if (candidates.empty())
+        return nullptr;
+
+    const auto& SWALLOWREGEX = swallowRegex(swallowCompiled, *PSWALLOWREGEX);
+    std::erase_if(candidates, [&](const auto& other) { return !RE2::FullMatch(other->m_class, SWALLOWREGEX); });
 
     if (candidates.size() == 0)
         return nullptr;
 
-    if (!(*PSWALLOWEXREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return RE2::FullMatch(other->m_title, *PSWALLOWEXREGEX); });
+    if (!(*PSWALLOWEXREGEX).empty()) {
+        const auto& EXCEPTIONREGEX = swallowRegex(exceptionCompiled, *PSWALLOWEXREGEX);
+        std::erase_if(candidates, [&](const auto& other) { return RE2::FullMatch(other->m_title, EXCEPTIONREGEX); });
+    }
 
     if (candidates.size() == 0)
         return nullptr;
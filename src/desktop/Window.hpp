@@ -5,6 +5,7 @@
 #include <optional>
 
 #include "../config/ConfigDataValues.hpp"
+#include "../debug/HyprCtlSnapshot.hpp"
 #include "../helpers/AnimatedVariable.hpp"
 #include "../helpers/math/Math.hpp"
 #include "../helpers/signal/Signal.hpp"
@@ -311,6 +312,16 @@ class CWindow {
     // ANR
     PHLANIMVAR<float> m_notRespondingTint;
 
+    // cached hyprctl output
+    SHyprCtlSnapshot<SHyprCtlWindowState> m_hyprctlSnapshot;
+
+    // what CCompositor::m_mappedWindowsByPID has this window under, while mapped
+    std::optional<pid_t> m_indexedPID;
+
+    struct SGeometryCacheStats {
+        uint64_t reads = 0, recomputes = 0, invalidations = 0;
+    };
+
     // For the list lookup
     bool operator==(const CWindow& rhs) const {
         return m_xdgSurface == rhs.m_xdgSurface && m_xwaylandSurface == rhs.m_xwaylandSurface && m_position == rhs.m_position && m_size == rhs.m_size &&
@@ -406,6 +417,11 @@ class CWindow {
     bool                       isNotResponding();
     std::optional<std::string> xdgTag();
     std::optional<std::string> xdgDescription();
+    // drops the cached extents, for changes the cache can't see: decorations repositioned, popups mapped, moved or resized
+    void                       invalidateGeometry();
+    // rebuilds the hyprctl snapshot on the next request, for changes it doesn't compare on read: meta, tags, focus history
+    void                       invalidateHyprctlSnapshot();
+    static SGeometryCacheStats geometryCacheStats();
 
     CBox                       getWindowMainSurfaceBox() const {
         return {m_realPosition->value().x, m_realPosition->value().y, m_realSize->value().x, m_realSize->value().y};
@@ -440,6 +456,25 @@ class CWindow {
     bool        m_hidden        = false;
     bool        m_suspended     = false;
     WORKSPACEID m_lastWorkspace = WORKSPACE_INVALID;
+
+    /*
+        getFullWindowExtents and the decoration extents behind getWindowBoxUnified, computed on first use.
+        The cheap inputs (animated position and size, border size, dimaround, surface size, monitor) are
+        compared on every read and drop the cache when they changed. The rest invalidates explicitly.
+    */
+    struct {
+        Vector2D                   position, size, surfaceSize;
+        CBox                       monitorBox;
+        int                        borderSize = -1;
+        bool                       dimAround  = false;
+
+        std::optional<SBoxExtents> fullExtents;
+        std::optional<SBoxExtents> decoReserved, decoInput, decoFull;
+    } m_geometryCache;
+
+    void        validateGeometryCache();
+    SBoxExtents computeFullWindowExtents();
+    SBoxExtents decorationExtents(eGetWindowProperties which);
 };
 
 inline bool valid(PHLWINDOW w) {
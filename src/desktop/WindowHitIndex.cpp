@@ -0,0 +1,200 @@
+#include "WindowHitIndex.hpp"
+#include "Window.hpp"
+#include "../Compositor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// in layout coordinates
+constexpr double CELL_SIZE = 256;
+// windows spanning more cells than this are cheaper to always check
+constexpr size_t MAX_CELLS_PER_WINDOW = 256;
+
+static uint64_t cellKey(int64_t x, int64_t y) {
+    return ((uint64_t)(uint32_t)(int32_t)x << 32) | (uint32_t)(int32_t)y;
+}
+
+static uint64_t cellAt(const Vector2D& pos) {
+    return cellKey(std::floor(pos.x / CELL_SIZE), std::floor(pos.y / CELL_SIZE));
+}
+
+void CWindowHitIndex::invalidate(PHLWINDOW pWindow) {
+    if (!pWindow || m_allDirty)
+        return;
+
+    // the address may belong to a dead window that was queued, that one is skipped when the queue is drained
+    auto& entry = m_entries[pWindow.get()];
+    if (entry.dirty && entry.window.lock() == pWindow)
+        return;
+
+    // nothing is querying, animations alone would grow the queue forever
+    if (m_dirty.size() >= g_pCompositor->m_windows.size()) {
+        invalidateAll();
+        return;
+    }
+
+    entry.window = pWindow;
+    entry.dirty  = true;
+    m_dirty.emplace_back(pWindow);
+}
+
+void CWindowHitIndex::invalidateAll() {
+    m_allDirty = true;
+    m_dirty.clear();
+}
+
+void CWindowHitIndex::removeFromCells(CWindow* pWindow, SEntry& entry) {
+    for (auto const& c : entry.cells) {
+        auto it = m_cells.find(c);
+        if (it == m_cells.end())
+            continue;
+
+        std::erase(it->second, pWindow);
+        if (it->second.empty())
+            m_cells.erase(it);
+    }
+
+    entry.cells.clear();
+
+    if (entry.everywhere)
+        std::erase(m_everywhere, pWindow);
+
+    entry.everywhere = false;
+}
+
+void CWindowHitIndex::update(CWindow* pWindow, SEntry& entry) {
+    removeFromCells(pWindow, entry);
+
+    const auto PWINDOW = entry.window.lock();
+
+    if (!PWINDOW || !PWINDOW->m_isMapped)
+        return;
+
+    // dimaround windows take the whole monitor, popups can be anywhere
+    if (PWINDOW->m_windowData.dimAround.valueOrDefault() || (!PWINDOW->m_isX11 && PWINDOW->m_popupHead && PWINDOW->m_popupHead->hasChildren())) {
+        entry.everywhere = true;
+        m_everywhere.emplace_back(pWindow);
+        return;
+    }
+
+    // everything getWindowBoxUnified can add to the real box
+    CBox realBox = PWINDOW->getWindowBoxUnified(RESERVED_EXTENTS | INPUT_EXTENTS | FULL_EXTENTS);
+    realBox.expand(m_borderGrabArea);
+
+    const CBox LAYOUTBOX = {PWINDOW->m_position, PWINDOW->m_size};
+
+    const auto MIN = Vector2D{std::min(realBox.x, LAYOUTBOX.x), std::min(realBox.y, LAYOUTBOX.y)};
+    const auto MAX = Vector2D{std::max(realBox.x + realBox.w, LAYOUTBOX.x + LAYOUTBOX.w), std::max(realBox.y + realBox.h, LAYOUTBOX.y + LAYOUTBOX.h)};
+
+    const int64_t X1 = std::floor(MIN.x / CELL_SIZE), Y1 = std::floor(MIN.y / CELL_SIZE);
+    const int64_t X2 = std::floor(MAX.x / CELL_SIZE), Y2 = std::floor(MAX.y / CELL_SIZE);
+
+    if ((size_t)((X2 - X1 + 1) * (Y2 - Y1 + 1)) > MAX_CELLS_PER_WINDOW) {
+        entry.everywhere = true;
+        m_everywhere.emplace_back(pWindow);
+        return;
+    }
+
+    for (int64_t x = X1; x <= X2; ++x) {
+        for (int64_t y = Y1; y <= Y2; ++y) {
+            const auto KEY = cellKey(x, y);
+            entry.cells.emplace_back(KEY);
+            m_cells[KEY].emplace_back(pWindow);
+        }
+    }
+}
+
+void CWindowHitIndex::refreshZHints() {
+    for (size_t i = 0; i < g_pCompositor->m_windows.size(); ++i) {
+        if (auto it = m_entries.find(g_pCompositor->m_windows[i].get()); it != m_entries.end())
+            it->second.zHint = i;
+    }
+}
+
+std::vector<PHLWINDOW> CWindowHitIndex::candidatesAt(const std::vector<Vector2D>& points, int borderGrabArea) {
+    if (borderGrabArea != m_borderGrabArea) {
+        m_borderGrabArea = borderGrabArea;
+        invalidateAll();
+    }
+
+    // entries of windows that died without being queried pile up, start over once in a while
+    if (m_entries.size() > g_pCompositor->m_windows.size() * 2 + 64)
+        invalidateAll();
+
+    if (m_allDirty) {
+        m_entries.clear();
+        m_cells.clear();
+        m_everywhere.clear();
+
+        for (size_t i = 0; i < g_pCompositor->m_windows.size(); ++i) {
+            const auto& w     = g_pCompositor->m_windows[i];
+            auto&       entry = m_entries[w.get()];
+            entry.window      = w;
+            entry.zHint       = i;
+            update(w.get(), entry);
+        }
+
+        m_allDirty = false;
+    } else if (!m_dirty.empty()) {
+        for (auto const& ref : m_dirty) {
+            const auto PWINDOW = ref.lock();
+            if (!PWINDOW)
+                continue;
+
+            auto& entry  = m_entries[PWINDOW.get()];
+            entry.window = PWINDOW;
+            entry.dirty  = false;
+            update(PWINDOW.get(), entry);
+        }
+
+        m_dirty.clear();
+    }
+
+    std::vector<CWindow*> found = m_everywhere;
+    for (auto const& p : points) {
+        if (auto it = m_cells.find(cellAt(p)); it != m_cells.end())
+            found.insert(found.end(), it->second.begin(), it->second.end());
+    }
+
+    std::vector<std::pair<size_t, PHLWINDOW>> result;
+    result.reserve(found.size());
+
+    bool refreshed = false;
+    for (auto const& pw : found) {
+        auto it = m_entries.find(pw);
+        if (it == m_entries.end())
+            continue;
+
+        auto&      entry   = it->second;
+        const auto PWINDOW = entry.window.lock();
+
+        if (!PWINDOW) {
+            removeFromCells(pw, entry);
+            m_entries.erase(it);
+            continue;
+        }
+
+        // z-order moved since, re-learn it for everyone
+        if (entry.zHint >= g_pCompositor->m_windows.size() || g_pCompositor->m_windows[entry.zHint] != PWINDOW) {
+            if (!refreshed)
+                refreshZHints();
+            refreshed = true;
+
+            if (entry.zHint >= g_pCompositor->m_windows.size() || g_pCompositor->m_windows[entry.zHint] != PWINDOW)
+                continue; // not in m_windows anymore
+        }
+
+        result.emplace_back(entry.zHint, PWINDOW);
+    }
+
+    std::ranges::sort(result, {}, &std::pair<size_t, PHLWINDOW>::first);
+    result.erase(std::unique(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), result.end());
+
+    std::vector<PHLWINDOW> windows;
+    windows.reserve(result.size());
+    for (auto& [_, w] : result) {
+        windows.emplace_back(std::move(w));
+    }
+
+    return windows;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "DesktopTypes.hpp"
+#include "../helpers/math/Math.hpp"
+
+/*
+    Uniform grid over the area each window can be hit in, for CCompositor::vectorToWindowUnified.
+
+    A window's area is a superset of every box the hit-test may check for it: its real box with all of
+    its decoration extents and the border grab area, and its layout box. Windows with popups or with
+    dimaround can be hit anywhere and are always candidates. Visibility, workspace and focus checks
+    are left to the hit-test, so workspace switches don't touch the grid.
+
+    Entries are refreshed lazily: anything that can move a window's area (damage, decoration updates,
+    popups coming and going) marks the window dirty, and dirty windows are re-gridded on the next query.
+    A window is queued once however often it's marked, and a queue longer than m_windows becomes a rebuild.
+*/
+class CWindowHitIndex {
+  public:
+    // the window's hit area may have changed
+    void                   invalidate(PHLWINDOW pWindow);
+    void                   invalidateAll();
+
+    // windows that may be hit at any of the points, bottom to top, as in m_windows
+    std::vector<PHLWINDOW> candidatesAt(const std::vector<Vector2D>& points, int borderGrabArea);
+
+  private:
+    struct SEntry {
+        PHLWINDOWREF          window;
+        std::vector<uint64_t> cells;
+        bool                  everywhere = false;
+        bool                  dirty      = false; // queued in m_dirty
+        size_t                zHint      = 0;     // index in m_windows, checked before use
+    };
+
+    void                                                update(CWindow* pWindow, SEntry& entry);
+    void                                                removeFromCells(CWindow* pWindow, SEntry& entry);
+    void                                                refreshZHints();
+
+    std::unordered_map<CWindow*, SEntry>                m_entries;
+    std::unordered_map<uint64_t, std::vector<CWindow*>> m_cells;
+    std::vector<CWindow*>                               m_everywhere;
+    std::vector<PHLWINDOWREF>                           m_dirty;
+
+    bool                                                m_allDirty       = true;
+    int                                                 m_borderGrabArea = -1;
+};
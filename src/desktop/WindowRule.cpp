@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <re2/re2.h>
 #include "../config/ConfigManager.hpp"
+#include <hyprutils/string/String.hpp>
+using namespace Hyprutils::String;
 
 static const auto RULES = std::unordered_set<std::string>{
     "float", "fullscreen", "maximize", "noinitialfocus", "pin", "stayfocused", "tile", "renderunfocused", "persistentsize",
@@ -94,3 +96,42 @@ CWindowRule::CWindowRule(const std::string& rule, const std::string& value, bool
         }
     }
 }
+
+void CWindowRule::compile() {
+    m_compiled = {};
+
+    if (!m_fullscreenState.empty()) {
+        const auto ARGS = CVarList(m_fullscreenState, 2, ' ');
+
+        if (ARGS[0] != "*" && !isNumber(ARGS[0])) {
+            Debug::log(ERR, "CWindowRule: fullscreenstate internal mode not valid in {}", m_value);
+            m_compiled.valid = false;
+        } else if (ARGS[0] != "*")
+            m_compiled.fullscreenInternal = (eFullscreenMode)std::stoi(ARGS[0]);
+
+        if (ARGS[1] != "*" && !isNumber(ARGS[1])) {
+            Debug::log(ERR, "CWindowRule: fullscreenstate client mode not valid in {}", m_value);
+            m_compiled.valid = false;
+        } else if (ARGS[1] != "*")
+            m_compiled.fullscreenClient = (eFullscreenMode)std::stoi(ARGS[1]);
+    }
+
+    if (!m_workspace.empty()) {
+        if (m_workspace.starts_with("name:"))
+            m_compiled.workspaceName = m_workspace.substr(5);
+        else if (isNumber(m_workspace)) {
+            try {
+                m_compiled.workspaceID = std::stoll(m_workspace);
+            } catch (std::exception& e) { m_compiled.valid = false; }
+        } else {
+            Debug::log(ERR, "CWindowRule: workspace not name: or number in {}", m_value);
+            m_compiled.valid = false;
+        }
+    }
+
+    if (!m_contentType.empty()) {
+        try {
+            m_compiled.contentType = NContentType::fromString(m_contentType);
+        } catch (std::exception& e) { Debug::log(ERR, "Rule \"content:{}\" failed with: {}", m_contentType, e.what()); }
+    }
+}
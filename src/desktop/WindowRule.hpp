@@ -2,7 +2,11 @@
 
 #include <string>
 #include <cstdint>
+#include <optional>
 #include "Rule.hpp"
+#include "../protocols/types/ContentType.hpp"
+
+enum eFullscreenMode : int8_t;
 
 class CWindowRule {
   public:
@@ -69,4 +73,16 @@ class CWindowRule {
     CRuleRegexContainer m_initialTitleRegex;
     CRuleRegexContainer m_initialClassRegex;
     CRuleRegexContainer m_v1Regex;
+
+    // typed forms of the string selectors above, so matching doesn't need to parse them again
+    struct {
+        bool                                      valid = true; // false if a selector is malformed, the rule never matches then
+        std::optional<eFullscreenMode>            fullscreenInternal, fullscreenClient;
+        std::optional<int64_t>                    workspaceID;
+        std::optional<std::string>                workspaceName;
+        std::optional<NContentType::eContentType> contentType;
+    } m_compiled;
+
+    // call after the selectors have been set
+    void compile();
 };
\ No newline at end of file
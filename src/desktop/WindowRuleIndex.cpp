@@ -0,0 +1,188 @@
+#include "WindowRuleIndex.hpp"
+#include "WindowRule.hpp"
+#include "Window.hpp"
+#include "../debug/Log.hpp"
+#include "../helpers/varlist/VarList.hpp"
+
+#include <algorithm>
+
+static bool isLiteralRegex(const std::string& regex) {
+    return !regex.empty() && !regex.starts_with("negative:") && regex.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+static std::string stripTag(std::string tag) {
+    if (tag.starts_with("+") || tag.starts_with("-"))
+        tag = tag.substr(1);
+    if (tag.ends_with("*"))
+        tag.pop_back();
+    return tag;
+}
+
+static const std::string& fieldOf(const SP<CWindowRule>& rule, CWindowRuleIndex::eField field) {
+    switch (field) {
+        case CWindowRuleIndex::FIELD_CLASS: return rule->m_class;
+        case CWindowRuleIndex::FIELD_TITLE: return rule->m_title;
+        case CWindowRuleIndex::FIELD_INITIAL_CLASS: return rule->m_initialClass;
+        case CWindowRuleIndex::FIELD_INITIAL_TITLE: return rule->m_initialTitle;
+        default: break;
+    }
+
+    return rule->m_class;
+}
+
+static const CRuleRegexContainer& regexOf(const SP<CWindowRule>& rule, CWindowRuleIndex::eField field) {
+    switch (field) {
+        case CWindowRuleIndex::FIELD_CLASS: return rule->m_classRegex;
+        case CWindowRuleIndex::FIELD_TITLE: return rule->m_titleRegex;
+        case CWindowRuleIndex::FIELD_INITIAL_CLASS: return rule->m_initialClassRegex;
+        case CWindowRuleIndex::FIELD_INITIAL_TITLE: return rule->m_initialTitleRegex;
+        default: break;
+    }
+
+    return rule->m_classRegex;
+}
+
+CWindowRuleIndex::CWindowRuleIndex(const std::vector<SP<CWindowRule>>& rules) : m_rules(rules) {
+    // tags that rules can apply while being matched can't be used to rule anything out upfront
+    std::unordered_set<std::string> settableTags;
+    for (auto const& rule : m_rules) {
+        if (rule->m_rule == "float")
+            m_anyFloatRule = true;
+
+        if (rule->m_ruleType != CWindowRule::RULE_TAG)
+            continue;
+
+        CVarList vars{rule->m_rule, 0, 's', true};
+        if (vars.size() == 2 && vars[0] == "tag")
+            settableTags.emplace(stripTag(vars[1]));
+    }
+
+    for (size_t i = 0; i < m_rules.size(); ++i) {
+        const auto& RULE = m_rules[i];
+
+        if (!RULE->m_v2) {
+            m_unindexed.emplace_back(i);
+            continue;
+        }
+
+        // malformed selectors never match
+        if (!RULE->m_compiled.valid)
+            continue;
+
+        if (isLiteralRegex(RULE->m_class))
+            m_byClass[RULE->m_class].emplace_back(i);
+        else if (RULE->m_X11 != -1)
+            m_byX11[RULE->m_X11].emplace_back(i);
+        else if (!RULE->m_tag.empty() && !settableTags.contains(stripTag(RULE->m_tag)))
+            m_byTag[RULE->m_tag].emplace_back(i);
+        else if (RULE->m_floating != -1)
+            m_byFloating[RULE->m_floating].emplace_back(i);
+        else
+            m_unindexed.emplace_back(i);
+    }
+
+    for (size_t f = 0; f < FIELD_COUNT; ++f) {
+        auto& set = m_sets[f];
+        set.inSet.resize(m_rules.size(), false);
+        set.negative.resize(m_rules.size(), false);
+        set.set = makeUnique<re2::RE2::Set>(re2::RE2::Options{}, re2::RE2::ANCHOR_BOTH);
+
+        for (size_t i = 0; i < m_rules.size(); ++i) {
+            const auto& REGEX = fieldOf(m_rules[i], (eField)f);
+
+            if (!m_rules[i]->m_v2 || REGEX.empty())
+                continue;
+
+            const bool  NEGATIVE = REGEX.starts_with("negative:");
+            std::string err;
+            const auto  IDX = set.set->Add(NEGATIVE ? REGEX.substr(9) : REGEX, &err);
+
+            // invalid ones keep going through their own container, which handles them as before
+            if (IDX < 0)
+                continue;
+
+            set.ruleForPattern.emplace_back(i);
+            set.inSet[i]    = true;
+            set.negative[i] = NEGATIVE;
+        }
+
+        if (set.ruleForPattern.empty() || !set.set->Compile()) {
+            if (!set.ruleForPattern.empty())
+                Debug::log(ERR, "CWindowRuleIndex: couldn't compile a regex set, falling back to per-rule matching");
+
+            set.set.reset();
+            set.ruleForPattern.clear();
+            std::ranges::fill(set.inSet, false);
+        }
+    }
+
+    Debug::log(LOG, "CWindowRuleIndex: indexed {} rules ({} by class, {} unindexed)", m_rules.size(), m_byClass.size(), m_unindexed.size());
+}
+
+std::vector<size_t> CWindowRuleIndex::candidatesFor(PHLWINDOW pWindow, bool dynamic) const {
+    std::vector<size_t> result = m_unindexed;
+
+    const auto          add = [&result](const std::vector<size_t>& v) { result.insert(result.end(), v.begin(), v.end()); };
+
+    if (const auto IT = m_byClass.find(pWindow->m_class); IT != m_byClass.end())
+        add(IT->second);
+
+    add(m_byX11[pWindow->m_isX11 ? 1 : 0]);
+
+    for (auto const& tag : pWindow->m_tags.getTags()) {
+        if (const auto IT = m_byTag.find(tag); IT != m_byTag.end())
+            add(IT->second);
+
+        // dynamic tags are stored as "tag*", and match rules for "tag"
+        if (tag.ends_with("*")) {
+            if (const auto IT = m_byTag.find(tag.substr(0, tag.length() - 1)); IT != m_byTag.end())
+                add(IT->second);
+        }
+    }
+
+    add(m_byFloating[pWindow->m_isFloating ? 1 : 0]);
+
+    // a float rule matching on the initial pass makes floating:1 rules eligible later in the same pass
+    if (!dynamic && m_anyFloatRule && !pWindow->m_isFloating)
+        add(m_byFloating[1]);
+
+    std::ranges::sort(result);
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+bool CWindowRuleIndex::passes(size_t idx, eField field, const std::string& value, SWindowMatch& match) const {
+    const auto& SET = m_sets[field];
+
+    if (!SET.inSet[idx])
+        return regexOf(m_rules[idx], field).passes(value);
+
+    if (!match.evaluated[field]) {
+        match.passes[field].assign(m_rules.size(), false);
+
+        std::vector<int>         hits;
+        re2::RE2::Set::ErrorInfo error;
+
+        // the set's DFA can run out of memory on large rule lists, leaving hits empty. Fall back to the rules' own regexes
+        if (!SET.set->Match(value, &hits, &error)) {
+            if (!SET.loggedFailure) {
+                Debug::log(ERR, "CWindowRuleIndex: RE2::Set match failed for field {} (error {}), falling back to per-rule regexes", (int)field, (int)error.kind);
+                SET.loggedFailure = true;
+            }
+
+            match.failed[field] = true;
+        }
+
+        for (auto const& h : hits) {
+            match.passes[field][SET.ruleForPattern[h]] = true;
+        }
+
+        match.evaluated[field] = true;
+    }
+
+    if (match.failed[field])
+        return regexOf(m_rules[idx], field).passes(value);
+
+    return match.passes[field][idx] != SET.negative[idx];
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <re2/set.h>
+#include "DesktopTypes.hpp"
+#include "../helpers/memory/Memory.hpp"
+
+class CWindowRule;
+
+/*
+    Prefilter for window rule matching, built once per rule list.
+
+    Every v2 rule is bucketed by its cheapest discriminating selector (a literal class, xwayland,
+    a tag no rule can set, floating). Candidates for a window are the rules from its buckets plus
+    the unindexed ones, in rule order. Class / title / initialClass / initialTitle regexes are
+    compiled into one RE2::Set per field, so a window's field is matched against all rules at once.
+*/
+class CWindowRuleIndex {
+  public:
+    CWindowRuleIndex(const std::vector<SP<CWindowRule>>& rules);
+
+    enum eField : uint8_t {
+        FIELD_CLASS = 0,
+        FIELD_TITLE,
+        FIELD_INITIAL_CLASS,
+        FIELD_INITIAL_TITLE,
+        FIELD_COUNT,
+    };
+
+    // regex results of one window, filled lazily one field at a time
+    struct SWindowMatch {
+        std::array<std::vector<bool>, FIELD_COUNT> passes;
+        std::array<bool, FIELD_COUNT>              evaluated = {};
+        std::array<bool, FIELD_COUNT>              failed    = {};
+    };
+
+    // indices of the rules that can match pWindow, in rule order
+    std::vector<size_t> candidatesFor(PHLWINDOW pWindow, bool dynamic) const;
+
+    // whether rule `idx`'s regex for `field` passes on `value`
+    bool passes(size_t idx, eField field, const std::string& value, SWindowMatch& match) const;
+
+  private:
+    struct SFieldSet {
+        UP<re2::RE2::Set>   set;
+        std::vector<size_t> ruleForPattern;
+        std::vector<bool>   inSet, negative;
+        mutable bool        loggedFailure = false;
+    };
+
+    std::vector<SP<CWindowRule>>                          m_rules;
+
+    std::vector<size_t>                                   m_unindexed;
+    std::unordered_map<std::string, std::vector<size_t>> m_byClass, m_byTag;
+    std::array<std::vector<size_t>, 2>                   m_byX11, m_byFloating;
+    bool                                                  m_anyFloatRule = false;
+
+    std::array<SFieldSet, FIELD_COUNT>                    m_sets;
+};
@@ -0,0 +1,170 @@
+#include "WindowSelector.hpp"
+#include "Window.hpp"
+#include "../Compositor.hpp"
+#include "../managers/LayoutManager.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <list>
+#include <unordered_map>
+#include <re2/re2.h>
+#include <hyprutils/string/String.hpp>
+using namespace Hyprutils::String;
+
+// scripts tend to reuse a handful of selectors, addresses make up most of the churn
+constexpr size_t MAX_SELECTORS = 64;
+
+struct SCachedSelector {
+    std::string         text;
+    SP<CWindowSelector> selector;
+};
+
+static struct {
+    std::list<SCachedSelector>                                            entries; // most recently used first
+    std::unordered_map<std::string, std::list<SCachedSelector>::iterator> index;
+} cache;
+
+CWindowSelector::CWindowSelector(const std::string& selector) {
+    // without a prefix the class regex is empty, so only windows without a class match. That's how it always was
+    std::string regex;
+
+    if (selector.starts_with("active"))
+        m_kind = SELECTOR_ACTIVE;
+    else if (selector.starts_with("floating"))
+        m_kind = SELECTOR_FLOATING;
+    else if (selector.starts_with("tiled"))
+        m_kind = SELECTOR_TILED;
+    else if (selector.starts_with("class:"))
+        regex = selector.substr(6);
+    else if (selector.starts_with("initialclass:")) {
+        m_kind = SELECTOR_INITIAL_CLASS;
+        regex  = selector.substr(13);
+    } else if (selector.starts_with("title:")) {
+        m_kind = SELECTOR_TITLE;
+        regex  = selector.substr(6);
+    } else if (selector.starts_with("initialtitle:")) {
+        m_kind = SELECTOR_INITIAL_TITLE;
+        regex  = selector.substr(13);
+    } else if (selector.starts_with("tag:")) {
+        m_kind = SELECTOR_TAG;
+        regex  = selector.substr(4);
+    } else if (selector.starts_with("address:")) {
+        m_kind = SELECTOR_ADDRESS;
+
+        // only the exact form hyprctl prints, like the string compare this replaces
+        const auto TEXT    = selector.substr(8);
+        uintptr_t  address = 0;
+
+        if (TEXT.starts_with("0x")) {
+            const auto [END, EC] = std::from_chars(TEXT.data() + 2, TEXT.data() + TEXT.size(), address, 16);
+            if (EC == std::errc{} && END == TEXT.data() + TEXT.size() && std::format("0x{:x}", address) == TEXT)
+                m_address = address;
+        }
+    } else if (selector.starts_with("pid:")) {
+        m_kind = SELECTOR_PID;
+
+        const auto TEXT = selector.substr(4);
+        pid_t      pid  = 0;
+
+        const auto [END, EC] = std::from_chars(TEXT.data(), TEXT.data() + TEXT.size(), pid);
+        if (EC == std::errc{} && END == TEXT.data() + TEXT.size() && std::format("{}", pid) == TEXT)
+            m_pid = pid;
+    }
+
+    if (m_kind < SELECTOR_CLASS || m_kind > SELECTOR_TAG)
+        return;
+
+    m_regex = makeUnique<re2::RE2>(regex);
+
+    if (!m_regex->ok())
+        Debug::log(ERR, "CWindowSelector: regex {} failed to parse, nothing will match it", regex);
+}
+
+CWindowSelector::~CWindowSelector() = default;
+
+SP<CWindowSelector> CWindowSelector::get(const std::string& selector_) {
+    const auto SELECTOR = trim(selector_);
+
+    if (const auto IT = cache.index.find(SELECTOR); IT != cache.index.end()) {
+        cache.entries.splice(cache.entries.begin(), cache.entries, IT->second);
+        return IT->second->selector;
+    }
+
+    auto selector = makeShared<CWindowSelector>(SELECTOR);
+
+    cache.entries.emplace_front(SCachedSelector{.text = SELECTOR, .selector = selector});
+    cache.index[SELECTOR] = cache.entries.begin();
+
+    while (cache.entries.size() > MAX_SELECTORS) {
+        cache.index.erase(cache.entries.back().text);
+        cache.entries.pop_back();
+    }
+
+    return selector;
+}
+
+bool CWindowSelector::matches(const PHLWINDOW& w) const {
+    switch (m_kind) {
+        case SELECTOR_CLASS: return RE2::FullMatch(w->m_class, *m_regex);
+        case SELECTOR_INITIAL_CLASS: return RE2::FullMatch(w->m_initialClass, *m_regex);
+        case SELECTOR_TITLE: return RE2::FullMatch(w->m_title, *m_regex);
+        case SELECTOR_INITIAL_TITLE: return RE2::FullMatch(w->m_initialTitle, *m_regex);
+        case SELECTOR_TAG: return std::ranges::any_of(w->m_tags.getTags(), [this](const auto& tag) { return RE2::FullMatch(tag, *m_regex); });
+        default: break;
+    }
+
+    return false;
+}
+
+PHLWINDOW CWindowSelector::find() const {
+    const auto SELECTABLE = [](const PHLWINDOW& w) { return w->m_isMapped && (!w->isHidden() || g_pLayoutManager->getCurrentLayout()->isWindowReachable(w)); };
+
+    switch (m_kind) {
+        case SELECTOR_ACTIVE: return g_pCompositor->m_lastWindow.lock();
+        case SELECTOR_FLOATING:
+        case SELECTOR_TILED: {
+            // first floating or tiled one on the current ws
+            const auto PLASTWINDOW = g_pCompositor->m_lastWindow.lock();
+            if (!valid(PLASTWINDOW))
+                return nullptr;
+
+            const bool FLOAT = m_kind == SELECTOR_FLOATING;
+
+            for (auto const& w : g_pCompositor->m_windows) {
+                if (!w->m_isMapped || w->m_isFloating != FLOAT || w->m_workspace != PLASTWINDOW->m_workspace || w->isHidden())
+                    continue;
+
+                return w;
+            }
+
+            return nullptr;
+        }
+        case SELECTOR_ADDRESS: {
+            if (!m_address)
+                return nullptr;
+
+            const auto PWINDOW = g_pCompositor->m_windowsByAddress.get(*m_address);
+            return PWINDOW && SELECTABLE(PWINDOW) ? PWINDOW : nullptr;
+        }
+        case SELECTOR_PID: {
+            if (!m_pid)
+                return nullptr;
+
+            for (auto const& w : g_pCompositor->getMappedWindowsByPID(*m_pid)) {
+                if (SELECTABLE(w))
+                    return w;
+            }
+
+            return nullptr;
+        }
+        default: break;
+    }
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        if (SELECTABLE(w) && matches(w))
+            return w;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <sys/types.h>
+#include "DesktopTypes.hpp"
+
+//NOLINTNEXTLINE
+namespace re2 {
+    class RE2;
+};
+
+/*
+    A window selector as dispatchers take them: active, floating, tiled, class:, initialclass:, title:,
+    initialtitle:, tag:, address: or pid:. Text without a prefix is an empty class: regex, not a class regex.
+
+    Selectors are parsed once, with their regex compiled and their address or pid as a number, and kept
+    in a small LRU by their text, so a batch of dispatches doesn't compile the same regex for every call.
+    address: and pid: resolve through the compositor's indices instead of a scan over every window.
+*/
+class CWindowSelector {
+  public:
+    CWindowSelector(const std::string& selector);
+    ~CWindowSelector();
+
+    // the compiled selector for the text, from the cache if it's there
+    static SP<CWindowSelector> get(const std::string& selector);
+
+    // the first mapped, reachable window it selects, in m_windows order
+    PHLWINDOW find() const;
+
+  private:
+    enum eKind : uint8_t {
+        SELECTOR_ACTIVE = 0,
+        SELECTOR_FLOATING,
+        SELECTOR_TILED,
+        SELECTOR_CLASS,
+        SELECTOR_INITIAL_CLASS,
+        SELECTOR_TITLE,
+        SELECTOR_INITIAL_TITLE,
+        SELECTOR_TAG,
+        SELECTOR_ADDRESS,
+        SELECTOR_PID,
+    };
+
+    bool                     matches(const PHLWINDOW& w) const;
+
+    eKind                    m_kind = SELECTOR_CLASS;
+    UP<re2::RE2>             m_regex;
+    std::optional<uintptr_t> m_address; // empty if the text isn't one a window could have, nothing matches then
+    std::optional<pid_t>     m_pid;
+};
@@ -646,7 +646,16 @@ void CWorkspace::rename(const std::string& name) {
         return;
 
     Debug::log(LOG, "CWorkspace::rename: Renaming workspace {} to '{}'", m_id, name);
+    g_pCompositor->unindexWorkspace(m_self.lock());
     m_name = name;
+    g_pCompositor->indexWorkspace(m_self.lock());
+
+    // hyprctl reports the name with the workspace and with each of its windows
+    m_hyprctlSnapshot.dirty = true;
+    for (auto const& w : g_pCompositor->m_windows) {
+        if (w->m_workspace.get() == this)
+            w->invalidateHyprctlSnapshot();
+    }
 
     const auto WORKSPACERULE = g_pConfigManager->getWorkspaceRuleFor(m_self.lock());
     m_persistent             = WORKSPACERULE.isPersistent;
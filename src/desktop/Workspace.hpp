@@ -5,6 +5,7 @@
 #include "../defines.hpp"
 #include "DesktopTypes.hpp"
 #include "../helpers/MiscFunctions.hpp"
+#include "../debug/HyprCtlSnapshot.hpp"
 
 enum eFullscreenMode : int8_t {
     FSMODE_NONE       = 0,
@@ -58,6 +59,9 @@ class CWorkspace {
 
     bool        m_persistent = false;
 
+    // cached hyprctl output
+    SHyprCtlSnapshot<SHyprCtlWorkspaceState> m_hyprctlSnapshot;
+
     // Inert: destroyed and invalid. If this is true, release the ptr you have.
     bool             inert();
     void             startAnim(bool in, bool left, bool instant = false);
@@ -1,6 +1,7 @@
 #include "Events.hpp"
 
 #include "../Compositor.hpp"
+#include "../desktop/WindowHitIndex.hpp"
 #include "../helpers/WLClasses.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../managers/TokenManager.hpp"
@@ -70,6 +71,8 @@ void Events::listener_mapWindow(void* owner, void* data) {
     PWINDOW->m_fadingOut     = false;
     PWINDOW->m_title         = PWINDOW->fetchTitle();
     PWINDOW->m_firstMap      = true;
+    g_pCompositor->m_windowHitIndex->invalidate(PWINDOW);
+    g_pCompositor->indexMappedWindow(PWINDOW);
     PWINDOW->m_initialTitle  = PWINDOW->m_title;
     PWINDOW->m_initialClass  = PWINDOW->fetchClass();
 
@@ -773,6 +776,7 @@ void Events::listener_unmapWindow(void* owner, void* data) {
 
     // do this after onWindowRemoved because otherwise it'll think the window is invalid
     PWINDOW->m_isMapped = false;
+    g_pCompositor->unindexMappedWindow(PWINDOW);
 
     // refocus on a new window if needed
     if (wasLastWindow) {
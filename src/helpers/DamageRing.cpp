@@ -1,4 +1,8 @@
 #include "DamageRing.hpp"
+#include "math/RegionSimplify.hpp"
+#include "../config/ConfigValue.hpp"
+
+#include <algorithm>
 
 void CDamageRing::setSize(const Vector2D& size_) {
     if (size_ == size)
@@ -30,6 +34,8 @@ void CDamageRing::rotate() {
 }
 
 CRegion CDamageRing::getBufferDamage(int age) {
+    static auto PRECTCOST = CConfigValue<Hyprlang::INT>("render:damage_rect_cost");
+
     if (age <= 0 || age > DAMAGE_RING_PREVIOUS_LEN + 1)
         return CBox{{}, size};
 
@@ -40,11 +46,7 @@ CRegion CDamageRing::getBufferDamage(int age) {
         damage.add(previous.at(j));
     }
 
-    // don't return a ludicrous amount of rects
-    if (damage.getRects().size() > 8)
-        return damage.getExtents();
-
-    return damage;
+    return NRegionSimplify::simplify(damage, std::max<Hyprlang::INT>(*PRECTCOST, 0));
 }
 
 bool CDamageRing::hasChanged() {
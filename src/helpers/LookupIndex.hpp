@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "../macros.hpp"
+
+/*
+    Hash index over a vector of SP<T> owned elsewhere, for getters that would otherwise scan it.
+
+    Whoever adds an element to the vector, or changes its key, add()s it. Entries are checked
+    against matches() on lookup, so elements that went away or whose key changed are never returned,
+    and a stale entry falls back to a scan of the vector. With several elements under one key,
+    lookups return one of them.
+*/
+template <typename K, typename T>
+class CLookupIndex {
+  public:
+    using FMatches = std::function<bool(const SP<T>&, const K&)>;
+
+    CLookupIndex(const std::vector<SP<T>>& vec, FMatches matches) : m_vec(vec), m_matches(std::move(matches)) {
+        ;
+    }
+
+    void add(const K& key, const SP<T>& value) {
+        auto& ref = m_map[key];
+
+        // keep the current one if it's still good
+        if (const auto PCURRENT = ref.lock(); PCURRENT && m_matches(PCURRENT, key))
+            return;
+
+        ref = value;
+    }
+
+    void remove(const K& key, const SP<T>& value) {
+        auto it = m_map.find(key);
+        if (it == m_map.end() || it->second.lock() != value)
+            return;
+
+        m_map.erase(it);
+
+        // another element may share the key
+        for (auto const& v : m_vec) {
+            if (v != value && m_matches(v, key)) {
+                m_map[key] = v;
+                break;
+            }
+        }
+    }
+
+    SP<T> get(const K& key) {
+        SP<T> result = lookup(key);
+
+#if ISDEBUG
+        if (!result && std::ranges::any_of(m_vec, [this, &key](const auto& v) { return m_matches(v, key); }))
+            Debug::log(ERR, "CLookupIndex: missed an element, something added to the vector without indexing it");
+#endif
+
+        return result;
+    }
+
+  private:
+    SP<T> lookup(const K& key) {
+        auto it = m_map.find(key);
+        if (it == m_map.end())
+            return nullptr;
+
+        if (const auto PVALUE = it->second.lock(); PVALUE && m_matches(PVALUE, key))
+            return PVALUE;
+
+        // went away or changed its key
+        for (auto const& v : m_vec) {
+            if (m_matches(v, key)) {
+                it->second = v;
+                return v;
+            }
+        }
+
+        m_map.erase(it);
+        return nullptr;
+    }
+
+    const std::vector<SP<T>>&    m_vec;
+    FMatches                     m_matches;
+    std::unordered_map<K, WP<T>> m_map;
+};
@@ -187,8 +187,10 @@ void CMonitor::onConnect(bool noRule) {
 
     RASSERT(thisWrapper->get(), "CMonitor::onConnect: Had no wrapper???");
 
-    if (std::find_if(g_pCompositor->m_monitors.begin(), g_pCompositor->m_monitors.end(), [&](auto& other) { return other.get() == this; }) == g_pCompositor->m_monitors.end())
+    if (std::find_if(g_pCompositor->m_monitors.begin(), g_pCompositor->m_monitors.end(), [&](auto& other) { return other.get() == this; }) == g_pCompositor->m_monitors.end()) {
         g_pCompositor->m_monitors.push_back(*thisWrapper);
+        g_pCompositor->indexMonitor(*thisWrapper);
+    }
 
     m_bEnabled = true;
 
@@ -404,6 +406,7 @@ void CMonitor::onDisconnect(bool destroy) {
 
         g_pHyprRenderer->m_pMostHzMonitor = pMonitorMostHz;
     }
+    g_pCompositor->unindexMonitor(self.lock());
     std::erase_if(g_pCompositor->m_monitors, [&](PHLMONITOR& el) { return el.get() == this; });
 }
 
@@ -971,6 +974,7 @@ void CMonitor::setupDefaultWS(const SMonitorRule& monitorRule) {
             newDefaultWorkspaceName = std::to_string(wsID);
 
         PNEWWORKSPACE = g_pCompositor->m_workspaces.emplace_back(CWorkspace::create(wsID, self.lock(), newDefaultWorkspaceName));
+        g_pCompositor->indexWorkspace(PNEWWORKSPACE);
     }
 
     activeWorkspace = PNEWWORKSPACE;
@@ -1029,6 +1033,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
 
         if (std::find_if(g_pCompositor->m_monitors.begin(), g_pCompositor->m_monitors.end(), [&](auto& other) { return other.get() == this; }) == g_pCompositor->m_monitors.end()) {
             g_pCompositor->m_monitors.push_back(*thisWrapper);
+            g_pCompositor->indexMonitor(*thisWrapper);
         }
 
         setupDefaultWS(RULE);
@@ -1064,6 +1069,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
         pMirrorOf->mirrors.push_back(self);
 
         // remove from mvmonitors
+        g_pCompositor->unindexMonitor(self.lock());
         std::erase_if(g_pCompositor->m_monitors, [&](const auto& other) { return other == self; });
 
         g_pCompositor->arrangeMonitors();
@@ -15,6 +15,7 @@
 #include "../protocols/types/ColorManagement.hpp"
 #include "signal/Signal.hpp"
 #include "DamageRing.hpp"
+#include "../debug/HyprCtlSnapshot.hpp"
 #include <aquamarine/output/Output.hpp>
 #include <aquamarine/allocator/Swapchain.hpp>
 #include <hyprutils/os/FileDescriptor.hpp>
@@ -215,6 +216,9 @@ class CMonitor {
     WP<CWindow>                         m_previousFSWindow;
     NColorManagement::SImageDescription imageDescription;
 
+    // cached hyprctl output
+    SHyprCtlSnapshot<SHyprCtlMonitorState> hyprctlSnapshot;
+
     // For the list lookup
 
     bool operator==(const CMonitor& rhs) {
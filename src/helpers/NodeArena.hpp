@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "../macros.hpp"
+#include "memory/Memory.hpp"
+
+/*
+    Storage for nodes that point at each other with raw pointers, like the dwindle tree.
+
+    Nodes live in chunks of contiguous slots and never move, so pointers stay good until the node is
+    destroyed. Destroyed slots go on a free list and are handed out again before a new chunk is made.
+*/
+template <typename T, size_t CHUNKSIZE = 64>
+class CNodeArena {
+  public:
+    // a default constructed T
+    T* create() {
+        if (m_free.empty())
+            grow();
+
+        T* node = m_free.back();
+        m_free.pop_back();
+        m_alive++;
+
+        return node;
+    }
+
+    void destroy(T* node) {
+        RASSERT(m_alive > 0, "CNodeArena: destroying a node that was never created");
+
+        // drop whatever it held on to
+        *node = T{};
+        m_free.emplace_back(node);
+        m_alive--;
+    }
+
+    // invalidates every node
+    void clear() {
+        m_chunks.clear();
+        m_free.clear();
+        m_alive = 0;
+    }
+
+    size_t size() const {
+        return m_alive;
+    }
+
+  private:
+    void grow() {
+        auto& chunk = m_chunks.emplace_back(makeUnique<std::array<T, CHUNKSIZE>>());
+
+        // reversed, so a fresh chunk is handed out front to back
+        for (auto it = chunk->rbegin(); it != chunk->rend(); ++it) {
+            m_free.emplace_back(&*it);
+        }
+    }
+
+    std::vector<UP<std::array<T, CHUNKSIZE>>> m_chunks;
+    std::vector<T*>                           m_free;
+    size_t                                    m_alive = 0;
+};
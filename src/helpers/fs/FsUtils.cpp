@@ -8,49 +8,58 @@
 #include <hyprutils/string/VarList.hpp>
 using namespace Hyprutils::String;
 
-std::optional<std::string> NFsUtils::getDataHome() {
-    const auto  DATA_HOME = getenv("XDG_DATA_HOME");
+// $<xdgVar>/hyprland/, or ~/<homeFallback>/hyprland/, created if missing
+static std::optional<std::string> getHyprlandDir(const char* xdgVar, const char* homeFallback, const char* caller, const char* what) {
+    const auto  XDG_HOME = getenv(xdgVar);
 
-    std::string dataRoot;
+    std::string root;
 
-    if (!DATA_HOME) {
+    if (!XDG_HOME) {
         const auto HOME = getenv("HOME");
 
         if (!HOME) {
-            Debug::log(ERR, "FsUtils::getDataHome: can't get data home: no $HOME or $XDG_DATA_HOME");
+            Debug::log(ERR, "FsUtils::{}: can't get {}: no $HOME or ${}", caller, what, xdgVar);
             return std::nullopt;
         }
 
-        dataRoot = HOME + std::string{"/.local/share/"};
+        root = HOME + std::string{homeFallback};
     } else
-        dataRoot = DATA_HOME + std::string{"/"};
+        root = XDG_HOME + std::string{"/"};
 
     std::error_code ec;
-    if (!std::filesystem::exists(dataRoot, ec) || ec) {
-        Debug::log(ERR, "FsUtils::getDataHome: can't get data home: inaccessible / missing");
+    if (!std::filesystem::exists(root, ec) || ec) {
+        Debug::log(ERR, "FsUtils::{}: can't get {}: inaccessible / missing", caller, what);
         return std::nullopt;
     }
 
-    dataRoot += "hyprland/";
+    root += "hyprland/";
 
-    if (!std::filesystem::exists(dataRoot, ec) || ec) {
-        Debug::log(LOG, "FsUtils::getDataHome: no hyprland data home, creating.");
-        std::filesystem::create_directory(dataRoot, ec);
+    if (!std::filesystem::exists(root, ec) || ec) {
+        Debug::log(LOG, "FsUtils::{}: no hyprland {}, creating.", caller, what);
+        std::filesystem::create_directory(root, ec);
         if (ec) {
-            Debug::log(ERR, "FsUtils::getDataHome: can't create new data home for hyprland");
+            Debug::log(ERR, "FsUtils::{}: can't create new {} for hyprland", caller, what);
             return std::nullopt;
         }
-        std::filesystem::permissions(dataRoot, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write | std::filesystem::perms::owner_exec, ec);
+        std::filesystem::permissions(root, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write | std::filesystem::perms::owner_exec, ec);
         if (ec)
-            Debug::log(WARN, "FsUtils::getDataHome: couldn't set perms on hyprland data store. Proceeding anyways.");
+            Debug::log(WARN, "FsUtils::{}: couldn't set perms on hyprland {}. Proceeding anyways.", caller, what);
     }
 
-    if (!std::filesystem::exists(dataRoot, ec) || ec) {
-        Debug::log(ERR, "FsUtils::getDataHome: no hyprland data home, failed to create.");
+    if (!std::filesystem::exists(root, ec) || ec) {
+        Debug::log(ERR, "FsUtils::{}: no hyprland {}, failed to create.", caller, what);
         return std::nullopt;
     }
 
-    return dataRoot;
+    return root;
+}
+
+std::optional<std::string> NFsUtils::getDataHome() {
+    return getHyprlandDir("XDG_DATA_HOME", "/.local/share/", "getDataHome", "data home");
+}
+
+std::optional<std::string> NFsUtils::getCacheHome() {
+    return getHyprlandDir("XDG_CACHE_HOME", "/.cache/", "getCacheHome", "cache home");
 }
 
 std::optional<std::string> NFsUtils::readFileAsString(const std::string& path) {
@@ -5,6 +5,8 @@
 namespace NFsUtils {
     // Returns the path to the hyprland directory in data home.
     std::optional<std::string> getDataHome();
+    // Returns the path to the hyprland directory in cache home.
+    std::optional<std::string> getCacheHome();
 
     std::optional<std::string> readFileAsString(const std::string& path);
 
@@ -0,0 +1,125 @@
+#include "RegionSimplify.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// pair search is quadratic, past this many rects neighbours get merged blindly first
+constexpr size_t MAX_SEARCH_RECTS = 64;
+
+static NRegionSimplify::SStats simplifyStats;
+
+static uint64_t area(const pixman_box32_t& b) {
+    return (uint64_t)(b.x2 - b.x1) * (b.y2 - b.y1);
+}
+
+static pixman_box32_t bounds(const pixman_box32_t& a, const pixman_box32_t& b) {
+    return {std::min(a.x1, b.x1), std::min(a.y1, b.y1), std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+}
+
+static bool intersects(const pixman_box32_t& a, const pixman_box32_t& b) {
+    return a.x1 < b.x2 && b.x1 < a.x2 && a.y1 < b.y2 && b.y1 < a.y2;
+}
+
+static uint64_t areaOf(const std::vector<pixman_box32_t>& rects) {
+    uint64_t total = 0;
+    for (auto const& r : rects) {
+        total += area(r);
+    }
+    return total;
+}
+
+CRegion NRegionSimplify::simplify(const CRegion& region, uint64_t rectCost) {
+    const auto RECTS = region.getRects();
+
+    simplifyStats.calls++;
+    simplifyStats.rectsIn += RECTS.size();
+
+    if (RECTS.size() <= 1) {
+        simplifyStats.rectsOut += RECTS.size();
+        return region.copy();
+    }
+
+    std::vector<pixman_box32_t> boxes = RECTS;
+
+    // rects come sorted by band, so neighbours are close
+    while (boxes.size() > MAX_SEARCH_RECTS) {
+        std::vector<pixman_box32_t> halved;
+        halved.reserve(boxes.size() / 2 + 1);
+
+        for (size_t i = 0; i < boxes.size(); i += 2) {
+            halved.emplace_back(i + 1 < boxes.size() ? bounds(boxes[i], boxes[i + 1]) : boxes[i]);
+        }
+
+        boxes = std::move(halved);
+    }
+
+    while (boxes.size() > 1) {
+        size_t   bestA = 0, bestB = 0;
+        uint64_t bestWaste = UINT64_MAX;
+
+        for (size_t a = 0; a < boxes.size(); ++a) {
+            for (size_t b = a + 1; b < boxes.size(); ++b) {
+                const auto     BOUNDS = bounds(boxes[a], boxes[b]);
+                const uint64_t USED   = area(boxes[a]) + area(boxes[b]);
+                const uint64_t WASTE  = area(BOUNDS) > USED ? area(BOUNDS) - USED : 0;
+
+                if (WASTE < bestWaste) {
+                    bestWaste = WASTE;
+                    bestA     = a;
+                    bestB     = b;
+                }
+            }
+        }
+
+        if (bestWaste >= rectCost)
+            break;
+
+        auto merged = bounds(boxes[bestA], boxes[bestB]);
+        boxes.erase(boxes.begin() + bestB);
+        boxes.erase(boxes.begin() + bestA);
+
+        // swallow whatever the merged box now overlaps, so it doesn't get drawn twice
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (auto it = boxes.begin(); it != boxes.end();) {
+                if (!intersects(merged, *it)) {
+                    ++it;
+                    continue;
+                }
+
+                merged = bounds(merged, *it);
+                it     = boxes.erase(it);
+                grew   = true;
+            }
+        }
+
+        boxes.emplace_back(merged);
+    }
+
+    CRegion result;
+    for (auto const& b : boxes) {
+        result.add(CBox{(double)b.x1, (double)b.y1, (double)(b.x2 - b.x1), (double)(b.y2 - b.y1)});
+    }
+
+    // the region re-bands the boxes, which can split them up again. Keep whichever is cheaper.
+    const auto     RESULTRECTS = result.getRects();
+    const uint64_t PIXELSIN    = areaOf(RECTS);
+    const uint64_t PIXELSOUT   = areaOf(RESULTRECTS);
+
+    if (RESULTRECTS.size() * rectCost + PIXELSOUT >= RECTS.size() * rectCost + PIXELSIN) {
+        simplifyStats.rectsOut += RECTS.size();
+        return region.copy();
+    }
+
+    const auto EXTENTS = result.getExtents();
+
+    simplifyStats.rectsOut += RESULTRECTS.size();
+    simplifyStats.pixelsAdded += PIXELSOUT - PIXELSIN;
+    simplifyStats.pixelsSaved += (uint64_t)(EXTENTS.w * EXTENTS.h) - PIXELSOUT;
+
+    return result;
+}
+
+const NRegionSimplify::SStats& NRegionSimplify::stats() {
+    return simplifyStats;
+}
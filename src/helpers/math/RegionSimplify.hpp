@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include "Math.hpp"
+
+/*
+    Trades extra pixels for fewer rects: every rect in a damage region costs a draw (or an upload),
+    every pixel costs fill (or bandwidth). simplify() greedily merges the pairs of rects that waste
+    the fewest pixels, as long as that's cheaper than the rect it saves.
+*/
+namespace NRegionSimplify {
+    struct SStats {
+        uint64_t calls       = 0;
+        uint64_t rectsIn     = 0;
+        uint64_t rectsOut    = 0;
+        uint64_t pixelsAdded = 0;
+        // compared to collapsing to the extents
+        uint64_t pixelsSaved = 0;
+    };
+
+    // rectCost is the price of one rect, in pixels
+    CRegion       simplify(const CRegion& region, uint64_t rectCost);
+
+    const SStats& stats();
+};
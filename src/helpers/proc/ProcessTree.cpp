@@ -0,0 +1,100 @@
+#include "ProcessTree.hpp"
+#include "../MiscFunctions.hpp"
+#include "../../Compositor.hpp"
+
+#include <unordered_map>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace Hyprutils::OS;
+
+struct SCachedProcess {
+    int64_t          ppid = 0;
+    CFileDescriptor  pidfd;
+    wl_event_source* source = nullptr;
+};
+
+// pids whose parent we know
+static std::unordered_map<int64_t, SCachedProcess> cache;
+
+// we hold a pidfd per entry, don't grow without bounds
+constexpr size_t MAX_CACHED_PROCESSES = 1024;
+
+static void evict(std::unordered_map<int64_t, SCachedProcess>::iterator it) {
+    if (it->second.source)
+        wl_event_source_remove(it->second.source);
+
+    cache.erase(it);
+}
+
+static int onProcessExited(int fd, uint32_t mask, void* data) {
+    // pidfds become readable when the process exits, and hang up once it's reaped. Either way it's gone.
+    const auto PID = (int64_t)(intptr_t)data;
+
+    if (const auto IT = cache.find(PID); IT != cache.end())
+        evict(IT);
+
+    // children get reparented when their parent exits
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (it->second.ppid != PID) {
+            ++it;
+            continue;
+        }
+
+        if (it->second.source)
+            wl_event_source_remove(it->second.source);
+
+        it = cache.erase(it);
+    }
+
+    return 0;
+}
+
+int64_t NProcessTree::parentOf(int64_t pid) {
+    if (pid <= 0)
+        return 0;
+
+    if (const auto IT = cache.find(pid); IT != cache.end())
+        return IT->second.ppid;
+
+    if (cache.size() >= MAX_CACHED_PROCESSES || !g_pCompositor || !g_pCompositor->m_wlEventLoop)
+        return getPPIDof(pid);
+
+#if defined(SYS_pidfd_open) && defined(SYS_pidfd_send_signal)
+    // pin the process before reading its parent. If it's still alive after the read, the pid wasn't reused in between
+    // and the parent we read is its own.
+    CFileDescriptor pidfd{(int)syscall(SYS_pidfd_open, (pid_t)pid, 0)};
+    const auto      PPID = getPPIDof(pid);
+
+    // 0 means the process is gone (or we can't read it), nothing worth remembering
+    if (!pidfd.isValid() || PPID == 0 || syscall(SYS_pidfd_send_signal, pidfd.get(), 0, nullptr, 0) != 0)
+        return PPID;
+
+    auto& entry  = cache[pid];
+    entry.ppid   = PPID;
+    entry.pidfd  = std::move(pidfd);
+    entry.source = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, entry.pidfd.get(), WL_EVENT_READABLE, onProcessExited, (void*)(intptr_t)pid);
+
+    if (!entry.source)
+        cache.erase(pid);
+
+    return PPID;
+#else
+    return getPPIDof(pid);
+#endif
+}
+
+std::vector<int64_t> NProcessTree::ancestryOf(int64_t pid) {
+    std::vector<int64_t> result = {pid};
+
+    // 25 levels is more than any real process tree, but protects against loops from pid reuse
+    for (size_t i = 0; i < 25; ++i) {
+        const auto PPID = parentOf(result.back());
+        if (PPID <= 10)
+            break;
+
+        result.push_back(PPID);
+    }
+
+    return result;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace NProcessTree {
+    // Cached getPPIDof. Entries are dropped when the process (or its parent) exits, which is watched
+    // with a pidfd. Where pidfds aren't available, this always asks the kernel.
+    int64_t              parentOf(int64_t pid);
+
+    // pid followed by its ancestors, stopping before the first one with a pid <= 10
+    std::vector<int64_t> ancestryOf(int64_t pid);
+};
@@ -143,13 +143,13 @@ void CHyprError::createQueued() {
     // copy the data to an OpenGL texture we have
     const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
     m_pTexture->allocate();
-    glBindTexture(GL_TEXTURE_2D, m_pTexture->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_pTexture->m_iTexID);
+    m_pTexture->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    m_pTexture->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
 #ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    m_pTexture->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    m_pTexture->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
 #endif
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
@@ -8,6 +8,8 @@
 #include "../managers/LayoutManager.hpp"
 #include "../managers/EventManager.hpp"
 
+#include <algorithm>
+
 void SDwindleNodeData::recalcSizePosRecursive(bool force, bool horizontalOverride, bool verticalOverride) {
     if (children[0]) {
         static auto PSMARTSPLIT    = CConfigValue<Hyprlang::INT>("dwindle:smart_split");
@@ -43,31 +45,73 @@ void SDwindleNodeData::recalcSizePosRecursive(bool force, bool horizontalOverrid
     }
 }
 
-int CHyprDwindleLayout::getNodesOnWorkspace(const WORKSPACEID& id) {
-    int no = 0;
-    for (auto const& n : m_lDwindleNodesData) {
-        if (n.workspaceID == id && n.valid)
-            ++no;
+SDwindleNodeData* CHyprDwindleLayout::createNode(const WORKSPACEID& id) {
+    const auto PNODE   = m_nodes.create();
+    PNODE->workspaceID = id;
+    PNODE->layout      = this;
+
+    m_workspaceNodes[id].emplace_back(PNODE);
+
+    return PNODE;
+}
+
+void CHyprDwindleLayout::destroyNode(SDwindleNodeData* pNode) {
+    if (const auto IT = m_workspaceNodes.find(pNode->workspaceID); IT != m_workspaceNodes.end()) {
+        std::erase(IT->second, pNode);
+        if (IT->second.empty())
+            m_workspaceNodes.erase(IT);
     }
-    return no;
+
+    setNodeWindow(pNode, nullptr);
+
+    m_nodes.destroy(pNode);
+}
+
+void CHyprDwindleLayout::setNodeWindow(SDwindleNodeData* pNode, PHLWINDOW pWindow) {
+    if (const auto PCURRENT = pNode->pWindow.lock(); PCURRENT) {
+        if (const auto IT = m_windowNodes.find(PCURRENT.get()); IT != m_windowNodes.end() && IT->second == pNode)
+            m_windowNodes.erase(IT);
+    } else if (!pNode->isNode)
+        std::erase_if(m_windowNodes, [pNode](const auto& other) { return other.second == pNode; });
+
+    pNode->pWindow = pWindow;
+
+    if (pWindow)
+        m_windowNodes[pWindow.get()] = pNode;
+}
+
+int CHyprDwindleLayout::getNodesOnWorkspace(const WORKSPACEID& id) {
+    const auto IT = m_workspaceNodes.find(id);
+    if (IT == m_workspaceNodes.end())
+        return 0;
+
+    return std::ranges::count_if(IT->second, [](const auto& n) { return n->valid; });
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getFirstNodeOnWorkspace(const WORKSPACEID& id) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.workspaceID == id && validMapped(n.pWindow))
-            return &n;
+    const auto IT = m_workspaceNodes.find(id);
+    if (IT == m_workspaceNodes.end())
+        return nullptr;
+
+    for (auto const& n : IT->second) {
+        if (validMapped(n->pWindow))
+            return n;
     }
     return nullptr;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getClosestNodeOnWorkspace(const WORKSPACEID& id, const Vector2D& point) {
+    const auto IT = m_workspaceNodes.find(id);
+    if (IT == m_workspaceNodes.end())
+        return nullptr;
+
     SDwindleNodeData* res         = nullptr;
     double            distClosest = -1;
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.workspaceID == id && validMapped(n.pWindow)) {
-            auto distAnother = vecToRectDistanceSquared(point, n.box.pos(), n.box.pos() + n.box.size());
+    for (auto const& n : IT->second) {
+        if (validMapped(n->pWindow)) {
+            auto distAnother = vecToRectDistanceSquared(point, n->box.pos(), n->box.pos() + n->box.size());
             if (!res || distAnother < distClosest) {
-                res         = &n;
+                res         = n;
                 distClosest = distAnother;
             }
         }
@@ -76,20 +120,28 @@ SDwindleNodeData* CHyprDwindleLayout::getClosestNodeOnWorkspace(const WORKSPACEI
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getNodeFromWindow(PHLWINDOW pWindow) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (n.pWindow.lock() == pWindow && !n.isNode)
-            return &n;
-    }
+    if (!pWindow)
+        return nullptr;
 
-    return nullptr;
+    const auto IT = m_windowNodes.find(pWindow.get());
+    if (IT == m_windowNodes.end() || IT->second->isNode || IT->second->pWindow.lock() != pWindow)
+        return nullptr;
+
+    return IT->second;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getMasterNodeOnWorkspace(const WORKSPACEID& id) {
-    for (auto& n : m_lDwindleNodesData) {
-        if (!n.pParent && n.workspaceID == id)
-            return &n;
+    const auto IT = m_workspaceNodes.find(id);
+    if (IT == m_workspaceNodes.end())
+        return nullptr;
+
+    // every node on the workspace hangs off the same root
+    auto PNODE = IT->second.front();
+    while (PNODE->pParent) {
+        PNODE = PNODE->pParent;
     }
-    return nullptr;
+
+    return PNODE;
 }
 
 void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool force) {
@@ -223,8 +275,7 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
     if (pWindow->m_isFloating)
         return;
 
-    m_lDwindleNodesData.emplace_back();
-    const auto  PNODE = &m_lDwindleNodesData.back();
+    const auto  PNODE = createNode(pWindow->workspaceID());
 
     const auto  PMONITOR = pWindow->m_monitor.lock();
 
@@ -235,10 +286,8 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
         overrideDirection = direction;
 
     // Populate the node with our window's data
-    PNODE->workspaceID = pWindow->workspaceID();
-    PNODE->pWindow     = pWindow;
-    PNODE->isNode      = false;
-    PNODE->layout      = this;
+    PNODE->isNode = false;
+    setNodeWindow(PNODE, pWindow);
 
     SDwindleNodeData* OPENINGON;
 
@@ -278,16 +327,16 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
     if (const auto MAXSIZE = pWindow->requestedMaxSize(); MAXSIZE.x < PREDSIZEMAX.x || MAXSIZE.y < PREDSIZEMAX.y) {
         // we can't continue. make it floating.
         pWindow->m_isFloating = true;
-        m_lDwindleNodesData.remove(*PNODE);
+        destroyNode(PNODE);
         g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
         return;
     }
 
     // last fail-safe to avoid duplicate fullscreens
     if ((!OPENINGON || OPENINGON->pWindow.lock() == pWindow) && getNodesOnWorkspace(PNODE->workspaceID) > 1) {
-        for (auto& node : m_lDwindleNodesData) {
-            if (node.workspaceID == PNODE->workspaceID && node.pWindow.lock() && node.pWindow.lock() != pWindow) {
-                OPENINGON = &node;
+        for (auto const& node : m_workspaceNodes[PNODE->workspaceID]) {
+            if (node->pWindow.lock() && node->pWindow.lock() != pWindow) {
+                OPENINGON = node;
                 break;
             }
         }
@@ -304,15 +353,13 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
 
     // get the node under our cursor
 
-    m_lDwindleNodesData.emplace_back();
-    const auto NEWPARENT = &m_lDwindleNodesData.back();
+    const auto NEWPARENT = createNode(OPENINGON->workspaceID);
 
     // make the parent have the OPENINGON's stats
-    NEWPARENT->box         = OPENINGON->box;
-    NEWPARENT->workspaceID = OPENINGON->workspaceID;
-    NEWPARENT->pParent     = OPENINGON->pParent;
-    NEWPARENT->isNode      = true; // it is a node
-    NEWPARENT->splitRatio  = std::clamp(*PDEFAULTSPLIT, 0.1f, 1.9f);
+    NEWPARENT->box        = OPENINGON->box;
+    NEWPARENT->pParent    = OPENINGON->pParent;
+    NEWPARENT->isNode     = true; // it is a node
+    NEWPARENT->splitRatio = std::clamp(*PDEFAULTSPLIT, 0.1f, 1.9f);
 
     static auto PWIDTHMULTIPLIER = CConfigValue<Hyprlang::FLOAT>("dwindle:split_width_multiplier");
 
@@ -455,7 +502,7 @@ void CHyprDwindleLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
 
     if (!PPARENT) {
         Debug::log(LOG, "Removing last node (dwindle)");
-        m_lDwindleNodesData.remove(*PNODE);
+        destroyNode(PNODE);
         return;
     }
 
@@ -480,8 +527,8 @@ void CHyprDwindleLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
     else
         PSIBLING->recalcSizePosRecursive();
 
-    m_lDwindleNodesData.remove(*PPARENT);
-    m_lDwindleNodesData.remove(*PNODE);
+    destroyNode(PPARENT);
+    destroyNode(PNODE);
 }
 
 void CHyprDwindleLayout::recalculateMonitor(const MONITORID& monid) {
@@ -490,12 +537,16 @@ void CHyprDwindleLayout::recalculateMonitor(const MONITORID& monid) {
     if (!PMONITOR || !PMONITOR->activeWorkspace)
         return; // ???
 
+    const auto BEGIN = std::chrono::steady_clock::now();
+
     g_pHyprRenderer->damageMonitor(PMONITOR);
 
     if (PMONITOR->activeSpecialWorkspace)
         calculateWorkspace(PMONITOR->activeSpecialWorkspace);
 
     calculateWorkspace(PMONITOR->activeWorkspace);
+
+    recordOperation(m_stats.recalculated, BEGIN);
 }
 
 void CHyprDwindleLayout::calculateWorkspace(const PHLWORKSPACE& pWorkspace) {
@@ -886,8 +937,8 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
     SDwindleNodeData* ACTIVE2 = nullptr;
 
     // swap the windows and recalc
-    PNODE2->pWindow = pWindow;
-    PNODE->pWindow  = pWindow2;
+    setNodeWindow(PNODE2, pWindow);
+    setNodeWindow(PNODE, pWindow2);
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_monitor, pWindow->m_monitor);
@@ -897,11 +948,9 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
     pWindow->setAnimationsToMove();
     pWindow2->setAnimationsToMove();
 
-    // recalc the workspace
-    getMasterNodeOnWorkspace(PNODE->workspaceID)->recalcSizePosRecursive();
-
-    if (PNODE2->workspaceID != PNODE->workspaceID)
-        getMasterNodeOnWorkspace(PNODE2->workspaceID)->recalcSizePosRecursive();
+    // only the two windows moved, the splits around them didn't change
+    applyNodeDataToWindow(PNODE);
+    applyNodeDataToWindow(PNODE2);
 
     if (ACTIVE1) {
         ACTIVE1->box                 = PNODE->box;
@@ -1057,11 +1106,18 @@ void CHyprDwindleLayout::replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to) {
     if (!PNODE)
         return;
 
-    PNODE->pWindow = to;
+    setNodeWindow(PNODE, to);
 
     applyNodeDataToWindow(PNODE, true);
 }
 
+SLayoutStats CHyprDwindleLayout::getStats() {
+    auto stats       = m_stats;
+    stats.nodes      = m_nodes.size();
+    stats.workspaces = m_workspaceNodes.size();
+    return stats;
+}
+
 std::string CHyprDwindleLayout::getLayoutName() {
     return "dwindle";
 }
@@ -1076,7 +1132,9 @@ void CHyprDwindleLayout::onEnable() {
 }
 
 void CHyprDwindleLayout::onDisable() {
-    m_lDwindleNodesData.clear();
+    m_windowNodes.clear();
+    m_workspaceNodes.clear();
+    m_nodes.clear();
 }
 
 Vector2D CHyprDwindleLayout::predictSizeForNewWindowTiled() {
@@ -2,8 +2,9 @@
 
 #include "IHyprLayout.hpp"
 #include "../desktop/DesktopTypes.hpp"
+#include "../helpers/NodeArena.hpp"
 
-#include <list>
+#include <unordered_map>
 #include <vector>
 #include <array>
 #include <optional>
@@ -60,12 +61,17 @@ class CHyprDwindleLayout : public IHyprLayout {
     virtual std::string              getLayoutName();
     virtual void                     replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to);
     virtual Vector2D                 predictSizeForNewWindowTiled();
+    virtual SLayoutStats             getStats();
 
     virtual void                     onEnable();
     virtual void                     onDisable();
 
   private:
-    std::list<SDwindleNodeData> m_lDwindleNodesData;
+    CNodeArena<SDwindleNodeData>                                    m_nodes;
+
+    // kept in sync by createNode, destroyNode and setNodeWindow
+    std::unordered_map<WORKSPACEID, std::vector<SDwindleNodeData*>> m_workspaceNodes; // windows and splits, oldest first
+    std::unordered_map<CWindow*, SDwindleNodeData*>                 m_windowNodes;
 
     struct {
         bool started = false;
@@ -83,6 +89,9 @@ class CHyprDwindleLayout : public IHyprLayout {
     SDwindleNodeData*       getFirstNodeOnWorkspace(const WORKSPACEID&);
     SDwindleNodeData*       getClosestNodeOnWorkspace(const WORKSPACEID&, const Vector2D&);
     SDwindleNodeData*       getMasterNodeOnWorkspace(const WORKSPACEID&);
+    SDwindleNodeData*       createNode(const WORKSPACEID&);
+    void                    destroyNode(SDwindleNodeData*);
+    void                    setNodeWindow(SDwindleNodeData*, PHLWINDOW);
 
     void                    toggleSplit(PHLWINDOW);
     void                    swapSplit(PHLWINDOW);
@@ -38,8 +38,11 @@ void IHyprLayout::onWindowCreated(PHLWINDOW pWindow, eDirection direction) {
 
     if (pWindow->m_isFloating)
         onWindowCreatedFloating(pWindow);
-    else
+    else {
+        const auto BEGIN = std::chrono::steady_clock::now();
         onWindowCreatedTiling(pWindow, direction);
+        recordOperation(m_stats.created, BEGIN);
+    }
 
     if (!g_pXWaylandManager->shouldBeFloated(pWindow)) // do not apply group rules to child windows
         pWindow->applyGroupRules();
@@ -85,13 +88,27 @@ void IHyprLayout::onWindowRemoved(PHLWINDOW pWindow) {
     if (pWindow->m_isFloating) {
         onWindowRemovedFloating(pWindow);
     } else {
+        const auto BEGIN = std::chrono::steady_clock::now();
         onWindowRemovedTiling(pWindow);
+        recordOperation(m_stats.removed, BEGIN);
     }
 
     if (pWindow == m_pLastTiledWindow)
         m_pLastTiledWindow.reset();
 }
 
+SLayoutStats IHyprLayout::getStats() {
+    return m_stats;
+}
+
+void IHyprLayout::recordOperation(SLayoutStats::SOperation& op, const std::chrono::steady_clock::time_point& begin) {
+    const auto MS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / 1000.F;
+
+    op.calls++;
+    op.totalMs += MS;
+    op.maxMs = std::max(op.maxMs, MS);
+}
+
 void IHyprLayout::onWindowRemovedFloating(PHLWINDOW pWindow) {
     ; // no-op
 }
@@ -2,6 +2,7 @@
 
 #include "../defines.hpp"
 #include <any>
+#include <chrono>
 
 class CWindow;
 class CGradientValueData;
@@ -17,6 +18,19 @@ struct SLayoutMessageHeader {
 
 enum eFullscreenMode : int8_t;
 
+// shown by hyprctl layoutstats
+struct SLayoutStats {
+    struct SOperation {
+        uint64_t calls   = 0;
+        float    totalMs = 0;
+        float    maxMs   = 0;
+    };
+
+    SOperation created, removed, recalculated; // tiled windows, monitors
+    size_t     nodes      = 0;
+    size_t     workspaces = 0; // with at least one node
+};
+
 enum eRectCorner : uint8_t {
     CORNER_NONE        = 0,
     CORNER_TOPLEFT     = (1 << 0),
@@ -211,6 +225,16 @@ class IHyprLayout {
     */
     virtual bool updateDragWindow();
 
+    /*
+        Operation timings, and node counts for layouts that keep nodes
+    */
+    virtual SLayoutStats getStats();
+
+  protected:
+    SLayoutStats m_stats;
+
+    void         recordOperation(SLayoutStats::SOperation& op, const std::chrono::steady_clock::time_point& begin);
+
   private:
     int          m_iMouseMoveEventCount;
     Vector2D     m_vBeginDragXY;
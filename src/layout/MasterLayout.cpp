@@ -11,32 +11,59 @@
 #include "../managers/EventManager.hpp"
 
 SMasterNodeData* CHyprMasterLayout::getNodeFromWindow(PHLWINDOW pWindow) {
-    for (auto& nd : m_lMasterNodesData) {
-        if (nd.pWindow.lock() == pWindow)
-            return &nd;
-    }
+    if (!pWindow)
+        return nullptr;
 
-    return nullptr;
+    const auto IT = m_windowNodes.find(pWindow.get());
+    if (IT == m_windowNodes.end() || IT->second->pWindow.lock() != pWindow)
+        return nullptr;
+
+    return IT->second;
 }
 
-int CHyprMasterLayout::getNodesOnWorkspace(const WORKSPACEID& ws) {
-    int no = 0;
-    for (auto const& n : m_lMasterNodesData) {
-        if (n.workspaceID == ws)
-            no++;
-    }
+const std::list<SMasterNodeData*>& CHyprMasterLayout::workspaceStack(const WORKSPACEID& ws) {
+    static const std::list<SMasterNodeData*> EMPTY;
 
-    return no;
+    const auto IT = m_workspaceNodes.find(ws);
+    return IT == m_workspaceNodes.end() ? EMPTY : IT->second;
 }
 
-int CHyprMasterLayout::getMastersOnWorkspace(const WORKSPACEID& ws) {
-    int no = 0;
-    for (auto const& n : m_lMasterNodesData) {
-        if (n.workspaceID == ws && n.isMaster)
-            no++;
+std::list<SMasterNodeData*>::iterator CHyprMasterLayout::nodeIterator(SMasterNodeData* pNode) {
+    return std::ranges::find(m_workspaceNodes[pNode->workspaceID], pNode);
+}
+
+SMasterNodeData* CHyprMasterLayout::createNode(PHLWINDOW pWindow) {
+    const auto PNODE   = m_nodes.create();
+    PNODE->workspaceID = pWindow->workspaceID();
+    PNODE->pWindow     = pWindow;
+
+    m_windowNodes[pWindow.get()] = PNODE;
+
+    // the caller puts it in the stack
+    return PNODE;
+}
+
+void CHyprMasterLayout::removeNode(SMasterNodeData* pNode) {
+    if (const auto IT = m_workspaceNodes.find(pNode->workspaceID); IT != m_workspaceNodes.end()) {
+        std::erase(IT->second, pNode);
+        if (IT->second.empty())
+            m_workspaceNodes.erase(IT);
     }
 
-    return no;
+    if (const auto PWINDOW = pNode->pWindow.lock(); PWINDOW)
+        m_windowNodes.erase(PWINDOW.get());
+    else
+        std::erase_if(m_windowNodes, [pNode](const auto& other) { return other.second == pNode; });
+
+    m_nodes.destroy(pNode);
+}
+
+int CHyprMasterLayout::getNodesOnWorkspace(const WORKSPACEID& ws) {
+    return workspaceStack(ws).size();
+}
+
+int CHyprMasterLayout::getMastersOnWorkspace(const WORKSPACEID& ws) {
+    return std::ranges::count_if(workspaceStack(ws), [](const auto& n) { return n->isMaster; });
 }
 
 SMasterWorkspaceData* CHyprMasterLayout::getMasterWorkspaceData(const WORKSPACEID& ws) {
@@ -64,14 +91,21 @@ SMasterWorkspaceData* CHyprMasterLayout::getMasterWorkspaceData(const WORKSPACEI
     return PWORKSPACEDATA;
 }
 
+SLayoutStats CHyprMasterLayout::getStats() {
+    auto stats       = m_stats;
+    stats.nodes      = m_nodes.size();
+    stats.workspaces = m_workspaceNodes.size();
+    return stats;
+}
+
 std::string CHyprMasterLayout::getLayoutName() {
     return "Master";
 }
 
 SMasterNodeData* CHyprMasterLayout::getMasterNodeOnWorkspace(const WORKSPACEID& ws) {
-    for (auto& n : m_lMasterNodesData) {
-        if (n.isMaster && n.workspaceID == ws)
-            return &n;
+    for (auto const& n : workspaceStack(ws)) {
+        if (n->isMaster)
+            return n;
     }
 
     return nullptr;
@@ -90,22 +124,23 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
     const bool  BNEWBEFOREACTIVE = *PNEWONACTIVE == "before";
     const bool  BNEWISMASTER     = *PNEWSTATUS == "master";
 
-    const auto  PNODE = [&]() {
+    const auto  PNODE = createNode(pWindow);
+    auto&       stack = m_workspaceNodes[PNODE->workspaceID];
+
+    const auto  NODEIT = [&]() {
         if (*PNEWONACTIVE != "none" && !BNEWISMASTER) {
             const auto pLastNode = getNodeFromWindow(g_pCompositor->m_lastWindow.lock());
-            if (pLastNode && !(pLastNode->isMaster && (getMastersOnWorkspace(pWindow->workspaceID()) == 1 || *PNEWSTATUS == "slave"))) {
-                auto it = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), *pLastNode);
+            // the active window can only be a neighbour on its own workspace
+            if (pLastNode && pLastNode->workspaceID == PNODE->workspaceID && !(pLastNode->isMaster && (getMastersOnWorkspace(PNODE->workspaceID) == 1 || *PNEWSTATUS == "slave"))) {
+                auto it = nodeIterator(pLastNode);
                 if (!BNEWBEFOREACTIVE)
                     ++it;
-                return &(*m_lMasterNodesData.emplace(it));
+                return stack.emplace(it, PNODE);
             }
         }
-        return *PNEWONTOP ? &m_lMasterNodesData.emplace_front() : &m_lMasterNodesData.emplace_back();
+        return stack.emplace(*PNEWONTOP ? stack.begin() : stack.end(), PNODE);
     }();
 
-    PNODE->workspaceID = pWindow->workspaceID();
-    PNODE->pWindow     = pWindow;
-
     const auto   WINDOWSONWORKSPACE = getNodesOnWorkspace(PNODE->workspaceID);
     static auto  PMFACT             = CConfigValue<Hyprlang::FLOAT>("master:mfact");
     float        lastSplitPercent   = *PMFACT;
@@ -117,56 +152,53 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
     const auto   MOUSECOORDS   = g_pInputManager->getMouseCoordsInternal();
     static auto  PDROPATCURSOR = CConfigValue<Hyprlang::INT>("master:drop_at_cursor");
     eOrientation orientation   = getDynamicOrientation(pWindow->m_workspace);
-    const auto   NODEIT        = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), *PNODE);
 
     bool         forceDropAsMaster = false;
     // if dragging window to move, drop it at the cursor position instead of bottom/top of stack
     if (*PDROPATCURSOR && g_pInputManager->dragMode == MBIND_MOVE) {
         if (WINDOWSONWORKSPACE > 2) {
-            for (auto it = m_lMasterNodesData.begin(); it != m_lMasterNodesData.end(); ++it) {
-                if (it->workspaceID != pWindow->workspaceID())
-                    continue;
-                const CBox box = it->pWindow->getWindowIdealBoundingBoxIgnoreReserved();
+            for (auto it = stack.begin(); it != stack.end(); ++it) {
+                const CBox box = (*it)->pWindow->getWindowIdealBoundingBoxIgnoreReserved();
                 if (box.containsPoint(MOUSECOORDS)) {
                     switch (orientation) {
                         case ORIENTATION_LEFT:
                         case ORIENTATION_RIGHT:
-                            if (MOUSECOORDS.y > it->pWindow->middle().y)
+                            if (MOUSECOORDS.y > (*it)->pWindow->middle().y)
                                 ++it;
                             break;
                         case ORIENTATION_TOP:
                         case ORIENTATION_BOTTOM:
-                            if (MOUSECOORDS.x > it->pWindow->middle().x)
+                            if (MOUSECOORDS.x > (*it)->pWindow->middle().x)
                                 ++it;
                             break;
                         case ORIENTATION_CENTER: break;
                         default: UNREACHABLE();
                     }
-                    m_lMasterNodesData.splice(it, m_lMasterNodesData, NODEIT);
+                    stack.splice(it, stack, NODEIT);
                     break;
                 }
             }
         } else if (WINDOWSONWORKSPACE == 2) {
             // when dropping as the second tiled window in the workspace,
             // make it the master only if the cursor is on the master side of the screen
-            for (auto const& nd : m_lMasterNodesData) {
-                if (nd.isMaster && nd.workspaceID == PNODE->workspaceID) {
+            for (auto const& nd : stack) {
+                if (nd->isMaster) {
                     switch (orientation) {
                         case ORIENTATION_LEFT:
                         case ORIENTATION_CENTER:
-                            if (MOUSECOORDS.x < nd.pWindow->middle().x)
+                            if (MOUSECOORDS.x < nd->pWindow->middle().x)
                                 forceDropAsMaster = true;
                             break;
                         case ORIENTATION_RIGHT:
-                            if (MOUSECOORDS.x > nd.pWindow->middle().x)
+                            if (MOUSECOORDS.x > nd->pWindow->middle().x)
                                 forceDropAsMaster = true;
                             break;
                         case ORIENTATION_TOP:
-                            if (MOUSECOORDS.y < nd.pWindow->middle().y)
+                            if (MOUSECOORDS.y < nd->pWindow->middle().y)
                                 forceDropAsMaster = true;
                             break;
                         case ORIENTATION_BOTTOM:
-                            if (MOUSECOORDS.y > nd.pWindow->middle().y)
+                            if (MOUSECOORDS.y > nd->pWindow->middle().y)
                                 forceDropAsMaster = true;
                             break;
                         default: UNREACHABLE();
@@ -184,18 +216,18 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
         || (*PNEWSTATUS == "inherit" && OPENINGON && OPENINGON->isMaster && g_pInputManager->dragMode != MBIND_MOVE)) {
 
         if (BNEWBEFOREACTIVE) {
-            for (auto& nd : m_lMasterNodesData | std::views::reverse) {
-                if (nd.isMaster && nd.workspaceID == PNODE->workspaceID) {
-                    nd.isMaster      = false;
-                    lastSplitPercent = nd.percMaster;
+            for (auto const& nd : stack | std::views::reverse) {
+                if (nd->isMaster) {
+                    nd->isMaster     = false;
+                    lastSplitPercent = nd->percMaster;
                     break;
                 }
             }
         } else {
-            for (auto& nd : m_lMasterNodesData) {
-                if (nd.isMaster && nd.workspaceID == PNODE->workspaceID) {
-                    nd.isMaster      = false;
-                    lastSplitPercent = nd.percMaster;
+            for (auto const& nd : stack) {
+                if (nd->isMaster) {
+                    nd->isMaster     = false;
+                    lastSplitPercent = nd->percMaster;
                     break;
                 }
             }
@@ -208,7 +240,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
         if (const auto MAXSIZE = pWindow->requestedMaxSize(); MAXSIZE.x < PMONITOR->vecSize.x * lastSplitPercent || MAXSIZE.y < PMONITOR->vecSize.y) {
             // we can't continue. make it floating.
             pWindow->m_isFloating = true;
-            m_lMasterNodesData.remove(*PNODE);
+            removeNode(PNODE);
             g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
             return;
         }
@@ -221,7 +253,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
             MAXSIZE.x < PMONITOR->vecSize.x * (1 - lastSplitPercent) || MAXSIZE.y < PMONITOR->vecSize.y * (1.f / (WINDOWSONWORKSPACE - 1))) {
             // we can't continue. make it floating.
             pWindow->m_isFloating = true;
-            m_lMasterNodesData.remove(*PNODE);
+            removeNode(PNODE);
             g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
             return;
         }
@@ -249,35 +281,23 @@ void CHyprMasterLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
 
     if (PNODE->isMaster && (MASTERSLEFT <= 1 || *SMALLSPLIT == 1)) {
         // find a new master from top of the list
-        for (auto& nd : m_lMasterNodesData) {
-            if (!nd.isMaster && nd.workspaceID == WORKSPACEID) {
-                nd.isMaster   = true;
-                nd.percMaster = PNODE->percMaster;
+        for (auto const& nd : workspaceStack(WORKSPACEID)) {
+            if (!nd->isMaster) {
+                nd->isMaster   = true;
+                nd->percMaster = PNODE->percMaster;
                 break;
             }
         }
     }
 
-    m_lMasterNodesData.remove(*PNODE);
+    removeNode(PNODE);
 
-    if (getMastersOnWorkspace(WORKSPACEID) == getNodesOnWorkspace(WORKSPACEID) && MASTERSLEFT > 1) {
-        for (auto& nd : m_lMasterNodesData | std::views::reverse) {
-            if (nd.workspaceID == WORKSPACEID) {
-                nd.isMaster = false;
-                break;
-            }
-        }
-    }
+    if (getMastersOnWorkspace(WORKSPACEID) == getNodesOnWorkspace(WORKSPACEID) && MASTERSLEFT > 1)
+        workspaceStack(WORKSPACEID).back()->isMaster = false;
     // BUGFIX: correct bug where closing one master in a stack of 2 would leave
     // the screen half bare, and make it difficult to select remaining window
-    if (getNodesOnWorkspace(WORKSPACEID) == 1) {
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID == WORKSPACEID && !nd.isMaster) {
-                nd.isMaster = true;
-                break;
-            }
-        }
-    }
+    if (getNodesOnWorkspace(WORKSPACEID) == 1)
+        workspaceStack(WORKSPACEID).front()->isMaster = true;
     recalculateMonitor(pWindow->monitorID());
 }
 
@@ -287,12 +307,16 @@ void CHyprMasterLayout::recalculateMonitor(const MONITORID& monid) {
     if (!PMONITOR || !PMONITOR->activeWorkspace)
         return;
 
+    const auto BEGIN = std::chrono::steady_clock::now();
+
     g_pHyprRenderer->damageMonitor(PMONITOR);
 
     if (PMONITOR->activeSpecialWorkspace)
         calculateWorkspace(PMONITOR->activeSpecialWorkspace);
 
     calculateWorkspace(PMONITOR->activeWorkspace);
+
+    recordOperation(m_stats.recalculated, BEGIN);
 }
 
 void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
@@ -330,6 +354,8 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
     if (!PMASTERNODE)
         return;
 
+    const auto& STACK = workspaceStack(pWorkspace->m_id);
+
     eOrientation orientation         = getDynamicOrientation(pWorkspace);
     bool         centerMasterWindow  = false;
     static auto  SLAVECOUNTFORCENTER = CConfigValue<Hyprlang::INT>("master:slave_count_for_center_master");
@@ -363,13 +389,11 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
     if (*PSMARTRESIZING) {
         // check the total width and height so that later
         // if larger/smaller than screen size them down/up
-        for (auto const& nd : m_lMasterNodesData) {
-            if (nd.workspaceID == pWorkspace->m_id) {
-                if (nd.isMaster)
-                    masterAccumulatedSize += totalSize / MASTERS * nd.percSize;
-                else
-                    slaveAccumulatedSize += totalSize / STACKWINDOWS * nd.percSize;
-            }
+        for (auto const& nd : STACK) {
+            if (nd->isMaster)
+                masterAccumulatedSize += totalSize / MASTERS * nd->percSize;
+            else
+                slaveAccumulatedSize += totalSize / STACKWINDOWS * nd->percSize;
         }
     }
 
@@ -404,22 +428,22 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         if (orientation == ORIENTATION_BOTTOM)
             nextY = WSSIZE.y - HEIGHT;
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID != pWorkspace->m_id || !nd.isMaster)
+        for (auto const& nd : STACK) {
+            if (!nd->isMaster)
                 continue;
 
-            float WIDTH = mastersLeft > 1 ? widthLeft / mastersLeft * nd.percSize : widthLeft;
+            float WIDTH = mastersLeft > 1 ? widthLeft / mastersLeft * nd->percSize : widthLeft;
             if (WIDTH > widthLeft * 0.9f && mastersLeft > 1)
                 WIDTH = widthLeft * 0.9f;
 
             if (*PSMARTRESIZING) {
-                nd.percSize *= WSSIZE.x / masterAccumulatedSize;
-                WIDTH = masterAverageSize * nd.percSize;
+                nd->percSize *= WSSIZE.x / masterAccumulatedSize;
+                WIDTH = masterAverageSize * nd->percSize;
             }
 
-            nd.size     = Vector2D(WIDTH, HEIGHT);
-            nd.position = WSPOS + Vector2D(nextX, nextY);
-            applyNodeDataToWindow(&nd);
+            nd->size     = Vector2D(WIDTH, HEIGHT);
+            nd->position = WSPOS + Vector2D(nextX, nextY);
+            applyNodeDataToWindow(nd);
 
             mastersLeft--;
             widthLeft -= WIDTH;
@@ -441,22 +465,22 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
             nextX = ((*PIGNORERESERVED && centerMasterWindow ? PMONITOR->vecSize.x : WSSIZE.x) - WIDTH) / 2;
         }
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID != pWorkspace->m_id || !nd.isMaster)
+        for (auto const& nd : STACK) {
+            if (!nd->isMaster)
                 continue;
 
-            float HEIGHT = mastersLeft > 1 ? heightLeft / mastersLeft * nd.percSize : heightLeft;
+            float HEIGHT = mastersLeft > 1 ? heightLeft / mastersLeft * nd->percSize : heightLeft;
             if (HEIGHT > heightLeft * 0.9f && mastersLeft > 1)
                 HEIGHT = heightLeft * 0.9f;
 
             if (*PSMARTRESIZING) {
-                nd.percSize *= WSSIZE.y / masterAccumulatedSize;
-                HEIGHT = masterAverageSize * nd.percSize;
+                nd->percSize *= WSSIZE.y / masterAccumulatedSize;
+                HEIGHT = masterAverageSize * nd->percSize;
             }
 
-            nd.size     = Vector2D(WIDTH, HEIGHT);
-            nd.position = (*PIGNORERESERVED && centerMasterWindow ? PMONITOR->vecPosition : WSPOS) + Vector2D(nextX, nextY);
-            applyNodeDataToWindow(&nd);
+            nd->size     = Vector2D(WIDTH, HEIGHT);
+            nd->position = (*PIGNORERESERVED && centerMasterWindow ? PMONITOR->vecPosition : WSPOS) + Vector2D(nextX, nextY);
+            applyNodeDataToWindow(nd);
 
             mastersLeft--;
             heightLeft -= HEIGHT;
@@ -478,22 +502,22 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         if (orientation == ORIENTATION_TOP)
             nextY = PMASTERNODE->size.y;
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID != pWorkspace->m_id || nd.isMaster)
+        for (auto const& nd : STACK) {
+            if (nd->isMaster)
                 continue;
 
-            float WIDTH = slavesLeft > 1 ? widthLeft / slavesLeft * nd.percSize : widthLeft;
+            float WIDTH = slavesLeft > 1 ? widthLeft / slavesLeft * nd->percSize : widthLeft;
             if (WIDTH > widthLeft * 0.9f && slavesLeft > 1)
                 WIDTH = widthLeft * 0.9f;
 
             if (*PSMARTRESIZING) {
-                nd.percSize *= WSSIZE.x / slaveAccumulatedSize;
-                WIDTH = slaveAverageSize * nd.percSize;
+                nd->percSize *= WSSIZE.x / slaveAccumulatedSize;
+                WIDTH = slaveAverageSize * nd->percSize;
             }
 
-            nd.size     = Vector2D(WIDTH, HEIGHT);
-            nd.position = WSPOS + Vector2D(nextX, nextY);
-            applyNodeDataToWindow(&nd);
+            nd->size     = Vector2D(WIDTH, HEIGHT);
+            nd->position = WSPOS + Vector2D(nextX, nextY);
+            applyNodeDataToWindow(nd);
 
             slavesLeft--;
             widthLeft -= WIDTH;
@@ -508,22 +532,22 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         if (orientation == ORIENTATION_LEFT)
             nextX = PMASTERNODE->size.x;
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID != pWorkspace->m_id || nd.isMaster)
+        for (auto const& nd : STACK) {
+            if (nd->isMaster)
                 continue;
 
-            float HEIGHT = slavesLeft > 1 ? heightLeft / slavesLeft * nd.percSize : heightLeft;
+            float HEIGHT = slavesLeft > 1 ? heightLeft / slavesLeft * nd->percSize : heightLeft;
             if (HEIGHT > heightLeft * 0.9f && slavesLeft > 1)
                 HEIGHT = heightLeft * 0.9f;
 
             if (*PSMARTRESIZING) {
-                nd.percSize *= WSSIZE.y / slaveAccumulatedSize;
-                HEIGHT = slaveAverageSize * nd.percSize;
+                nd->percSize *= WSSIZE.y / slaveAccumulatedSize;
+                HEIGHT = slaveAverageSize * nd->percSize;
             }
 
-            nd.size     = Vector2D(WIDTH, HEIGHT);
-            nd.position = WSPOS + Vector2D(nextX, nextY);
-            applyNodeDataToWindow(&nd);
+            nd->size     = Vector2D(WIDTH, HEIGHT);
+            nd->position = WSPOS + Vector2D(nextX, nextY);
+            applyNodeDataToWindow(nd);
 
             slavesLeft--;
             heightLeft -= HEIGHT;
@@ -553,14 +577,14 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
         float       slaveAccumulatedHeightR = 0;
 
         if (*PSMARTRESIZING) {
-            for (auto const& nd : m_lMasterNodesData) {
-                if (nd.workspaceID != pWorkspace->m_id || nd.isMaster)
+            for (auto const& nd : STACK) {
+                if (nd->isMaster)
                     continue;
 
                 if (onRight) {
-                    slaveAccumulatedHeightR += slaveAverageHeightR * nd.percSize;
+                    slaveAccumulatedHeightR += slaveAverageHeightR * nd->percSize;
                 } else {
-                    slaveAccumulatedHeightL += slaveAverageHeightL * nd.percSize;
+                    slaveAccumulatedHeightL += slaveAverageHeightL * nd->percSize;
                 }
                 onRight = !onRight;
             }
@@ -568,8 +592,8 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
             onRight = *CMSLAVESONRIGHT;
         }
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID != pWorkspace->m_id || nd.isMaster)
+        for (auto const& nd : STACK) {
+            if (nd->isMaster)
                 continue;
 
             if (onRight) {
@@ -584,23 +608,23 @@ void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
                 slavesLeft = slavesLeftL;
             }
 
-            float HEIGHT = slavesLeft > 1 ? heightLeft / slavesLeft * nd.percSize : heightLeft;
+            float HEIGHT = slavesLeft > 1 ? heightLeft / slavesLeft * nd->percSize : heightLeft;
             if (HEIGHT > heightLeft * 0.9f && slavesLeft > 1)
                 HEIGHT = heightLeft * 0.9f;
 
             if (*PSMARTRESIZING) {
                 if (onRight) {
-                    nd.percSize *= WSSIZE.y / slaveAccumulatedHeightR;
-                    HEIGHT = slaveAverageHeightR * nd.percSize;
+                    nd->percSize *= WSSIZE.y / slaveAccumulatedHeightR;
+                    HEIGHT = slaveAverageHeightR * nd->percSize;
                 } else {
-                    nd.percSize *= WSSIZE.y / slaveAccumulatedHeightL;
-                    HEIGHT = slaveAverageHeightL * nd.percSize;
+                    nd->percSize *= WSSIZE.y / slaveAccumulatedHeightL;
+                    HEIGHT = slaveAverageHeightL * nd->percSize;
                 }
             }
 
-            nd.size     = Vector2D(*PIGNORERESERVED ? (WIDTH - (onRight ? PMONITOR->vecReservedBottomRight.x : PMONITOR->vecReservedTopLeft.x)) : WIDTH, HEIGHT);
-            nd.position = WSPOS + Vector2D(nextX, nextY);
-            applyNodeDataToWindow(&nd);
+            nd->size     = Vector2D(*PIGNORERESERVED ? (WIDTH - (onRight ? PMONITOR->vecReservedBottomRight.x : PMONITOR->vecReservedTopLeft.x)) : WIDTH, HEIGHT);
+            nd->position = WSPOS + Vector2D(nextX, nextY);
+            applyNodeDataToWindow(nd);
 
             if (onRight) {
                 heightLeftR -= HEIGHT;
@@ -777,9 +801,9 @@ void CHyprMasterLayout::resizeActiveWindow(const Vector2D& pixResize, eRectCorne
     }
 
     const auto workspaceIdForResizing = PMONITOR->activeSpecialWorkspace ? PMONITOR->activeSpecialWorkspaceID() : PMONITOR->activeWorkspaceID();
-    for (auto& n : m_lMasterNodesData) {
-        if (n.isMaster && n.workspaceID == workspaceIdForResizing)
-            n.percMaster = std::clamp(n.percMaster + delta, 0.05, 0.95);
+    for (auto const& n : workspaceStack(workspaceIdForResizing)) {
+        if (n->isMaster)
+            n->percMaster = std::clamp(n->percMaster + delta, 0.05, 0.95);
     }
 
     // check the up/down resize
@@ -798,8 +822,9 @@ void CHyprMasterLayout::resizeActiveWindow(const Vector2D& pixResize, eRectCorne
         if (!*PSMARTRESIZING) {
             PNODE->percSize = std::clamp(PNODE->percSize + RESIZEDELTA / SIZE, 0.05, 1.95);
         } else {
-            const auto  NODEIT    = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), *PNODE);
-            const auto  REVNODEIT = std::find(m_lMasterNodesData.rbegin(), m_lMasterNodesData.rend(), *PNODE);
+            auto&       STACK     = m_workspaceNodes[PNODE->workspaceID];
+            const auto  NODEIT    = nodeIterator(PNODE);
+            const auto  REVNODEIT = std::make_reverse_iterator(std::next(NODEIT));
 
             const float totalSize       = isStackVertical ? WSSIZE.y : WSSIZE.x;
             const float minSize         = totalSize / nodesInSameColumn * 0.2;
@@ -809,21 +834,21 @@ void CHyprMasterLayout::resizeActiveWindow(const Vector2D& pixResize, eRectCorne
             float       sizeLeft  = 0;
             int         nodeCount = 0;
             // check the sizes of all the nodes to be resized for later calculation
-            auto checkNodesLeft = [&sizeLeft, &nodesLeft, orientation, isStackVertical, &nodeCount, PNODE](auto it) {
-                if (it.isMaster != PNODE->isMaster || it.workspaceID != PNODE->workspaceID)
+            auto checkNodesLeft = [&sizeLeft, &nodesLeft, orientation, isStackVertical, &nodeCount, PNODE](auto const& it) {
+                if (it->isMaster != PNODE->isMaster)
                     return;
                 nodeCount++;
-                if (!it.isMaster && orientation == ORIENTATION_CENTER && nodeCount % 2 == 1)
+                if (!it->isMaster && orientation == ORIENTATION_CENTER && nodeCount % 2 == 1)
                     return;
-                sizeLeft += isStackVertical ? it.size.y : it.size.x;
+                sizeLeft += isStackVertical ? it->size.y : it->size.x;
                 nodesLeft++;
             };
             float resizeDiff;
             if (resizePrevNodes) {
-                std::for_each(std::next(REVNODEIT), m_lMasterNodesData.rend(), checkNodesLeft);
+                std::for_each(std::next(REVNODEIT), STACK.rend(), checkNodesLeft);
                 resizeDiff = -RESIZEDELTA;
             } else {
-                std::for_each(std::next(NODEIT), m_lMasterNodesData.end(), checkNodesLeft);
+                std::for_each(std::next(NODEIT), STACK.end(), checkNodesLeft);
                 resizeDiff = RESIZEDELTA;
             }
 
@@ -837,21 +862,21 @@ void CHyprMasterLayout::resizeActiveWindow(const Vector2D& pixResize, eRectCorne
 
             // resize the other nodes
             nodeCount            = 0;
-            auto resizeNodesLeft = [maxSizeIncrease, resizeDiff, minSize, orientation, isStackVertical, SIZE, &nodeCount, nodesLeft, PNODE](auto& it) {
-                if (it.isMaster != PNODE->isMaster || it.workspaceID != PNODE->workspaceID)
+            auto resizeNodesLeft = [maxSizeIncrease, resizeDiff, minSize, orientation, isStackVertical, SIZE, &nodeCount, nodesLeft, PNODE](auto const& it) {
+                if (it->isMaster != PNODE->isMaster)
                     return;
                 nodeCount++;
                 // if center orientation, only resize when on the same side
-                if (!it.isMaster && orientation == ORIENTATION_CENTER && nodeCount % 2 == 1)
+                if (!it->isMaster && orientation == ORIENTATION_CENTER && nodeCount % 2 == 1)
                     return;
-                const float size               = isStackVertical ? it.size.y : it.size.x;
+                const float size               = isStackVertical ? it->size.y : it->size.x;
                 const float resizeDeltaForEach = maxSizeIncrease != 0 ? resizeDiff * (size - minSize) / maxSizeIncrease : resizeDiff / nodesLeft;
-                it.percSize -= resizeDeltaForEach / SIZE;
+                it->percSize -= resizeDeltaForEach / SIZE;
             };
             if (resizePrevNodes) {
-                std::for_each(std::next(REVNODEIT), m_lMasterNodesData.rend(), resizeNodesLeft);
+                std::for_each(std::next(REVNODEIT), STACK.rend(), resizeNodesLeft);
             } else {
-                std::for_each(std::next(NODEIT), m_lMasterNodesData.end(), resizeNodesLeft);
+                std::for_each(std::next(NODEIT), STACK.end(), resizeNodesLeft);
             }
         }
     }
@@ -984,6 +1009,7 @@ void CHyprMasterLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
     // massive hack: just swap window pointers, lol
     PNODE->pWindow  = pWindow2;
     PNODE2->pWindow = pWindow;
+    std::swap(m_windowNodes[pWindow.get()], m_windowNodes[pWindow2.get()]);
 
     pWindow->setAnimationsToMove();
     pWindow2->setAnimationsToMove();
@@ -1018,27 +1044,26 @@ PHLWINDOW CHyprMasterLayout::getNextWindow(PHLWINDOW pWindow, bool next, bool lo
 
     const auto PNODE = getNodeFromWindow(pWindow);
 
-    auto       nodes = m_lMasterNodesData;
+    auto       nodes = workspaceStack(PNODE->workspaceID);
     if (!next)
         std::reverse(nodes.begin(), nodes.end());
 
-    const auto NODEIT = std::find(nodes.begin(), nodes.end(), *PNODE);
+    const auto NODEIT = std::ranges::find(nodes, PNODE);
 
     const bool ISMASTER = PNODE->isMaster;
 
-    auto CANDIDATE = std::find_if(NODEIT, nodes.end(), [&](const auto& other) { return other != *PNODE && ISMASTER == other.isMaster && other.workspaceID == PNODE->workspaceID; });
+    auto CANDIDATE = std::find_if(NODEIT, nodes.end(), [&](const auto& other) { return other != PNODE && ISMASTER == other->isMaster; });
     if (CANDIDATE == nodes.end())
-        CANDIDATE =
-            std::find_if(nodes.begin(), nodes.end(), [&](const auto& other) { return other != *PNODE && ISMASTER != other.isMaster && other.workspaceID == PNODE->workspaceID; });
+        CANDIDATE = std::ranges::find_if(nodes, [&](const auto& other) { return other != PNODE && ISMASTER != other->isMaster; });
 
     if (CANDIDATE != nodes.end() && !loop) {
-        if (CANDIDATE->isMaster && next)
+        if ((*CANDIDATE)->isMaster && next)
             return nullptr;
-        if (!CANDIDATE->isMaster && ISMASTER && !next)
+        if (!(*CANDIDATE)->isMaster && ISMASTER && !next)
             return nullptr;
     }
 
-    return CANDIDATE == nodes.end() ? nullptr : CANDIDATE->pWindow.lock();
+    return CANDIDATE == nodes.end() ? nullptr : (*CANDIDATE)->pWindow.lock();
 }
 
 std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::string message) {
@@ -1101,9 +1126,9 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
             const auto NEWFOCUS = newFocusToChild ? NEWCHILD : NEWMASTER;
             switchToWindow(NEWFOCUS);
         } else {
-            for (auto const& n : m_lMasterNodesData) {
-                if (n.workspaceID == PMASTER->workspaceID && !n.isMaster) {
-                    const auto NEWMASTER = n.pWindow.lock();
+            for (auto const& n : workspaceStack(PMASTER->workspaceID)) {
+                if (!n->isMaster) {
+                    const auto NEWMASTER = n->pWindow.lock();
                     switchWindows(NEWMASTER, NEWCHILD);
                     const bool newFocusToMaster = vars.size() >= 2 && vars[1] == "master";
                     const auto NEWFOCUS         = newFocusToMaster ? NEWMASTER : NEWCHILD;
@@ -1136,9 +1161,9 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
             return 0;
         } else {
             // if master is focused keep master focused (don't do anything)
-            for (auto const& n : m_lMasterNodesData) {
-                if (n.workspaceID == PMASTER->workspaceID && !n.isMaster) {
-                    switchToWindow(n.pWindow.lock());
+            for (auto const& n : workspaceStack(PMASTER->workspaceID)) {
+                if (!n->isMaster) {
+                    switchToWindow(n->pWindow.lock());
                     break;
                 }
             }
@@ -1217,9 +1242,9 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
 
         if (!PNODE || PNODE->isMaster) {
             // first non-master node
-            for (auto& n : m_lMasterNodesData) {
-                if (n.workspaceID == header.pWindow->workspaceID() && !n.isMaster) {
-                    n.isMaster = true;
+            for (auto const& n : workspaceStack(header.pWindow->workspaceID())) {
+                if (!n->isMaster) {
+                    n->isMaster = true;
                     break;
                 }
             }
@@ -1249,9 +1274,9 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
 
         if (!PNODE || !PNODE->isMaster) {
             // first non-master node
-            for (auto& nd : m_lMasterNodesData | std::views::reverse) {
-                if (nd.workspaceID == header.pWindow->workspaceID() && nd.isMaster) {
-                    nd.isMaster = false;
+            for (auto const& nd : workspaceStack(header.pWindow->workspaceID()) | std::views::reverse) {
+                if (nd->isMaster) {
+                    nd->isMaster = false;
                     break;
                 }
             }
@@ -1302,16 +1327,17 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
         if (!OLDMASTER)
             return 0;
 
-        const auto OLDMASTERIT = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), *OLDMASTER);
+        auto&      stack       = m_workspaceNodes[OLDMASTER->workspaceID];
+        const auto OLDMASTERIT = nodeIterator(OLDMASTER);
 
-        for (auto& nd : m_lMasterNodesData) {
-            if (nd.workspaceID == PNODE->workspaceID && !nd.isMaster) {
-                nd.isMaster            = true;
-                const auto NEWMASTERIT = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), nd);
-                m_lMasterNodesData.splice(OLDMASTERIT, m_lMasterNodesData, NEWMASTERIT);
-                switchToWindow(nd.pWindow.lock());
+        for (auto const& nd : stack) {
+            if (!nd->isMaster) {
+                nd->isMaster           = true;
+                const auto NEWMASTERIT = nodeIterator(nd);
+                stack.splice(OLDMASTERIT, stack, NEWMASTERIT);
+                switchToWindow(nd->pWindow.lock());
                 OLDMASTER->isMaster = false;
-                m_lMasterNodesData.splice(m_lMasterNodesData.end(), m_lMasterNodesData, OLDMASTERIT);
+                stack.splice(stack.end(), stack, OLDMASTERIT);
                 break;
             }
         }
@@ -1328,16 +1354,17 @@ std::any CHyprMasterLayout::layoutMessage(SLayoutMessageHeader header, std::stri
         if (!OLDMASTER)
             return 0;
 
-        const auto OLDMASTERIT = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), *OLDMASTER);
+        auto&      stack       = m_workspaceNodes[OLDMASTER->workspaceID];
+        const auto OLDMASTERIT = nodeIterator(OLDMASTER);
 
-        for (auto& nd : m_lMasterNodesData | std::views::reverse) {
-            if (nd.workspaceID == PNODE->workspaceID && !nd.isMaster) {
-                nd.isMaster            = true;
-                const auto NEWMASTERIT = std::find(m_lMasterNodesData.begin(), m_lMasterNodesData.end(), nd);
-                m_lMasterNodesData.splice(OLDMASTERIT, m_lMasterNodesData, NEWMASTERIT);
-                switchToWindow(nd.pWindow.lock());
+        for (auto const& nd : stack | std::views::reverse) {
+            if (!nd->isMaster) {
+                nd->isMaster           = true;
+                const auto NEWMASTERIT = nodeIterator(nd);
+                stack.splice(OLDMASTERIT, stack, NEWMASTERIT);
+                switchToWindow(nd->pWindow.lock());
                 OLDMASTER->isMaster = false;
-                m_lMasterNodesData.splice(m_lMasterNodesData.begin(), m_lMasterNodesData, OLDMASTERIT);
+                stack.splice(stack.begin(), stack, OLDMASTERIT);
                 break;
             }
         }
@@ -1435,7 +1462,9 @@ void CHyprMasterLayout::replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to) {
     if (!PNODE)
         return;
 
-    PNODE->pWindow = to;
+    m_windowNodes.erase(from.get());
+    PNODE->pWindow          = to;
+    m_windowNodes[to.get()] = PNODE;
 
     applyNodeDataToWindow(PNODE);
 }
@@ -1477,5 +1506,7 @@ void CHyprMasterLayout::onEnable() {
 }
 
 void CHyprMasterLayout::onDisable() {
-    m_lMasterNodesData.clear();
+    m_windowNodes.clear();
+    m_workspaceNodes.clear();
+    m_nodes.clear();
 }
@@ -3,9 +3,11 @@
 #include "IHyprLayout.hpp"
 #include "../desktop/DesktopTypes.hpp"
 #include "../helpers/varlist/VarList.hpp"
+#include "../helpers/NodeArena.hpp"
 #include <vector>
 #include <list>
 #include <any>
+#include <unordered_map>
 
 enum eFullscreenMode : int8_t;
 
@@ -66,14 +68,19 @@ class CHyprMasterLayout : public IHyprLayout {
     virtual std::string              getLayoutName();
     virtual void                     replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to);
     virtual Vector2D                 predictSizeForNewWindowTiled();
+    virtual SLayoutStats             getStats();
 
     virtual void                     onEnable();
     virtual void                     onDisable();
 
   private:
-    std::list<SMasterNodeData>        m_lMasterNodesData;
+    CNodeArena<SMasterNodeData>       m_nodes;
     std::vector<SMasterWorkspaceData> m_lMasterWorkspacesData;
 
+    // kept in sync by createNode, removeNode and the places that swap windows between nodes
+    std::unordered_map<WORKSPACEID, std::list<SMasterNodeData*>> m_workspaceNodes; // in stack order
+    std::unordered_map<CWindow*, SMasterNodeData*>               m_windowNodes;
+
     bool                              m_bForceWarps = false;
 
     void                              buildOrientationCycleVectorFromVars(std::vector<eOrientation>& cycle, CVarList& vars);
@@ -89,6 +96,11 @@ class CHyprMasterLayout : public IHyprLayout {
     PHLWINDOW                         getNextWindow(PHLWINDOW, bool, bool);
     int                               getMastersOnWorkspace(const WORKSPACEID&);
 
+    const std::list<SMasterNodeData*>&    workspaceStack(const WORKSPACEID&);
+    std::list<SMasterNodeData*>::iterator nodeIterator(SMasterNodeData*);
+    SMasterNodeData*                      createNode(PHLWINDOW);
+    void                                  removeNode(SMasterNodeData*);
+
     friend struct SMasterNodeData;
     friend struct SMasterWorkspaceData;
 };
@@ -75,24 +75,49 @@ static void updateColorVariable(CAnimatedVariable<CHyprColor>& av, const float P
     av.value() = {lerped, lerp(av.begun().a, av.goal().a, POINTY)};
 }
 
+static uint8_t policyBit(eAVarDamagePolicy policy) {
+    return policy == AVARDAMAGE_NONE ? 0 : 1 << policy;
+}
+
+// owners with no variable that damages them still get damaged for animating, like workspaces and layers always did
+constexpr uint8_t DAMAGE_ANY = 1 << 7;
+
+const CHyprAnimationManager::SCurve* CHyprAnimationManager::curveFor(const std::string& bezier) {
+    auto& curve = m_curves[bezier];
+
+    if (curve.source)
+        return &curve;
+
+    // new, or the bezier was redefined (config reload)
+    const auto PBEZIER = getBezier(bezier);
+
+    for (size_t i = 0; i <= CURVE_LUT_SIZE; ++i) {
+        const float X = (float)i / CURVE_LUT_SIZE;
+        curve.lut[i]  = PBEZIER ? PBEZIER->getYForPoint(X) : X;
+    }
+
+    // unknown names fall back to the default bezier, don't pin that in case the name gets defined later
+    if (bezierExists(bezier))
+        curve.source = PBEZIER;
+
+    return &curve;
+}
+
 template <Animable VarType>
-static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
+void CHyprAnimationManager::collect(CAnimatedVariable<VarType>& av, bool warp, std::vector<STickEntry<VarType>>& out) {
     PHLWINDOW    PWINDOW            = av.m_Context.pWindow.lock();
     PHLWORKSPACE PWORKSPACE         = av.m_Context.pWorkspace.lock();
     PHLLS        PLAYER             = av.m_Context.pLayer.lock();
     PHLMONITOR   PMONITOR           = nullptr;
     bool         animationsDisabled = warp;
+    const auto   POLICY             = av.m_Context.eDamagePolicy;
+
+    SOwnerDamage* owner = nullptr;
 
     if (PWINDOW) {
-        if (av.m_Context.eDamagePolicy == AVARDAMAGE_ENTIRE)
-            g_pHyprRenderer->damageWindow(PWINDOW);
-        else if (av.m_Context.eDamagePolicy == AVARDAMAGE_BORDER) {
-            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
-            PDECO->damageEntire();
-        } else if (av.m_Context.eDamagePolicy == AVARDAMAGE_SHADOW) {
-            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
-            PDECO->damageEntire();
-        }
+        auto& [_, damage] = m_tick.windows.try_emplace(PWINDOW.get(), PWINDOW, SOwnerDamage{}).first->second;
+        damage.before |= policyBit(POLICY);
+        owner = &damage;
 
         PMONITOR = PWINDOW->m_monitor.lock();
         if (!PMONITOR)
@@ -104,111 +129,162 @@ static void handleUpdate(CAnimatedVariable<VarType>& av, bool warp) {
         if (!PMONITOR)
             return;
 
-        // dont damage the whole monitor on workspace change, unless it's a special workspace, because dim/blur etc
-        if (PWORKSPACE->m_isSpecialWorkspace)
-            g_pHyprRenderer->damageMonitor(PMONITOR);
+        auto& [_, damage] = m_tick.workspaces.try_emplace(PWORKSPACE.get(), PWORKSPACE, SOwnerDamage{}).first->second;
+        damage.before |= DAMAGE_ANY;
+        owner = &damage;
+    } else if (PLAYER) {
+        auto& [_, damage] = m_tick.layers.try_emplace(PLAYER.get(), PLAYER, SOwnerDamage{}).first->second;
+        damage.before |= DAMAGE_ANY;
+        owner = &damage;
 
-        // TODO: just make this into a damn callback already vax...
-        for (auto const& w : g_pCompositor->m_windows) {
-            if (!w->m_isMapped || w->isHidden() || w->m_workspace != PWORKSPACE)
-                continue;
+        PMONITOR = g_pCompositor->getMonitorFromVector(PLAYER->m_realPosition->goal() + PLAYER->m_realSize->goal() / 2.F);
+        if (!PMONITOR)
+            return;
+        animationsDisabled = animationsDisabled || PLAYER->m_noAnimations;
+    }
 
-            if (w->m_isFloating && !w->m_pinned) {
-                // still doing the full damage hack for floating because sometimes when the window
-                // goes through multiple monitors the last rendered frame is missing damage somehow??
-                const CBox windowBoxNoOffset = w->getFullWindowBoundingBox();
-                const CBox monitorBox        = {PMONITOR->vecPosition, PMONITOR->vecSize};
-                if (windowBoxNoOffset.intersection(monitorBox) != windowBoxNoOffset) // on edges between multiple monitors
-                    g_pHyprRenderer->damageWindow(w, true);
-            }
+    if (owner) {
+        owner->monitor = PMONITOR;
+        owner->after |= policyBit(POLICY);
+    }
 
-            if (PWORKSPACE->m_isSpecialWorkspace)
-                g_pHyprRenderer->damageWindow(w, true); // hack for special too because it can cross multiple monitors
-        }
+    RASSERT(PWINDOW || POLICY != AVARDAMAGE_BORDER, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
+    RASSERT(PWINDOW || POLICY != AVARDAMAGE_SHADOW, "Tried to AVARDAMAGE_SHADOW a non-window AVAR!");
 
-        // damage any workspace window that is on any monitor
-        for (auto const& w : g_pCompositor->m_windows) {
-            if (!validMapped(w) || w->m_workspace != PWORKSPACE || w->m_pinned)
-                continue;
+    if (PMONITOR && std::ranges::find(m_tick.monitors, PMONITOR) == m_tick.monitors.end())
+        m_tick.monitors.emplace_back(PMONITOR);
 
-            g_pHyprRenderer->damageWindow(w);
+    const auto SPENT = av.getPercent();
+
+    out.emplace_back(STickEntry<VarType>{.av     = &av,
+                                         .curve  = curveFor(av.getBezierName()),
+                                         .x      = SPENT,
+                                         .warp   = animationsDisabled || SPENT >= 1.f,
+                                         .noAnim = animationsDisabled,
+                                         .begun  = av.begun(),
+                                         .goal   = av.goal()});
+}
+
+void CHyprAnimationManager::damageOwners(bool after) {
+    for (auto const& [_, entry] : m_tick.windows) {
+        auto const& [PWINDOW, DAMAGE] = entry;
+        const auto FLAGS              = after ? DAMAGE.after : DAMAGE.before;
+
+        if (FLAGS & policyBit(AVARDAMAGE_ENTIRE)) {
+            if (after)
+                PWINDOW->updateWindowDecos();
+            g_pHyprRenderer->damageWindow(PWINDOW);
         }
-    } else if (PLAYER) {
+
+        if (FLAGS & policyBit(AVARDAMAGE_BORDER))
+            PWINDOW->getDecorationByType(DECORATION_BORDER)->damageEntire();
+
+        if (FLAGS & policyBit(AVARDAMAGE_SHADOW))
+            PWINDOW->getDecorationByType(DECORATION_SHADOW)->damageEntire();
+    }
+
+    for (auto const& [_, entry] : m_tick.layers) {
+        auto const& [PLAYER, DAMAGE] = entry;
+
+        if (after && !(DAMAGE.after & policyBit(AVARDAMAGE_ENTIRE)))
+            continue;
+
+        if (after && PLAYER->m_layer <= 1)
+            g_pHyprOpenGL->markBlurDirtyForMonitor(DAMAGE.monitor);
+
         // "some fucking layers miss 1 pixel???" -- vaxry
         CBox expandBox = CBox{PLAYER->m_realPosition->value(), PLAYER->m_realSize->value()};
         expandBox.expand(5);
         g_pHyprRenderer->damageBox(expandBox);
+    }
 
-        PMONITOR = g_pCompositor->getMonitorFromVector(PLAYER->m_realPosition->goal() + PLAYER->m_realSize->goal() / 2.F);
-        if (!PMONITOR)
-            return;
-        animationsDisabled = animationsDisabled || PLAYER->m_noAnimations;
+    if (m_tick.workspaces.empty())
+        return;
+
+    if (!after) {
+        // dont damage the whole monitor on workspace change, unless it's a special workspace, because dim/blur etc
+        for (auto const& [_, entry] : m_tick.workspaces) {
+            if (entry.first->m_isSpecialWorkspace)
+                g_pHyprRenderer->damageMonitor(entry.second.monitor);
+        }
     }
 
-    const auto SPENT   = av.getPercent();
-    const auto PBEZIER = g_pAnimationManager->getBezier(av.getBezierName());
-    const auto POINTY  = PBEZIER->getYForPoint(SPENT);
-    const bool WARP    = animationsDisabled || SPENT >= 1.f;
+    // one walk over the windows for every animating workspace
+    for (auto const& w : g_pCompositor->m_windows) {
+        const auto IT = m_tick.workspaces.find(w->m_workspace.get());
+        if (IT == m_tick.workspaces.end())
+            continue;
 
-    if constexpr (std::same_as<VarType, CHyprColor>)
-        updateColorVariable(av, POINTY, WARP);
-    else
-        updateVariable<VarType>(av, POINTY, WARP);
+        auto const& [PWORKSPACE, DAMAGE] = IT->second;
 
-    av.onUpdate();
+        if (after) {
+            if (!(DAMAGE.after & policyBit(AVARDAMAGE_ENTIRE)) || !validMapped(w))
+                continue;
 
-    switch (av.m_Context.eDamagePolicy) {
-        case AVARDAMAGE_ENTIRE: {
-            if (PWINDOW) {
-                PWINDOW->updateWindowDecos();
-                g_pHyprRenderer->damageWindow(PWINDOW);
-            } else if (PWORKSPACE) {
-                for (auto const& w : g_pCompositor->m_windows) {
-                    if (!validMapped(w) || w->m_workspace != PWORKSPACE)
-                        continue;
+            w->updateWindowDecos();
 
-                    w->updateWindowDecos();
+            // damage any workspace window that is on any monitor
+            if (!w->m_pinned)
+                g_pHyprRenderer->damageWindow(w);
 
-                    // damage any workspace window that is on any monitor
-                    if (!w->m_pinned)
-                        g_pHyprRenderer->damageWindow(w);
-                }
-            } else if (PLAYER) {
-                if (PLAYER->m_layer <= 1)
-                    g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
-
-                // some fucking layers miss 1 pixel???
-                CBox expandBox = CBox{PLAYER->m_realPosition->value(), PLAYER->m_realSize->value()};
-                expandBox.expand(5);
-                g_pHyprRenderer->damageBox(expandBox);
-            }
-            break;
+            continue;
         }
-        case AVARDAMAGE_BORDER: {
-            RASSERT(PWINDOW, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
 
-            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_BORDER);
-            PDECO->damageEntire();
+        // TODO: just make this into a damn callback already vax...
+        if (w->m_isMapped && !w->isHidden()) {
+            if (w->m_isFloating && !w->m_pinned) {
+                // still doing the full damage hack for floating because sometimes when the window
+                // goes through multiple monitors the last rendered frame is missing damage somehow??
+                const CBox windowBoxNoOffset = w->getFullWindowBoundingBox();
+                const CBox monitorBox        = {DAMAGE.monitor->vecPosition, DAMAGE.monitor->vecSize};
+                if (windowBoxNoOffset.intersection(monitorBox) != windowBoxNoOffset) // on edges between multiple monitors
+                    g_pHyprRenderer->damageWindow(w, true);
+            }
 
-            break;
+            if (PWORKSPACE->m_isSpecialWorkspace)
+                g_pHyprRenderer->damageWindow(w, true); // hack for special too because it can cross multiple monitors
         }
-        case AVARDAMAGE_SHADOW: {
-            RASSERT(PWINDOW, "Tried to AVARDAMAGE_SHADOW a non-window AVAR!");
 
-            const auto PDECO = PWINDOW->getDecorationByType(DECORATION_SHADOW);
+        // damage any workspace window that is on any monitor
+        if (validMapped(w) && !w->m_pinned)
+            g_pHyprRenderer->damageWindow(w);
+    }
+}
 
-            PDECO->damageEntire();
+template <Animable VarType>
+void CHyprAnimationManager::apply(std::vector<STickEntry<VarType>>& entries) {
+    const auto SAMPLE = [](STickEntry<VarType>& e) {
+        const float POS = std::clamp(e.x, 0.F, 1.F) * CURVE_LUT_SIZE;
+        const auto  IDX = std::min((size_t)POS, CURVE_LUT_SIZE - 1);
+        const auto& LUT = e.curve->lut;
+        e.y             = LUT[IDX] + (LUT[IDX + 1] - LUT[IDX]) * (POS - IDX);
+    };
 
-            break;
-        }
-        default: {
-            break;
-        }
+    // curves first, in one pass over contiguous entries
+    for (auto& e : entries) {
+        SAMPLE(e);
     }
 
-    // manually schedule a frame
-    if (PMONITOR)
-        g_pCompositor->scheduleFrameForMonitor(PMONITOR, Aquamarine::IOutput::AQ_SCHEDULE_ANIMATION);
+    for (auto& e : entries) {
+        // an earlier variable's callback can have warped this one already
+        if (!e.av->isBeingAnimated())
+            continue;
+
+        // or restarted it, then the progress taken in collect() belongs to the old animation
+        if (!(e.av->begun() == e.begun) || !(e.av->goal() == e.goal)) {
+            e.curve = curveFor(e.av->getBezierName());
+            e.x     = e.av->getPercent();
+            e.warp  = e.noAnim || e.x >= 1.F;
+            SAMPLE(e);
+        }
+
+        if constexpr (std::same_as<VarType, CHyprColor>)
+            updateColorVariable(*e.av, e.y, e.warp);
+        else
+            updateVariable<VarType>(*e.av, e.y, e.warp);
+
+        e.av->onUpdate();
+    }
 }
 
 void CHyprAnimationManager::tick() {
@@ -218,37 +294,62 @@ void CHyprAnimationManager::tick() {
 
     static auto PANIMENABLED = CConfigValue<Hyprlang::INT>("animations:enabled");
 
-    for (size_t i = 0; i < m_vActiveAnimatedVariables.size(); i++) {
-        const auto PAV = m_vActiveAnimatedVariables[i].lock();
+    const auto  TICKSTART = Time::steadyNow();
+
+    // callbacks can (dis)connect variables while we go, work on what's active now. Anything
+    // connected meanwhile gets its first update next tick.
+    for (auto const& wav : m_vActiveAnimatedVariables) {
+        const auto PAV = wav.lock();
         if (!PAV)
             continue;
 
         // for disabled anims just warp
         bool warp = !*PANIMENABLED || !PAV->enabled();
 
+        // m_Type is what the variable was created as, no need to dynamic_cast
         switch (PAV->m_Type) {
-            case AVARTYPE_FLOAT: {
-                auto pTypedAV = dynamic_cast<CAnimatedVariable<float>*>(PAV.get());
-                RASSERT(pTypedAV, "Failed to upcast animated float");
-                handleUpdate(*pTypedAV, warp);
-            } break;
-            case AVARTYPE_VECTOR: {
-                auto pTypedAV = dynamic_cast<CAnimatedVariable<Vector2D>*>(PAV.get());
-                RASSERT(pTypedAV, "Failed to upcast animated Vector2D");
-                handleUpdate(*pTypedAV, warp);
-            } break;
-            case AVARTYPE_COLOR: {
-                auto pTypedAV = dynamic_cast<CAnimatedVariable<CHyprColor>*>(PAV.get());
-                RASSERT(pTypedAV, "Failed to upcast animated CHyprColor");
-                handleUpdate(*pTypedAV, warp);
-            } break;
+            case AVARTYPE_FLOAT: collect(static_cast<CAnimatedVariable<float>&>(*PAV), warp, m_tick.floats); break;
+            case AVARTYPE_VECTOR: collect(static_cast<CAnimatedVariable<Vector2D>&>(*PAV), warp, m_tick.vectors); break;
+            case AVARTYPE_COLOR: collect(static_cast<CAnimatedVariable<CHyprColor>&>(*PAV), warp, m_tick.colors); break;
             default: UNREACHABLE();
         }
+
+        m_tick.alive.emplace_back(PAV);
     }
 
+    damageOwners(false);
+
+    apply(m_tick.floats);
+    apply(m_tick.vectors);
+    apply(m_tick.colors);
+
+    damageOwners(true);
+
+    // manually schedule a frame
+    for (auto const& m : m_tick.monitors) {
+        g_pCompositor->scheduleFrameForMonitor(m, Aquamarine::IOutput::AQ_SCHEDULE_ANIMATION);
+    }
+
+    m_tickStats.vars   = m_tick.floats.size() + m_tick.vectors.size() + m_tick.colors.size();
+    m_tickStats.costUs = std::chrono::duration_cast<std::chrono::duration<float, std::micro>>(Time::steadyNow() - TICKSTART).count();
+
+    // clear() keeps the capacity around for the next tick
+    m_tick.floats.clear();
+    m_tick.vectors.clear();
+    m_tick.colors.clear();
+    m_tick.windows.clear();
+    m_tick.workspaces.clear();
+    m_tick.layers.clear();
+    m_tick.monitors.clear();
+    m_tick.alive.clear();
+
     tickDone();
 }
 
+const CHyprAnimationManager::STickStats& CHyprAnimationManager::getTickStats() {
+    return m_tickStats;
+}
+
 void CHyprAnimationManager::scheduleTick() {
     if (m_bTickScheduled)
         return;
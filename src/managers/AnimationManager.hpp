@@ -3,6 +3,10 @@
 #include <hyprutils/animation/AnimationManager.hpp>
 #include <hyprutils/animation/AnimatedVariable.hpp>
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include "../defines.hpp"
 #include "../helpers/AnimatedVariable.hpp"
 #include "../desktop/DesktopTypes.hpp"
@@ -49,6 +53,13 @@ class CHyprAnimationManager : public Hyprutils::Animation::CAnimationManager {
 
     std::string         styleValidInConfigVar(const std::string&, const std::string&);
 
+    struct STickStats {
+        size_t vars   = 0; // updated in the last tick
+        float  costUs = 0; // spent in it
+    };
+
+    const STickStats&   getTickStats();
+
     SP<CEventLoopTimer> m_pAnimationTimer;
 
     float               m_fLastTickTime; // in ms
@@ -56,6 +67,60 @@ class CHyprAnimationManager : public Hyprutils::Animation::CAnimationManager {
   private:
     bool m_bTickScheduled = false;
 
+    /*
+        A tick runs in phases over all active variables at once, instead of one variable at a time:
+        sort them into per-type arrays with their curve resolved, damage every owner (window, workspace,
+        layer) once, evaluate all curves, apply the values, then damage owners again and schedule each
+        monitor once. Damaging a workspace walks the windows once for all animating workspaces.
+    */
+
+    static constexpr size_t CURVE_LUT_SIZE = 256;
+
+    // a bezier sampled at uniform x, so evaluating it is a lookup and a lerp
+    struct SCurve {
+        WP<Hyprutils::Animation::CBezierCurve> source; // expires when the bezier is redefined
+        std::array<float, CURVE_LUT_SIZE + 1>  lut = {};
+    };
+
+    template <Animable VarType>
+    struct STickEntry {
+        CAnimatedVariable<VarType>* av     = nullptr;
+        const SCurve*               curve  = nullptr;
+        float                       x      = 0; // progress
+        float                       y      = 0; // curve at x
+        bool                        warp   = false;
+        bool                        noAnim = false;
+        VarType                     begun, goal; // what x was taken for, callbacks can retarget before the apply
+    };
+
+    // eAVarDamagePolicy bits, before and after the update
+    struct SOwnerDamage {
+        PHLMONITOR monitor;
+        uint8_t    before = 0, after = 0;
+    };
+
+    struct {
+        std::vector<STickEntry<float>>                                         floats;
+        std::vector<STickEntry<Vector2D>>                                      vectors;
+        std::vector<STickEntry<CHyprColor>>                                    colors;
+        std::vector<SP<Hyprutils::Animation::CBaseAnimatedVariable>>           alive;
+
+        std::unordered_map<CWindow*, std::pair<PHLWINDOW, SOwnerDamage>>       windows;
+        std::unordered_map<CWorkspace*, std::pair<PHLWORKSPACE, SOwnerDamage>> workspaces;
+        std::unordered_map<CLayerSurface*, std::pair<PHLLS, SOwnerDamage>>     layers;
+        std::vector<PHLMONITOR>                                                monitors;
+    } m_tick;
+
+    std::unordered_map<std::string, SCurve> m_curves;
+    STickStats                              m_tickStats;
+
+    const SCurve*                           curveFor(const std::string& bezier);
+    template <Animable VarType>
+    void collect(CAnimatedVariable<VarType>& av, bool warp, std::vector<STickEntry<VarType>>& out);
+    template <Animable VarType>
+    void apply(std::vector<STickEntry<VarType>>& entries);
+    void damageOwners(bool after);
+
     // Anim stuff
     void animationPopin(PHLWINDOW, bool close = false, float minPerc = 0.f);
     void animationSlide(PHLWINDOW, std::string force = "", bool close = false);
@@ -2,6 +2,8 @@
 #include "../Compositor.hpp"
 
 #include <algorithm>
+#include <array>
+#include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
@@ -9,7 +11,36 @@
 #include <sys/un.h>
 #include <unistd.h>
 #include <cstring>
+#include <unordered_map>
+#include <hyprutils/string/VarList.hpp>
 using namespace Hyprutils::OS;
+using namespace Hyprutils::String;
+
+// state events: a newer one makes an older queued one pointless. The value says whether the first
+// field of the data identifies the object the state belongs to (e.g. the window of windowtitle).
+static const std::unordered_map<std::string, bool> COALESCABLE_EVENTS = {
+    {"activewindow", false},   //
+    {"activewindowv2", false}, //
+    {"workspace", false},      //
+    {"workspacev2", false},    //
+    {"focusedmon", false},     //
+    {"focusedmonv2", false},   //
+    {"submap", false},         //
+    {"windowtitle", true},     //
+    {"windowtitlev2", true},   //
+    {"activelayout", true},    //
+};
+
+static std::string coalesceKeyFor(const SHyprIPCEvent& event) {
+    const auto IT = COALESCABLE_EVENTS.find(event.event);
+    if (IT == COALESCABLE_EVENTS.end())
+        return "";
+
+    if (!IT->second)
+        return event.event;
+
+    return event.event + ">>" + event.data.substr(0, event.data.find(','));
+}
 
 CEventManager::CEventManager() : m_iSocketFD(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) {
     if (!m_iSocketFD.isValid()) {
@@ -84,12 +115,11 @@ int CEventManager::onServerEvent(int fd, uint32_t mask) {
 
     Debug::log(LOG, "Socket2 accepted a new client at FD {}", ACCEPTEDCONNECTION.get());
 
-    // add to event loop so we can close it when we need to
-    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), 0, onServerEvent, nullptr);
+    // add to event loop so we can read subscriptions and close it when we need to
+    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
     m_vClients.emplace_back(SClient{
-        std::move(ACCEPTEDCONNECTION),
-        {},
-        eventSource,
+        .fd          = std::move(ACCEPTEDCONNECTION),
+        .eventSource = eventSource,
     });
 
     return 0;
@@ -102,24 +132,162 @@ int CEventManager::onClientEvent(int fd, uint32_t mask) {
         return 0;
     }
 
+    const auto CLIENTIT = findClientByFD(fd);
+    if (CLIENTIT == m_vClients.end())
+        return 0;
+
+    if (mask & WL_EVENT_READABLE) {
+        std::array<char, 1024> buffer;
+
+        while (true) {
+            const auto LEN = read(fd, buffer.data(), buffer.size());
+
+            if (LEN > 0) {
+                CLIENTIT->readBuffer.append(buffer.data(), LEN);
+                continue;
+            }
+
+            if (LEN == 0) {
+                // the client shut down its writing side (e.g. socat -u), it still wants events though.
+                CLIENTIT->readClosed = true;
+                updateClientMask(*CLIENTIT);
+            }
+
+            break;
+        }
+
+        size_t pos = 0;
+        while ((pos = CLIENTIT->readBuffer.find('\n')) != std::string::npos) {
+            handleClientCommand(*CLIENTIT, CLIENTIT->readBuffer.substr(0, pos));
+            CLIENTIT->readBuffer.erase(0, pos + 1);
+        }
+
+        if (CLIENTIT->readBuffer.size() > 4096) {
+            Debug::log(ERR, "Socket2 fd {} sent an oversized command, removing", fd);
+            removeClientByFD(fd);
+            return 0;
+        }
+    }
+
     if (mask & WL_EVENT_WRITABLE) {
-        const auto CLIENTIT = findClientByFD(fd);
+        if (!flushClient(*CLIENTIT)) {
+            removeClientByFD(fd);
+            return 0;
+        }
+    }
 
-        // send all queued events
-        while (!CLIENTIT->events.empty()) {
-            const auto& event = CLIENTIT->events.front();
-            if (write(CLIENTIT->fd.get(), event->c_str(), event->length()) < 0)
+    return 0;
+}
+
+bool CEventManager::SClient::wants(const std::string& event) const {
+    return subscriptions.empty() || subscriptions.contains(event);
+}
+
+void CEventManager::handleClientCommand(SClient& client, const std::string& command) {
+    if (command.starts_with("subscribe ")) {
+        CVarList events(command.substr(10), 0, ',');
+
+        client.subscriptions.clear();
+        for (auto const& e : events) {
+            if (e == "*") {
+                client.subscriptions.clear();
                 break;
+            }
 
-            CLIENTIT->events.erase(CLIENTIT->events.begin());
+            client.subscriptions.emplace(e);
         }
 
-        // stop polling when we sent all events
-        if (CLIENTIT->events.empty())
-            wl_event_source_fd_update(CLIENTIT->eventSource, 0);
+        Debug::log(LOG, "Socket2 fd {} subscribed to {}", client.fd.get(), client.subscriptions.empty() ? "everything" : command.substr(10));
+    } else if (command == "framing binary")
+        client.binaryFraming = true;
+    else if (command == "framing text")
+        client.binaryFraming = false;
+    else
+        Debug::log(WARN, "Socket2 fd {} sent an unknown command: {}", client.fd.get(), command);
+}
+
+void CEventManager::updateClientMask(SClient& client) {
+    wl_event_source_fd_update(client.eventSource, (client.readClosed ? 0 : WL_EVENT_READABLE) | (client.events.empty() ? 0 : WL_EVENT_WRITABLE));
+}
+
+// queued in place of events a slow client missed, carries how many
+static const std::string DROPPED_EVENTS_KEY = "eventsdropped";
+
+bool CEventManager::enqueueEvent(SClient& client, const SP<std::string>& data, const std::string& coalesceKey) {
+    const size_t MAX_QUEUED_EVENTS = 1024;
+    // only a client that can't keep up even with events being dropped gets disconnected
+    const size_t MAX_QUEUED_BYTES = 16 * 1024 * 1024;
+
+    if (!coalesceKey.empty()) {
+        // drop a superseded state event, unless we already started writing it
+        const auto IT = std::ranges::find_if(client.events, [&coalesceKey](const auto& e) { return e.sent == 0 && e.coalesceKey == coalesceKey; });
+        if (IT != client.events.end()) {
+            client.queuedBytes -= IT->data->length();
+            client.events.erase(IT);
+        }
     }
 
-    return 0;
+    if (client.events.size() >= MAX_QUEUED_EVENTS)
+        dropOldestEvent(client);
+
+    client.events.emplace_back(SQueuedEvent{.data = data, .coalesceKey = coalesceKey});
+    client.queuedBytes += data->length();
+
+    return client.queuedBytes <= MAX_QUEUED_BYTES;
+}
+
+void CEventManager::dropOldestEvent(SClient& client) {
+    // the front may be half written, that one has to go out whole
+    const auto IT = std::ranges::find_if(client.events, [](const auto& e) { return e.sent == 0 && e.coalesceKey != DROPPED_EVENTS_KEY; });
+    if (IT == client.events.end())
+        return;
+
+    client.queuedBytes -= IT->data->length();
+    client.events.erase(IT);
+
+    // one notice for a run of drops, replaced while it's still unsent
+    auto notice = std::ranges::find_if(client.events, [](const auto& e) { return e.sent == 0 && e.coalesceKey == DROPPED_EVENTS_KEY; });
+    if (notice == client.events.end()) {
+        const auto FIRSTUNSENT = std::ranges::find_if(client.events, [](const auto& e) { return e.sent == 0; });
+        notice                 = client.events.emplace(FIRSTUNSENT, SQueuedEvent{.data = makeShared<std::string>(), .coalesceKey = DROPPED_EVENTS_KEY});
+        client.droppedEvents   = 0;
+    }
+
+    client.droppedEvents++;
+
+    const SHyprIPCEvent EVENT{.event = DROPPED_EVENTS_KEY, .data = std::to_string(client.droppedEvents)};
+    client.queuedBytes -= notice->data->length();
+    notice->data = makeShared<std::string>(client.binaryFraming ? formatEventBinary(EVENT) : formatEvent(EVENT));
+    client.queuedBytes += notice->data->length();
+}
+
+bool CEventManager::flushClient(SClient& client) {
+    // send all queued events
+    while (!client.events.empty()) {
+        auto&      event = client.events.front();
+        const auto LEN   = write(client.fd.get(), event.data->c_str() + event.sent, event.data->length() - event.sent);
+
+        if (LEN < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                break;
+
+            Debug::log(ERR, "Socket2 fd {} write failed, errno: {}", client.fd.get(), errno);
+            return false;
+        }
+
+        event.sent += LEN;
+
+        if (event.sent < event.data->length())
+            break;
+
+        client.queuedBytes -= event.data->length();
+        client.events.pop_front();
+    }
+
+    // stop polling for write when we sent all events
+    updateClientMask(client);
+
+    return true;
 }
 
 std::vector<CEventManager::SClient>::iterator CEventManager::findClientByFD(int fd) {
@@ -140,33 +308,77 @@ std::string CEventManager::formatEvent(const SHyprIPCEvent& event) const {
     return eventString;
 }
 
+std::string CEventManager::formatEventBinary(const SHyprIPCEvent& event) const {
+    const uint32_t LEN = htonl((uint32_t)(event.event.length() + 2 + event.data.length()));
+
+    std::string    eventString;
+    eventString.reserve(sizeof(LEN) + event.event.length() + 2 + event.data.length());
+    eventString.append((const char*)&LEN, sizeof(LEN));
+    eventString += event.event;
+    eventString += ">>";
+    eventString += event.data;
+    return eventString;
+}
+
 void CEventManager::postEvent(const SHyprIPCEvent& event) {
     if (g_pCompositor->m_isShuttingDown) {
         Debug::log(WARN, "Suppressed (shutting down) event of type {}, content: {}", event.event, event.data);
         return;
     }
 
-    const size_t MAX_QUEUED_EVENTS = 64;
-    auto         sharedEvent       = makeShared<std::string>(formatEvent(event));
+    // only format what someone is subscribed to
+    SP<std::string> textEvent, binaryEvent;
+    std::string     coalesceKey;
+    bool            keyResolved = false;
+
     for (auto it = m_vClients.begin(); it != m_vClients.end();) {
+        if (!it->wants(event.event)) {
+            ++it;
+            continue;
+        }
+
+        auto& sharedEvent = it->binaryFraming ? binaryEvent : textEvent;
+        if (!sharedEvent)
+            sharedEvent = makeShared<std::string>(it->binaryFraming ? formatEventBinary(event) : formatEvent(event));
+
         // try to send the event immediately if the queue is empty
-        const auto QUEUESIZE = it->events.size();
-        if (QUEUESIZE > 0 || write(it->fd.get(), sharedEvent->c_str(), sharedEvent->length()) < 0) {
-            if (QUEUESIZE >= MAX_QUEUED_EVENTS) {
-                // too many events queued, remove the client
-                Debug::log(ERR, "Socket2 fd {} overflowed event queue, removing", it->fd.get());
-                it = removeClientByFD(it->fd.get());
+        if (it->events.empty()) {
+            const auto LEN = write(it->fd.get(), sharedEvent->c_str(), sharedEvent->length());
+
+            if (LEN == (ssize_t)sharedEvent->length()) {
+                ++it;
                 continue;
             }
 
-            // queue it to send later if failed
-            it->events.push_back(sharedEvent);
+            if (LEN > 0) {
+                // partial write, the rest has to go out before anything else
+                it->events.emplace_back(SQueuedEvent{.data = sharedEvent, .sent = (size_t)LEN});
+                it->queuedBytes += sharedEvent->length();
+                updateClientMask(*it);
+                ++it;
+                continue;
+            }
+        }
 
-            // poll for write if queue was empty
-            if (QUEUESIZE == 0)
-                wl_event_source_fd_update(it->eventSource, WL_EVENT_WRITABLE);
+        if (!keyResolved) {
+            coalesceKey = coalesceKeyFor(event);
+            keyResolved = true;
         }
 
+        const bool WASEMPTY = it->events.empty();
+
+        // queue it to send later if failed
+        if (!enqueueEvent(*it, sharedEvent, coalesceKey)) {
+            // too much queued even after dropping events, remove the client
+            Debug::log(ERR, "Socket2 fd {} overflowed event queue, removing", it->fd.get());
+            it = removeClientByFD(it->fd.get());
+            continue;
+        }
+
+        // poll for write if queue was empty
+        if (WASEMPTY)
+            updateClientMask(*it);
+
         ++it;
     }
 }
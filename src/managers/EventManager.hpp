@@ -1,4 +1,6 @@
 #pragma once
+#include <deque>
+#include <unordered_set>
 #include <vector>
 #include <hyprutils/os/FileDescriptor.hpp>
 #include "../defines.hpp"
@@ -18,6 +20,7 @@ class CEventManager {
 
   private:
     std::string formatEvent(const SHyprIPCEvent& event) const;
+    std::string formatEventBinary(const SHyprIPCEvent& event) const;
 
     static int  onServerEvent(int fd, uint32_t mask, void* data);
     static int  onClientEvent(int fd, uint32_t mask, void* data);
@@ -25,15 +28,48 @@ class CEventManager {
     int         onServerEvent(int fd, uint32_t mask);
     int         onClientEvent(int fd, uint32_t mask);
 
+    struct SQueuedEvent {
+        SP<std::string> data;
+        // events with the same non-empty key supersede each other while still queued
+        std::string coalesceKey;
+        size_t      sent = 0;
+    };
+
+    /*
+        Clients may write newline-terminated commands to the socket:
+         - "subscribe <event>,<event>,..." only sends the listed events. "subscribe *" sends everything again.
+         - "framing binary" sends every event as a 4-byte big-endian length followed by "<event>>><data>",
+           without truncating or stripping newlines from the data. "framing text" restores the default.
+
+        A client that falls too far behind gets "eventsdropped>>N" in place of the N oldest events it missed.
+    */
     struct SClient {
-        Hyprutils::OS::CFileDescriptor fd;
-        std::vector<SP<std::string>>   events;
-        wl_event_source*               eventSource = nullptr;
+        Hyprutils::OS::CFileDescriptor  fd;
+        std::deque<SQueuedEvent>        events;
+        wl_event_source*                eventSource = nullptr;
+
+        std::string                     readBuffer;
+        bool                            readClosed = false;
+        std::unordered_set<std::string> subscriptions; // empty means everything
+        bool                            binaryFraming = false;
+
+        size_t                          queuedBytes   = 0;
+        size_t                          droppedEvents = 0; // reported by the eventsdropped notice still queued, if any
+
+        bool                            wants(const std::string& event) const;
     };
 
     std::vector<SClient>::iterator findClientByFD(int fd);
     std::vector<SClient>::iterator removeClientByFD(int fd);
 
+    void                           handleClientCommand(SClient& client, const std::string& command);
+    void                           updateClientMask(SClient& client);
+    // past the event limit the oldest unsent events are dropped, returns false if the client still overflowed and should be removed
+    bool enqueueEvent(SClient& client, const SP<std::string>& data, const std::string& coalesceKey);
+    void dropOldestEvent(SClient& client);
+    // returns false on a write error
+    bool flushClient(SClient& client);
+
   private:
     Hyprutils::OS::CFileDescriptor m_iSocketFD;
     wl_event_source*               m_pEventSource = nullptr;
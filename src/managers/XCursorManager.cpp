@@ -11,7 +11,6 @@ extern "C" {
 #include <gio/gio.h>
 #include <gio/gsettingsschema.h>
 #include "config/ConfigValue.hpp"
-#include "helpers/CursorShapes.hpp"
 #include "../managers/CursorManager.hpp"
 #include "debug/Log.hpp"
 #include "XCursorManager.hpp"
@@ -96,6 +95,9 @@ static std::vector<uint32_t> HYPR_XCURSOR_PIXELS = {
     0x00000000, 0x00000000};
 // clang-format on
 
+// decoded shapes kept around, a few sizes' worth of a full theme
+constexpr size_t MAX_CACHED_SHAPES = 128;
+
 CXCursorManager::CXCursorManager() {
     hyprCursor = makeShared<SXCursors>();
     SXCursorImage image;
@@ -106,81 +108,94 @@ CXCursorManager::CXCursorManager() {
 
     hyprCursor->images.push_back(image);
     hyprCursor->shape = "left_ptr";
-    defaultCursor     = hyprCursor;
 }
 
 void CXCursorManager::loadTheme(std::string const& name, int size, float scale) {
-    if (lastLoadSize == (size * std::ceil(scale)) && themeName == name && lastLoadScale == scale)
+    const auto THEME = name.empty() ? "default" : name;
+
+    if (lastLoadSize == (size * std::ceil(scale)) && themeName == THEME && lastLoadScale == scale)
         return;
 
     lastLoadSize  = size * std::ceil(scale);
     lastLoadScale = scale;
-    themeName     = name.empty() ? "default" : name;
-    defaultCursor.reset();
-    cursors.clear();
+    themeName     = THEME;
 
-    auto paths = themePaths(themeName);
-    if (paths.empty()) {
-        Debug::log(ERR, "XCursor librarypath is empty loading standard XCursors");
-        cursors = loadStandardCursors(themeName, lastLoadSize);
-    } else {
-        for (auto const& p : paths) {
-            try {
-                auto dirCursors = loadAllFromDir(p, lastLoadSize);
-                std::copy_if(dirCursors.begin(), dirCursors.end(), std::back_inserter(cursors),
-                             [this](auto const& p) { return std::none_of(cursors.begin(), cursors.end(), [&p](auto const& dp) { return dp->shape == p->shape; }); });
-            } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be loaded: threw error {}", p, e.what()); }
-        }
-    }
+    // shapes are decoded on first use, only walk the theme's directories here, off the main thread
+    if (!themes.contains(themeName) && !pendingThemes.contains(themeName))
+        pendingThemes.emplace(themeName, std::async(std::launch::async, &CXCursorManager::indexTheme, themeName));
 
-    if (cursors.empty()) {
-        Debug::log(ERR, "XCursor failed finding any shapes in theme \"{}\".", themeName);
-        defaultCursor = hyprCursor;
-        return;
+    syncGsettings();
+}
+
+SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
+    const int PIXELSIZE = size * std::ceil(scale);
+
+    if (auto cursor = cachedShape(themeName, shape, PIXELSIZE))
+        return cursor;
+
+    Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
+    return defaultShape(themeName, PIXELSIZE);
+}
+
+CXCursorManager::SThemeIndex& CXCursorManager::indexFor(std::string const& theme) {
+    if (auto it = themes.find(theme); it != themes.end())
+        return it->second;
+
+    if (auto it = pendingThemes.find(theme); it != pendingThemes.end()) {
+        auto& index = themes[theme] = it->second.get();
+        pendingThemes.erase(it);
+        return index;
     }
 
-    for (auto const& shape : CURSOR_SHAPE_NAMES) {
-        auto legacyName = getLegacyShapeName(shape);
-        if (legacyName.empty())
-            continue;
+    return themes[theme] = indexTheme(theme);
+}
+
+SP<SXCursors> CXCursorManager::cachedShape(std::string const& theme, std::string const& shape, int size) {
+    const auto KEY = std::format("{}/{}@{}", theme, shape, size);
 
-        auto it = std::find_if(cursors.begin(), cursors.end(), [&legacyName](auto const& c) { return c->shape == legacyName; });
+    if (auto it = cacheLookup.find(KEY); it != cacheLookup.end()) {
+        cache.splice(cache.begin(), cache, it->second);
+        return it->second->cursor;
+    }
 
-        if (it == cursors.end()) {
-            Debug::log(LOG, "XCursor failed to find a legacy shape with name {}, skipping", legacyName);
-            continue;
-        }
+    const auto& INDEX  = indexFor(theme);
+    auto        cursor = loadShape(INDEX, theme, shape, size);
 
-        if (std::any_of(cursors.begin(), cursors.end(), [&shape](auto const& dp) { return dp->shape == shape; })) {
-            Debug::log(LOG, "XCursor already has a shape {} loaded, skipping", shape);
-            continue;
+    // css names fall back to the legacy x11 ones
+    if (!cursor) {
+        if (const auto LEGACY = getLegacyShapeName(shape); !LEGACY.empty()) {
+            if (const auto LEGACYCURSOR = loadShape(INDEX, theme, LEGACY, size)) {
+                cursor         = makeShared<SXCursors>();
+                cursor->images = LEGACYCURSOR->images;
+                cursor->shape  = shape;
+            }
         }
+    }
 
-        auto cursor    = makeShared<SXCursors>();
-        cursor->images = it->get()->images;
-        cursor->shape  = shape;
+    cache.emplace_front(SCachedShape{KEY, cursor});
+    cacheLookup[KEY] = cache.begin();
 
-        cursors.emplace_back(cursor);
+    if (cache.size() > MAX_CACHED_SHAPES) {
+        cacheLookup.erase(cache.back().key);
+        cache.pop_back();
     }
 
-    syncGsettings();
+    return cursor;
 }
 
-SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
-    // monitor scaling changed etc, so reload theme with new size.
-    if ((size * std::ceil(scale)) != lastLoadSize || scale != lastLoadScale)
-        loadTheme(themeName, size, scale);
-
-    // try to get an icon we know if we have one
-    for (auto const& c : cursors) {
-        if (c->shape != shape)
-            continue;
+SP<SXCursors> CXCursorManager::defaultShape(std::string const& theme, int size) {
+    for (auto const& shape : {"left_ptr", "arrow"}) {
+        if (auto cursor = cachedShape(theme, shape, size))
+            return cursor;
+    }
 
-        return c;
+    // broken theme.. just use whatever it has.
+    if (const auto& INDEX = indexFor(theme); !INDEX.firstShape.empty()) {
+        if (auto cursor = cachedShape(theme, INDEX.firstShape, size))
+            return cursor;
     }
 
-    Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
-    return defaultCursor;
+    return hyprCursor;
 }
 
 SP<SXCursors> CXCursorManager::createCursor(std::string const& shape, void* ximages) {
@@ -483,86 +498,92 @@ static std::array<const char*, 77> XCURSOR_STANDARD_NAMES = {
 };
 // clang-format on
 
-std::vector<SP<SXCursors>> CXCursorManager::loadStandardCursors(std::string const& name, int size) {
-    std::vector<SP<SXCursors>> newCursors;
+CXCursorManager::SThemeIndex CXCursorManager::indexTheme(std::string const& theme) {
+    SThemeIndex index;
 
-    // load the default xcursor shapes that exist in the theme
-    for (size_t i = 0; i < XCURSOR_STANDARD_NAMES.size(); ++i) {
-        std::string shape{XCURSOR_STANDARD_NAMES[i]};
-        auto        xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), size);
+    auto        paths = themePaths(theme);
+    if (paths.empty()) {
+        Debug::log(ERR, "XCursor librarypath is empty loading standard XCursors");
+        index.standard   = true;
+        index.firstShape = XCURSOR_STANDARD_NAMES.front();
+        return index;
+    }
 
-        if (!xImages) {
-            Debug::log(WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
-            xImages = XcursorShapeLoadImages(i << 1 /* wtf xcursor? */, name.c_str(), 24);
+    for (auto const& path : paths) {
+        try {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                std::error_code e1, e2;
+                if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
+                    Debug::log(WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
+                    continue;
+                }
 
-            if (!xImages) {
-                Debug::log(WARN, "XCursor failed to find a shape with name {}, skipping", shape);
-                continue;
+                // the first path that has a shape wins
+                const auto SHAPE = entry.path().filename().string();
+                if (index.files.try_emplace(SHAPE, entry.path().string()).second && index.firstShape.empty())
+                    index.firstShape = SHAPE;
             }
-        }
-
-        auto cursor = createCursor(shape, xImages);
-        newCursors.emplace_back(cursor);
-
-        if (!defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-            defaultCursor = cursor;
-
-        XcursorImagesDestroy(xImages);
+        } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be loaded: threw error {}", path, e.what()); }
     }
 
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !defaultCursor)
-        defaultCursor = newCursors.front();
+    if (index.files.empty())
+        Debug::log(ERR, "XCursor failed finding any shapes in theme \"{}\".", theme);
+    else
+        Debug::log(LOG, "XCursor indexed {} shapes in theme \"{}\"", index.files.size(), theme);
 
-    return newCursors;
+    return index;
 }
 
-std::vector<SP<SXCursors>> CXCursorManager::loadAllFromDir(std::string const& path, int size) {
-    std::vector<SP<SXCursors>> newCursors;
+SP<SXCursors> CXCursorManager::loadShape(SThemeIndex const& index, std::string const& theme, std::string const& shape, int size) {
+    XcursorImages* xImages = nullptr;
 
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path)) {
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            std::error_code e1, e2;
-            if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
-                Debug::log(WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
-                continue;
-            }
+    if (index.standard) {
+        const auto IT = std::ranges::find(XCURSOR_STANDARD_NAMES, shape);
+        if (IT == XCURSOR_STANDARD_NAMES.end())
+            return nullptr;
 
-            auto const& full = entry.path().string();
-            using PcloseType = int (*)(FILE*);
-            const std::unique_ptr<FILE, PcloseType> f(fopen(full.c_str(), "r"), static_cast<PcloseType>(fclose));
+        const auto ID = IT - XCURSOR_STANDARD_NAMES.begin();
 
-            if (!f)
-                continue;
+        xImages = XcursorShapeLoadImages(ID << 1 /* wtf xcursor? */, theme.c_str(), size);
 
-            auto xImages = XcursorFileLoadImages(f.get(), size);
+        if (!xImages) {
+            Debug::log(WARN, "XCursor failed to find a shape with name {}, trying size 24.", shape);
+            xImages = XcursorShapeLoadImages(ID << 1 /* wtf xcursor? */, theme.c_str(), 24);
 
             if (!xImages) {
-                Debug::log(WARN, "XCursor failed to load image {}, trying size 24.", full);
-                xImages = XcursorFileLoadImages(f.get(), 24);
-
-                if (!xImages) {
-                    Debug::log(WARN, "XCursor failed to load image {}, skipping", full);
-                    continue;
-                }
+                Debug::log(WARN, "XCursor failed to find a shape with name {}, skipping", shape);
+                return nullptr;
             }
+        }
+    } else {
+        const auto IT = index.files.find(shape);
+        if (IT == index.files.end())
+            return nullptr;
 
-            auto const& shape  = entry.path().filename().string();
-            auto        cursor = createCursor(shape, xImages);
-            newCursors.emplace_back(cursor);
+        auto const& full = IT->second;
+        using PcloseType = int (*)(FILE*);
+        const std::unique_ptr<FILE, PcloseType> f(fopen(full.c_str(), "r"), static_cast<PcloseType>(fclose));
 
-            if (!defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-                defaultCursor = cursor;
+        if (!f)
+            return nullptr;
 
-            XcursorImagesDestroy(xImages);
+        xImages = XcursorFileLoadImages(f.get(), size);
+
+        if (!xImages) {
+            Debug::log(WARN, "XCursor failed to load image {}, trying size 24.", full);
+            xImages = XcursorFileLoadImages(f.get(), 24);
+
+            if (!xImages) {
+                Debug::log(WARN, "XCursor failed to load image {}, skipping", full);
+                return nullptr;
+            }
         }
     }
 
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !defaultCursor)
-        defaultCursor = newCursors.front();
+    auto cursor = createCursor(shape, xImages);
+    XcursorImagesDestroy(xImages);
 
-    return newCursors;
+    return cursor;
 }
 
 void CXCursorManager::syncGsettings() {
@@ -2,6 +2,9 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <list>
+#include <future>
+#include <unordered_map>
 #include <array>
 #include <cstdint>
 #include <hyprutils/math/Vector2D.hpp>
@@ -30,16 +33,35 @@ class CXCursorManager {
     void          syncGsettings();
 
   private:
-    SP<SXCursors>              createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
-    std::set<std::string>      themePaths(std::string const& theme);
-    std::string                getLegacyShapeName(std::string const& shape);
-    std::vector<SP<SXCursors>> loadStandardCursors(std::string const& name, int size);
-    std::vector<SP<SXCursors>> loadAllFromDir(std::string const& path, int size);
-
-    int                        lastLoadSize  = 0;
-    float                      lastLoadScale = 0;
-    std::string                themeName     = "";
-    SP<SXCursors>              defaultCursor;
-    SP<SXCursors>              hyprCursor;
-    std::vector<SP<SXCursors>> cursors;
+    // where a theme's shapes live, without decoding any of them
+    struct SThemeIndex {
+        std::unordered_map<std::string, std::string> files; // shape -> file
+        std::string                                  firstShape;
+        bool                                         standard = false; // no theme paths, shapes come from libXcursor's standard set
+    };
+
+    struct SCachedShape {
+        std::string   key;
+        SP<SXCursors> cursor; // nullptr if the theme doesn't have it
+    };
+
+    SThemeIndex&                                                       indexFor(std::string const& theme);
+    SP<SXCursors>                                                      cachedShape(std::string const& theme, std::string const& shape, int size);
+    SP<SXCursors>                                                      loadShape(SThemeIndex const& index, std::string const& theme, std::string const& shape, int size);
+    SP<SXCursors>                                                      defaultShape(std::string const& theme, int size);
+    SP<SXCursors>                                                      createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
+    std::string                                                        getLegacyShapeName(std::string const& shape);
+
+    static SThemeIndex                                                 indexTheme(std::string const& theme);
+    static std::set<std::string>                                       themePaths(std::string const& theme);
+
+    int                                                                lastLoadSize  = 0;
+    float                                                              lastLoadScale = 0;
+    std::string                                                        themeName     = "";
+    SP<SXCursors>                                                      hyprCursor;
+
+    std::unordered_map<std::string, SThemeIndex>                       themes;
+    std::unordered_map<std::string, std::future<SThemeIndex>>          pendingThemes; // being indexed in the background
+    std::list<SCachedShape>                                            cache;         // most recently used first
+    std::unordered_map<std::string, std::list<SCachedShape>::iterator> cacheLookup;
 };
@@ -13,12 +13,12 @@
 #include <aquamarine/backend/Backend.hpp>
 using namespace Hyprutils::OS;
 
-#define TIMESPEC_NSEC_PER_SEC 1000000000L
-
 CEventLoopManager::CEventLoopManager(wl_display* display, wl_event_loop* wlEventLoop) {
     m_sTimers.timerfd  = CFileDescriptor{timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC)};
     m_sWayland.loop    = wlEventLoop;
     m_sWayland.display = display;
+
+    m_sTimerStats.windowStart = Time::steadyNow();
 }
 
 CEventLoopManager::~CEventLoopManager() {
@@ -100,60 +100,241 @@ void CEventLoopManager::enterLoop() {
     Debug::log(LOG, "Kicked off the event loop! :(");
 }
 
+// timers due within this much of a wakeup are dispatched in it, instead of getting a wakeup of their own
+constexpr auto TIMER_SLACK = std::chrono::microseconds(100);
+
 void CEventLoopManager::onTimerFire() {
-    for (auto const& t : m_sTimers.timers) {
-        if (t.strongRef() > 1 /* if it's 1, it was lost. Don't call it. */ && t->passed() && !t->cancelled())
-            t->call(t);
+    const auto NOW      = Time::steadyNow();
+    const auto DEADLINE = NOW + TIMER_SLACK;
+
+    // pop everything due first, callbacks are free to re-arm timers (including themselves)
+    std::vector<SP<CEventLoopTimer>> due;
+    while (!m_sTimers.heap.empty() && *m_sTimers.heap.front()->m_expires <= DEADLINE) {
+        auto* const t = m_sTimers.heap.front();
+        heapRemove(t);
+
+        const auto& TIMER = m_sTimers.timers[t->m_ownerIdx];
+        if (TIMER.strongRef() <= 1 /* if it's 1, it was lost. Don't call it. */) {
+            dropTimer(t);
+            continue;
+        }
+
+        due.emplace_back(TIMER);
+    }
+
+    size_t dispatched = 0;
+    float  latencySum = 0, latencyMax = 0;
+
+    for (auto const& t : due) {
+        // re-armed, disarmed or removed by a callback earlier in this wakeup
+        if (t->m_ownerIdx == CEventLoopTimer::INVALID_IDX || t->m_heapIdx != CEventLoopTimer::INVALID_IDX || !t->armed() || t->cancelled() || *t->m_expires > DEADLINE)
+            continue;
+
+        const float LATENCY = std::chrono::duration_cast<std::chrono::duration<float, std::micro>>(NOW - *t->m_expires).count();
+        if (LATENCY < 0)
+            m_sTimerStats.current.coalesced++;
+
+        dispatched++;
+        latencySum += std::max(LATENCY, 0.F);
+        latencyMax = std::max(latencyMax, LATENCY);
+
+        t->call(t);
     }
 
+    m_sTimerStats.current.wakeups++;
+    m_sTimerStats.current.dispatched += dispatched;
+    m_sTimerStats.windowWakeups++;
+    m_sTimerStats.windowDispatched += dispatched;
+    m_sTimerStats.windowLatencySumUs += latencySum;
+    m_sTimerStats.windowLatencyMaxUs = std::max(m_sTimerStats.windowLatencyMaxUs, latencyMax);
+    rollTimerStats();
+
+    // always re-set, this also clears the timerfd's readability
     nudgeTimers();
 }
 
 void CEventLoopManager::addTimer(SP<CEventLoopTimer> timer) {
-    m_sTimers.timers.push_back(timer);
-    nudgeTimers();
+    if (timer->m_ownerIdx != CEventLoopTimer::INVALID_IDX)
+        return;
+
+    timer->m_ownerIdx = m_sTimers.timers.size();
+    m_sTimers.timers.emplace_back(timer);
+
+    if (m_sTimers.timers.size() >= m_sTimers.sweepAt)
+        sweepLostTimers();
+
+    onTimerUpdated(timer.get());
 }
 
 void CEventLoopManager::removeTimer(SP<CEventLoopTimer> timer) {
-    std::erase_if(m_sTimers.timers, [timer](const auto& t) { return timer == t; });
-    nudgeTimers();
+    if (timer->m_ownerIdx == CEventLoopTimer::INVALID_IDX || m_sTimers.timers[timer->m_ownerIdx] != timer)
+        return;
+
+    dropTimer(timer.get());
+    syncTimerFD();
 }
 
-static void timespecAddNs(timespec* pTimespec, int64_t delta) {
-    auto delta_ns_low = delta % TIMESPEC_NSEC_PER_SEC;
-    auto delta_s_high = delta / TIMESPEC_NSEC_PER_SEC;
+void CEventLoopManager::onTimerUpdated(CEventLoopTimer* timer) {
+    // not added (yet), addTimer will pick the expiry up
+    if (timer->m_ownerIdx == CEventLoopTimer::INVALID_IDX)
+        return;
 
-    pTimespec->tv_sec += delta_s_high;
+    const bool ARMED = timer->armed() && !timer->cancelled();
 
-    pTimespec->tv_nsec += (long)delta_ns_low;
-    if (pTimespec->tv_nsec >= TIMESPEC_NSEC_PER_SEC) {
-        pTimespec->tv_nsec -= TIMESPEC_NSEC_PER_SEC;
-        ++pTimespec->tv_sec;
+    if (!ARMED)
+        heapRemove(timer);
+    else if (timer->m_heapIdx == CEventLoopTimer::INVALID_IDX)
+        heapInsert(timer);
+    else {
+        heapSiftUp(timer->m_heapIdx);
+        heapSiftDown(timer->m_heapIdx);
     }
+
+    syncTimerFD();
 }
 
-void CEventLoopManager::nudgeTimers() {
-    // remove timers that have gone missing
-    std::erase_if(m_sTimers.timers, [](const auto& t) { return t.strongRef() <= 1; });
+void CEventLoopManager::dropTimer(CEventLoopTimer* timer) {
+    heapRemove(timer);
+
+    const auto IDX = timer->m_ownerIdx;
+    timer->m_ownerIdx = CEventLoopTimer::INVALID_IDX;
+
+    // swap with the last one, the order of the list doesn't matter. The timer may die with the pop.
+    std::swap(m_sTimers.timers[IDX], m_sTimers.timers.back());
+    if (IDX != m_sTimers.timers.size() - 1)
+        m_sTimers.timers[IDX]->m_ownerIdx = IDX;
+    m_sTimers.timers.pop_back();
+}
+
+void CEventLoopManager::sweepLostTimers() {
+    // lost timers that are armed get dropped when they come due, this catches the disarmed ones.
+    // Runs whenever the list doubled since the last sweep, so adding stays amortized O(1).
+    for (size_t i = m_sTimers.timers.size(); i > 0; --i) {
+        if (m_sTimers.timers[i - 1].strongRef() <= 1)
+            dropTimer(m_sTimers.timers[i - 1].get());
+    }
+
+    m_sTimers.sweepAt = std::max<size_t>(64, m_sTimers.timers.size() * 2);
+}
+
+bool CEventLoopManager::heapLess(size_t a, size_t b) const {
+    return *m_sTimers.heap[a]->m_expires < *m_sTimers.heap[b]->m_expires;
+}
+
+void CEventLoopManager::heapSwap(size_t a, size_t b) {
+    std::swap(m_sTimers.heap[a], m_sTimers.heap[b]);
+    m_sTimers.heap[a]->m_heapIdx = a;
+    m_sTimers.heap[b]->m_heapIdx = b;
+}
+
+void CEventLoopManager::heapSiftUp(size_t idx) {
+    while (idx > 0) {
+        const auto PARENT = (idx - 1) / 2;
+        if (!heapLess(idx, PARENT))
+            break;
+
+        heapSwap(idx, PARENT);
+        idx = PARENT;
+    }
+}
+
+void CEventLoopManager::heapSiftDown(size_t idx) {
+    const auto SIZE = m_sTimers.heap.size();
+
+    while (true) {
+        const auto LEFT     = idx * 2 + 1;
+        const auto RIGHT    = LEFT + 1;
+        auto       smallest = idx;
+
+        if (LEFT < SIZE && heapLess(LEFT, smallest))
+            smallest = LEFT;
+        if (RIGHT < SIZE && heapLess(RIGHT, smallest))
+            smallest = RIGHT;
 
-    long nextTimerUs = 10L * 1000 * 1000; // 10s
+        if (smallest == idx)
+            break;
 
-    for (auto const& t : m_sTimers.timers) {
-        if (auto const& µs = t->leftUs(); µs < nextTimerUs)
-            nextTimerUs = µs;
+        heapSwap(idx, smallest);
+        idx = smallest;
     }
+}
+
+void CEventLoopManager::heapInsert(CEventLoopTimer* timer) {
+    timer->m_heapIdx = m_sTimers.heap.size();
+    m_sTimers.heap.emplace_back(timer);
+    heapSiftUp(timer->m_heapIdx);
+}
+
+void CEventLoopManager::heapRemove(CEventLoopTimer* timer) {
+    const auto IDX = timer->m_heapIdx;
+    if (IDX == CEventLoopTimer::INVALID_IDX)
+        return;
+
+    const auto LAST = m_sTimers.heap.size() - 1;
+    if (IDX != LAST)
+        heapSwap(IDX, LAST);
 
-    nextTimerUs = std::clamp(nextTimerUs + 1, 1L, std::numeric_limits<long>::max());
+    m_sTimers.heap.pop_back();
+    timer->m_heapIdx = CEventLoopTimer::INVALID_IDX;
 
-    timespec now;
-    clock_gettime(CLOCK_MONOTONIC, &now);
-    timespecAddNs(&now, nextTimerUs * 1000L);
+    if (IDX == LAST)
+        return;
 
-    itimerspec ts = {.it_value = now};
+    // the one moved into the hole can belong either above or below it
+    auto* const MOVED = m_sTimers.heap[IDX];
+    heapSiftUp(IDX);
+    heapSiftDown(MOVED->m_heapIdx);
+}
+
+void CEventLoopManager::syncTimerFD() {
+    // only touch the timerfd when the earliest deadline moved
+    const auto HEAD = m_sTimers.heap.empty() ? std::nullopt : m_sTimers.heap.front()->m_expires;
+    if (HEAD != m_sTimers.armedFor)
+        nudgeTimers();
+}
+
+void CEventLoopManager::nudgeTimers() {
+    itimerspec ts = {}; // zero disarms
+
+    if (!m_sTimers.heap.empty()) {
+        // steady_clock is CLOCK_MONOTONIC, its time points can be handed to the timerfd as they are
+        const auto [SEC, NSEC] = Time::secNsec(*m_sTimers.heap.front()->m_expires);
+        ts.it_value            = {.tv_sec = (time_t)SEC, .tv_nsec = (long)NSEC};
+        m_sTimers.armedFor     = m_sTimers.heap.front()->m_expires;
+    } else
+        m_sTimers.armedFor.reset();
 
     timerfd_settime(m_sTimers.timerfd.get(), TFD_TIMER_ABSTIME, &ts, nullptr);
 }
 
+void CEventLoopManager::rollTimerStats() {
+    auto&      stats   = m_sTimerStats;
+    const auto NOW     = Time::steadyNow();
+    const auto ELAPSED = std::chrono::duration_cast<std::chrono::duration<float>>(NOW - stats.windowStart).count();
+
+    if (ELAPSED < 1.F)
+        return;
+
+    stats.current.wakeupsPerSecond = stats.windowWakeups / ELAPSED;
+    stats.current.avgLatencyUs     = stats.windowDispatched ? stats.windowLatencySumUs / stats.windowDispatched : 0.F;
+    stats.current.maxLatencyUs     = stats.windowLatencyMaxUs;
+
+    stats.windowStart        = NOW;
+    stats.windowWakeups      = 0;
+    stats.windowDispatched   = 0;
+    stats.windowLatencySumUs = 0;
+    stats.windowLatencyMaxUs = 0;
+}
+
+const CEventLoopManager::STimerStats& CEventLoopManager::getTimerStats() {
+    rollTimerStats();
+
+    m_sTimerStats.current.timers = m_sTimers.timers.size();
+    m_sTimerStats.current.armed  = m_sTimers.heap.size();
+
+    return m_sTimerStats.current;
+}
+
 void CEventLoopManager::doLater(const std::function<void()>& fn) {
     m_sIdle.fns.emplace_back(fn);
 
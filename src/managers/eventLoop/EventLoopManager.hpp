@@ -27,9 +27,22 @@ class CEventLoopManager {
 
     void onTimerFire();
 
-    // recalculates timers
+    // re-arms the timerfd for the earliest armed timer
     void nudgeTimers();
 
+    // called by a timer whose expiry changed, keeps the heap in order
+    void onTimerUpdated(CEventLoopTimer* timer);
+
+    struct STimerStats {
+        size_t   timers = 0, armed = 0;
+        uint64_t wakeups = 0, dispatched = 0, coalesced = 0;
+
+        // over the last full second
+        float wakeupsPerSecond = 0, avgLatencyUs = 0, maxLatencyUs = 0;
+    };
+
+    const STimerStats& getTimerStats();
+
     // schedules a function to run later, aka in a wayland idle event.
     void doLater(const std::function<void()>& fn);
 
@@ -64,11 +77,32 @@ class CEventLoopManager {
         wl_event_source* eventSource = nullptr;
     } m_sWayland;
 
+    void heapInsert(CEventLoopTimer* timer);
+    void heapRemove(CEventLoopTimer* timer);
+    void heapSiftUp(size_t idx);
+    void heapSiftDown(size_t idx);
+    bool heapLess(size_t a, size_t b) const;
+    void heapSwap(size_t a, size_t b);
+    void dropTimer(CEventLoopTimer* timer);
+    void sweepLostTimers();
+    void syncTimerFD();
+    void rollTimerStats();
+
     struct {
         std::vector<SP<CEventLoopTimer>> timers;
+        std::vector<CEventLoopTimer*>    heap; // armed timers, earliest first
         Hyprutils::OS::CFileDescriptor   timerfd;
+        std::optional<Time::steady_tp>   armedFor;
+        size_t                           sweepAt = 64;
     } m_sTimers;
 
+    struct {
+        STimerStats     current;
+        Time::steady_tp windowStart;
+        uint64_t        windowWakeups = 0, windowDispatched = 0;
+        float           windowLatencySumUs = 0, windowLatencyMaxUs = 0;
+    } m_sTimerStats;
+
     SIdleData                        m_sIdle;
     std::map<int, SEventSourceData>  aqEventSources;
     std::vector<UP<SReadableWaiter>> m_vReadableWaiters;
@@ -12,15 +12,12 @@ CEventLoopTimer::CEventLoopTimer(std::optional<Time::steady_dur> timeout, std::f
 }
 
 void CEventLoopTimer::updateTimeout(std::optional<Time::steady_dur> timeout) {
-    if (!timeout.has_value()) {
+    if (!timeout.has_value())
         m_expires.reset();
-        g_pEventLoopManager->nudgeTimers();
-        return;
-    }
-
-    m_expires = Time::steadyNow() + *timeout;
+    else
+        m_expires = Time::steadyNow() + *timeout;
 
-    g_pEventLoopManager->nudgeTimers();
+    g_pEventLoopManager->onTimerUpdated(this);
 }
 
 bool CEventLoopTimer::passed() {
@@ -32,6 +29,9 @@ bool CEventLoopTimer::passed() {
 void CEventLoopTimer::cancel() {
     m_wasCancelled = true;
     m_expires.reset();
+
+    if (g_pEventLoopManager)
+        g_pEventLoopManager->onTimerUpdated(this);
 }
 
 bool CEventLoopTimer::cancelled() {
@@ -40,6 +40,11 @@ bool CEventLoopTimer::cancelled() {
 
 void CEventLoopTimer::call(SP<CEventLoopTimer> self) {
     m_expires.reset();
+
+    // called by hand while still armed
+    if (m_heapIdx != INVALID_IDX)
+        g_pEventLoopManager->onTimerUpdated(this);
+
     m_cb(self, m_data);
 }
 
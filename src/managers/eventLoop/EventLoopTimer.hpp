@@ -1,7 +1,9 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <optional>
 
 #include "../../helpers/memory/Memory.hpp"
@@ -30,4 +32,11 @@ class CEventLoopTimer {
     void*                                                     m_data = nullptr;
     std::optional<Time::steady_tp>                            m_expires;
     bool                                                      m_wasCancelled = false;
+
+    // bookkeeping of CEventLoopManager: slot in its timer list and in its heap of armed timers
+    static constexpr size_t                                   INVALID_IDX = std::numeric_limits<size_t>::max();
+    size_t                                                    m_ownerIdx  = INVALID_IDX;
+    size_t                                                    m_heapIdx   = INVALID_IDX;
+
+    friend class CEventLoopManager;
 };
@@ -7,6 +7,7 @@
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
+#include "../render/ReadbackPool.hpp"
 #include "../helpers/Monitor.hpp"
 #include "core/Output.hpp"
 #include "types/WLBuffer.hpp"
@@ -15,6 +16,7 @@
 #include "../helpers/time/Time.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 
 CScreencopyFrame::CScreencopyFrame(SP<CZwlrScreencopyFrameV1> resource_, int32_t overlay_cursor, wl_resource* output, CBox box_) : resource(resource_) {
@@ -156,22 +158,74 @@ void CScreencopyFrame::share() {
     if (!buffer || !pMonitor)
         return;
 
-    const auto NOW = Time::steadyNow();
+    const auto             NOW = Time::steadyNow();
+
+    // what changed since this client's last copy of the monitor, and what this buffer is missing
+    CRegion                frameDamage = CBox{0, 0, box.w, box.h};
+    std::optional<CRegion> copyDamage;
+
+    if (const auto CLIENT = client.lock()) {
+        const auto PERM    = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
+        auto&      state   = CLIENT->damageFor(pMonitor.lock(), box);
+        const auto toFrame = [this](CRegion rg) {
+            rg.intersect(box);
+            rg.translate(-box.pos());
+            return rg;
+        };
+
+        // the cursor is drawn into overlay-cursor frames, but a hardware cursor moving never damages the monitor.
+        // Both where it was last drawn and where it is now have to be copied again
+        CBox cursorBox;
+        if (overlayCursor && g_pPointerManager->hasCursor())
+            cursorBox = g_pPointerManager->getCursorBoxLogicalForMonitor(pMonitor.lock()).scale(pMonitor->scale).round().expand(1);
+
+        if (overlayCursor || !state.lastCursor.empty()) {
+            state.ring.damage(CRegion{state.lastCursor}.add(cursorBox));
+            state.lastCursor = cursorBox;
+        }
+
+        frameDamage = toFrame(state.ring.getBufferDamage(1));
+
+        // a buffer copied into before only misses what changed since then. Only copy_with_damage clients
+        // promise to leave their buffers alone between frames, plain copies always get the whole frame
+        auto it = std::ranges::find_if(state.buffers, [this](const auto& b) { return b && b == buffer.buffer; });
+
+        if (withDamage && PERM == PERMISSION_RULE_ALLOW_MODE_ALLOW && !bufferDMA && it != state.buffers.end())
+            copyDamage = toFrame(state.ring.getBufferDamage(std::distance(state.buffers.begin(), it) + 1));
+
+        // a denied or pending frame is black, the next allowed one has to be copied whole
+        if (PERM != PERMISSION_RULE_ALLOW_MODE_ALLOW)
+            state.buffers.fill({});
+        else if (it != state.buffers.end())
+            std::rotate(state.buffers.begin(), it, it + 1);
+        else {
+            std::shift_right(state.buffers.begin(), state.buffers.end(), 1);
+            state.buffers[0] = buffer.buffer;
+        }
 
-    auto       callback = [this, NOW, weak = self](bool success) {
+        state.ring.rotate();
+    }
+
+    auto callback = [this, NOW, frameDamage, weak = self](bool success) {
         if (weak.expired())
             return;
 
         if (!success) {
             LOGM(ERR, "{} copy failed in {:x}", bufferDMA ? "Dmabuf" : "Shm", (uintptr_t)this);
+
+            // whatever is in the buffer now can't be built upon
+            if (const auto CLIENT = client.lock(); CLIENT && pMonitor)
+                CLIENT->damageFor(pMonitor.lock(), box).buffers.fill({});
+
             resource->sendFailed();
             return;
         }
 
         resource->sendFlags((zwlrScreencopyFrameV1Flags)0);
         if (withDamage) {
-            // TODO: add a damage ring for this.
-            resource->sendDamage(0, 0, buffer->size.x, buffer->size.y);
+            for (auto const& r : frameDamage.getRects()) {
+                resource->sendDamage(r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1);
+            }
         }
 
         const auto [sec, nsec] = Time::secNsec(NOW);
@@ -184,7 +238,7 @@ void CScreencopyFrame::share() {
     if (bufferDMA)
         copyDmabuf(callback);
     else
-        callback(copyShm());
+        copyShm(callback, copyDamage);
 }
 
 void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
@@ -237,23 +291,35 @@ void CScreencopyFrame::copyDmabuf(std::function<void(bool)> callback) {
     callback(true);
 }
 
-bool CScreencopyFrame::copyShm() {
+void CScreencopyFrame::copyShm(std::function<void(bool)> callback, std::optional<CRegion> damage) {
     const auto PERM    = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
     auto       TEXTURE = makeShared<CTexture>(pMonitor->output->state->state().buffer);
 
-    auto       shm                = buffer->shm();
-    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
+    auto       shm = buffer->shm();
+
+    CRegion    fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
 
-    CRegion fakeDamage = {0, 0, INT16_MAX, INT16_MAX};
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
+    if (!PFORMAT) {
+        LOGM(ERR, "Can't copy: failed to find a pixel format");
+        callback(false);
+        return;
+    }
 
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer fb;
-    fb.alloc(box.w, box.h, pMonitor->output->state->state().drmFormat);
+    auto slot = g_pHyprOpenGL->m_pReadbackPool->acquire(pMonitor.lock(), pMonitor->output->state->state().drmFormat, box.size());
+    if (!slot) {
+        LOGM(ERR, "Can't copy: failed to get a framebuffer");
+        callback(false);
+        return;
+    }
 
-    if (!g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &fb, true)) {
+    if (!g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &slot->fb, true)) {
         LOGM(ERR, "Can't copy: failed to begin rendering");
-        return false;
+        g_pHyprOpenGL->m_pReadbackPool->release(slot);
+        callback(false);
+        return;
     }
 
     if (PERM == PERMISSION_RULE_ALLOW_MODE_ALLOW) {
@@ -274,55 +340,31 @@ bool CScreencopyFrame::copyShm() {
         g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_pScreencopyDeniedTexture, texbox, 1);
     }
 
-#ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.getFBID());
-#else
-    glBindFramebuffer(GL_FRAMEBUFFER, fb.getFBID());
-#endif
-
-    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    if (!PFORMAT) {
-        LOGM(ERR, "Can't copy: failed to find a pixel format");
-        g_pHyprRenderer->endRender();
-        return false;
-    }
-
-    auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
-
     g_pHyprOpenGL->m_RenderData.blockScreenShader = true;
     g_pHyprRenderer->endRender();
 
-    g_pHyprRenderer->makeEGLCurrent();
-    g_pHyprOpenGL->m_RenderData.pMonitor = pMonitor;
-    fb.bind();
-
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-
-    const auto drmFmt     = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    uint32_t   packStride = NFormatUtils::minStride(drmFmt, box.w);
-
-    // This could be optimized by using a pixel buffer object to make this async,
-    // but really clients should just use a dma buffer anyways.
-    if (packStride == (uint32_t)shm.stride) {
-        glReadPixels(0, 0, box.w, box.h, glFormat, PFORMAT->glType, pixelData);
-    } else {
-        for (size_t i = 0; i < box.h; ++i) {
-            uint32_t y = i;
-            glReadPixels(0, y, box.w, 1, glFormat, PFORMAT->glType, ((unsigned char*)pixelData) + i * shm.stride);
-        }
-    }
+    // the frame is only ready once the pixels land in the client's buffer
+    g_pHyprOpenGL->m_pReadbackPool->readAsync(
+        slot, {0, 0, box.w, box.h}, PFORMAT,
+        [this, callback, damage, PFORMAT, weak = self](const uint8_t* pixels, uint32_t stride) {
+            if (weak.expired())
+                return;
 
-    g_pHyprOpenGL->m_RenderData.pMonitor.reset();
+            // the read failed or the buffer went away meanwhile, the client still waits on ready or failed
+            if (!pixels || !buffer) {
+                callback(false);
+                return;
+            }
 
-#ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-#else
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-#endif
+            auto shm                      = buffer->shm();
+            auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
 
-    LOGM(TRACE, "Copied frame via shm");
+            CReadbackPool::copyRegion(pixels, stride, pixelData, shm.stride, damage.value_or(CRegion{CBox{0, 0, box.w, box.h}}), PFORMAT->bytesPerBlock);
 
-    return true;
+            LOGM(TRACE, "Copied frame via shm{}", damage ? " (damage only)" : "");
+            callback(true);
+        },
+        damage);
 }
 
 bool CScreencopyFrame::good() {
@@ -386,6 +428,24 @@ void CScreencopyClient::onTick() {
     }
 }
 
+CScreencopyClient::SMonitorDamage& CScreencopyClient::damageFor(PHLMONITOR pMonitor, const CBox& box) {
+    std::erase_if(monitorDamage, [](const auto& d) { return !d.monitor; });
+
+    // buffers are remembered per region, a buffer reused for another region has none of its pixels
+    auto it = std::ranges::find_if(monitorDamage, [&pMonitor, &box](const auto& d) { return d.monitor == pMonitor && d.box == box; });
+
+    if (it == monitorDamage.end()) {
+        it          = monitorDamage.emplace(monitorDamage.end());
+        it->monitor = pMonitor;
+        it->box     = box;
+    }
+
+    // new or resized, everything is damaged
+    it->ring.setSize(pMonitor->vecTransformedSize);
+
+    return *it;
+}
+
 bool CScreencopyClient::good() {
     return resource->resource();
 }
@@ -420,6 +480,15 @@ void CScreencopyProtocol::destroyResource(CScreencopyFrame* frame) {
     std::erase_if(m_vFramesAwaitingWrite, [&](const auto& other) { return !other || other.get() == frame; });
 }
 
+void CScreencopyProtocol::onMonitorDamage(PHLMONITOR pMonitor, const CRegion& damage) {
+    for (auto const& c : m_vClients) {
+        for (auto& d : c->monitorDamage) {
+            if (d.monitor == pMonitor)
+                d.ring.damage(damage);
+        }
+    }
+}
+
 void CScreencopyProtocol::onOutputCommit(PHLMONITOR pMonitor) {
     if (m_vFramesAwaitingWrite.empty()) {
         g_pHyprRenderer->m_bDirectScanoutBlocked = false;
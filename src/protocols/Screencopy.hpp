@@ -5,11 +5,13 @@
 #include "wlr-screencopy-unstable-v1.hpp"
 #include "WaylandProtocol.hpp"
 
+#include <array>
 #include <list>
 #include <vector>
 #include "../managers/HookSystemManager.hpp"
 #include "../helpers/time/Timer.hpp"
 #include "../helpers/time/Time.hpp"
+#include "../helpers/DamageRing.hpp"
 #include "../managers/eventLoop/EventLoopTimer.hpp"
 #include <aquamarine/buffer/Buffer.hpp>
 
@@ -46,7 +48,20 @@ class CScreencopyClient {
 
     void                         captureOutput(uint32_t frame, int32_t overlayCursor, wl_resource* output, CBox box);
 
+    // what changed in a region of a monitor since this client's last copy of it, and the buffers it copied into last
+    struct SMonitorDamage {
+        PHLMONITORREF                                          monitor;
+        CBox                                                   box;        // captured region, in pixels
+        CBox                                                   lastCursor; // cursor drawn into the last overlay-cursor frame, in pixels
+        CDamageRing                                            ring;
+        std::array<WP<IHLBuffer>, DAMAGE_RING_PREVIOUS_LEN + 1> buffers; // most recent first
+    };
+
+    std::vector<SMonitorDamage> monitorDamage;
+    SMonitorDamage&             damageFor(PHLMONITOR pMonitor, const CBox& box);
+
     friend class CScreencopyProtocol;
+    friend class CScreencopyFrame;
 };
 
 class CScreencopyFrame {
@@ -75,7 +90,7 @@ class CScreencopyFrame {
 
     void                       copy(CZwlrScreencopyFrameV1* pFrame, wl_resource* buffer);
     void                       copyDmabuf(std::function<void(bool)> callback);
-    bool                       copyShm();
+    void                       copyShm(std::function<void(bool)> callback, std::optional<CRegion> damage);
     void                       share();
 
     friend class CScreencopyProtocol;
@@ -90,6 +105,7 @@ class CScreencopyProtocol : public IWaylandProtocol {
     void         destroyResource(CScreencopyFrame* resource);
 
     void         onOutputCommit(PHLMONITOR pMonitor);
+    void         onMonitorDamage(PHLMONITOR pMonitor, const CRegion& damage);
 
   private:
     std::vector<SP<CScreencopyFrame>>  m_vFrames;
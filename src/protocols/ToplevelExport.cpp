@@ -10,8 +10,10 @@
 #include "../managers/input/InputManager.hpp"
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
+#include "../render/ReadbackPool.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <hyprutils/math/Vector2D.hpp>
 
 CToplevelExportClient::CToplevelExportClient(SP<CHyprlandToplevelExportManagerV1> resource_) : resource(resource_) {
@@ -205,43 +207,54 @@ void CToplevelExportFrame::share() {
     if (!buffer || !validMapped(pWindow))
         return;
 
-    if (bufferDMA) {
-        if (!copyDmabuf(Time::steadyNow())) {
-            resource->sendFailed();
+    auto callback = [this, weak = self](bool success) {
+        if (weak.expired())
             return;
-        }
-    } else {
-        if (!copyShm(Time::steadyNow())) {
+
+        if (!success) {
             resource->sendFailed();
             return;
         }
-    }
 
-    resource->sendFlags((hyprlandToplevelExportFrameV1Flags)0);
+        resource->sendFlags((hyprlandToplevelExportFrameV1Flags)0);
+
+        if (!m_ignoreDamage)
+            resource->sendDamage(0, 0, box.width, box.height);
 
-    if (!m_ignoreDamage)
-        resource->sendDamage(0, 0, box.width, box.height);
+        const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
 
-    const auto [sec, nsec] = Time::secNsec(Time::steadyNow());
+        uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
+        uint32_t tvSecLo = sec & 0xFFFFFFFF;
+        resource->sendReady(tvSecHi, tvSecLo, nsec);
+    };
 
-    uint32_t tvSecHi = (sizeof(sec) > 4) ? sec >> 32 : 0;
-    uint32_t tvSecLo = sec & 0xFFFFFFFF;
-    resource->sendReady(tvSecHi, tvSecLo, nsec);
+    if (bufferDMA)
+        callback(copyDmabuf(Time::steadyNow()));
+    else
+        copyShm(Time::steadyNow(), callback);
 }
 
-bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
-    const auto PERM               = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
-    auto       shm                = buffer->shm();
-    auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
+void CToplevelExportFrame::copyShm(const Time::steady_tp& now, std::function<void(bool)> callback) {
+    const auto PERM = g_pDynamicPermissionManager->clientPermissionMode(resource->client(), PERMISSION_TYPE_SCREENCOPY);
+    auto       shm  = buffer->shm();
 
     // render the client
     const auto PMONITOR = pWindow->m_monitor.lock();
     CRegion    fakeDamage{0, 0, PMONITOR->vecPixelSize.x * 10, PMONITOR->vecPixelSize.y * 10};
 
+    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
+    if (!PFORMAT) {
+        callback(false);
+        return;
+    }
+
     g_pHyprRenderer->makeEGLCurrent();
 
-    CFramebuffer outFB;
-    outFB.alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y, PMONITOR->output->state->state().drmFormat);
+    auto slot = g_pHyprOpenGL->m_pReadbackPool->acquire(PMONITOR, PMONITOR->output->state->state().drmFormat, PMONITOR->vecPixelSize);
+    if (!slot) {
+        callback(false);
+        return;
+    }
 
     auto overlayCursor = shouldOverlayCursor();
 
@@ -250,8 +263,14 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         g_pPointerManager->damageCursor(PMONITOR->self.lock());
     }
 
-    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &outFB))
-        return false;
+    if (!g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &slot->fb)) {
+        if (overlayCursor)
+            g_pPointerManager->unlockSoftwareForMonitor(PMONITOR->self.lock());
+
+        g_pHyprOpenGL->m_pReadbackPool->release(slot);
+        callback(false);
+        return;
+    }
 
     g_pHyprOpenGL->clear(CHyprColor(0, 0, 0, 1.0));
 
@@ -269,26 +288,13 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_pScreencopyDeniedTexture, texbox, 1);
     }
 
-    const auto PFORMAT = NFormatUtils::getPixelFormatFromDRM(shm.format);
-    if (!PFORMAT) {
-        g_pHyprRenderer->endRender();
-        return false;
-    }
-
     g_pHyprOpenGL->m_RenderData.blockScreenShader = true;
     g_pHyprRenderer->endRender();
 
-    g_pHyprRenderer->makeEGLCurrent();
-    g_pHyprOpenGL->m_RenderData.pMonitor = PMONITOR;
-    outFB.bind();
-
-#ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, outFB.getFBID());
-#endif
-
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-
-    auto glFormat = PFORMAT->flipRB ? GL_BGRA_EXT : GL_RGBA;
+    if (overlayCursor) {
+        g_pPointerManager->unlockSoftwareForMonitor(PMONITOR->self.lock());
+        g_pPointerManager->damageCursor(PMONITOR->self.lock());
+    }
 
     auto origin = Vector2D(0, 0);
     switch (PMONITOR->transform) {
@@ -311,20 +317,30 @@ bool CToplevelExportFrame::copyShm(const Time::steady_tp& now) {
         default: break;
     }
 
-    glReadPixels(origin.x, origin.y, box.width, box.height, glFormat, PFORMAT->glType, pixelData);
+    // the frame is only ready once the pixels land in the client's buffer
+    g_pHyprOpenGL->m_pReadbackPool->readAsync(slot, {origin, box.size()}, PFORMAT, [this, callback, weak = self](const uint8_t* pixels, uint32_t stride) {
+        if (weak.expired())
+            return;
 
-    if (overlayCursor) {
-        g_pPointerManager->unlockSoftwareForMonitor(PMONITOR->self.lock());
-        g_pPointerManager->damageCursor(PMONITOR->self.lock());
-    }
+        // the read failed or the buffer went away meanwhile, the client still waits on ready or failed
+        if (!pixels || !buffer) {
+            callback(false);
+            return;
+        }
 
-    outFB.unbind();
+        auto shm                      = buffer->shm();
+        auto [pixelData, fmt, bufLen] = buffer->beginDataPtr(0); // no need for end, cuz it's shm
 
-#ifndef GLES2
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-#endif
+        if (stride == (uint32_t)shm.stride)
+            memcpy(pixelData, pixels, std::min((size_t)bufLen, (size_t)stride * box.height));
+        else {
+            for (size_t i = 0; i < box.height; ++i) {
+                memcpy(pixelData + i * shm.stride, pixels + i * stride, std::min(stride, (uint32_t)shm.stride));
+            }
+        }
 
-    return true;
+        callback(true);
+    });
 }
 
 bool CToplevelExportFrame::copyDmabuf(const Time::steady_tp& now) {
@@ -431,7 +431,7 @@ CXDGSurfaceResource::CXDGSurfaceResource(SP<CXdgSurface> resource_, SP<CXDGWMBas
 
         LOGM(LOG, "xdg_surface {:x} gets a toplevel {:x}", (uintptr_t)owner.get(), (uintptr_t)RESOURCE.get());
 
-        g_pCompositor->m_windows.emplace_back(CWindow::create(self.lock()));
+        g_pCompositor->indexWindow(g_pCompositor->m_windows.emplace_back(CWindow::create(self.lock())));
 
         for (auto const& p : popups) {
             if (!p)
@@ -1,5 +1,6 @@
 #include "XDGTag.hpp"
 #include "XDGShell.hpp"
+#include "../desktop/Window.hpp"
 
 CXDGToplevelTagManagerResource::CXDGToplevelTagManagerResource(UP<CXdgToplevelTagManagerV1>&& resource) : m_resource(std::move(resource)) {
     if UNLIKELY (!good())
@@ -17,6 +18,9 @@ CXDGToplevelTagManagerResource::CXDGToplevelTagManagerResource(UP<CXdgToplevelTa
         }
 
         TOPLEVEL->m_toplevelTag = tag;
+
+        if (const auto PWINDOW = TOPLEVEL->window.lock())
+            PWINDOW->invalidateHyprctlSnapshot();
     });
 
     resource->setSetToplevelDescription([](CXdgToplevelTagManagerV1* r, wl_resource* toplevel, const char* description) {
@@ -28,6 +32,9 @@ CXDGToplevelTagManagerResource::CXDGToplevelTagManagerResource(UP<CXdgToplevelTa
         }
 
         TOPLEVEL->m_toplevelDescription = description;
+
+        if (const auto PWINDOW = TOPLEVEL->window.lock())
+            PWINDOW->invalidateHyprctlSnapshot();
     });
 }
 
@@ -486,8 +486,9 @@ void CWLSurfaceResource::commitState(SSurfaceState& state) {
     current.updateFrom(state);
 
     if (current.buffer) {
+        // cursors are sampled outside of render passes, upload them right away
         if (current.buffer->isSynchronous())
-            current.updateSynchronousTexture(lastTexture);
+            current.updateSynchronousTexture(lastTexture, role->role() != SURFACE_ROLE_CURSOR);
 
         // if the surface is a cursor, update the shm buffer
         // TODO: don't update the entire texture
@@ -34,14 +34,19 @@ CRegion SSurfaceState::accumulateBufferDamage() {
     return bufferDamage;
 }
 
-void SSurfaceState::updateSynchronousTexture(SP<CTexture> lastTexture) {
+void SSurfaceState::updateSynchronousTexture(SP<CTexture> lastTexture, bool deferUpload) {
     auto [dataPtr, fmt, size] = buffer->beginDataPtr(0);
     if (dataPtr) {
         auto drmFmt = NFormatUtils::shmToDRM(fmt);
         auto stride = bufferSize.y ? size / bufferSize.y : 0;
         if (lastTexture && lastTexture->m_isSynchronous && lastTexture->m_vSize == bufferSize) {
             texture = lastTexture;
-            texture->update(drmFmt, dataPtr, stride, accumulateBufferDamage());
+            if (deferUpload)
+                texture->queueUpdate(drmFmt, dataPtr, stride, accumulateBufferDamage());
+            else {
+                texture->flushPendingUpload();
+                texture->update(drmFmt, dataPtr, stride, accumulateBufferDamage());
+            }
         } else
             texture = makeShared<CTexture>(drmFmt, dataPtr, stride, bufferSize);
     }
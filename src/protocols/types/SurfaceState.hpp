@@ -51,7 +51,8 @@ struct SSurfaceState {
 
     // texture of surface content, used for rendering
     SP<CTexture> texture;
-    void         updateSynchronousTexture(SP<CTexture> lastTexture);
+    // with deferUpload, damage to an existing texture is only uploaded once it gets drawn
+    void         updateSynchronousTexture(SP<CTexture> lastTexture, bool deferUpload);
 
     // helpers
     CRegion accumulateBufferDamage();       // transforms state.damage and merges it into state.bufferDamage
@@ -15,11 +15,11 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
     if (!m_cTex) {
         m_cTex = makeShared<CTexture>();
         m_cTex->allocate();
-        glBindTexture(GL_TEXTURE_2D, m_cTex->m_iTexID);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_cTex->m_iTexID);
+        m_cTex->setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        m_cTex->setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        m_cTex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        m_cTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         firstAlloc = true;
     }
 
@@ -30,7 +30,7 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
     }
 
     if (firstAlloc || m_vSize != Vector2D(w, h)) {
-        glBindTexture(GL_TEXTURE_2D, m_cTex->m_iTexID);
+        g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_cTex->m_iTexID);
         glTexImage2D(GL_TEXTURE_2D, 0, glFormat, w, h, 0, GL_RGBA, glType, nullptr);
         glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_cTex->m_iTexID, 0);
@@ -38,7 +38,7 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
 // TODO: Allow this with gles2
 #ifndef GLES2
         if (m_pStencilTex) {
-            glBindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
+            g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, w, h, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_pStencilTex->m_iTexID, 0);
         }
@@ -50,7 +50,6 @@ bool CFramebuffer::alloc(int w, int h, uint32_t drmFormat) {
         Debug::log(LOG, "Framebuffer created, status {}", status);
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     m_vSize = Vector2D(w, h);
@@ -62,7 +61,7 @@ void CFramebuffer::addStencil(SP<CTexture> tex) {
     // TODO: Allow this with gles2
 #ifndef GLES2
     m_pStencilTex = tex;
-    glBindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, m_vSize.x, m_vSize.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
 
     glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
@@ -72,7 +71,6 @@ void CFramebuffer::addStencil(SP<CTexture> tex) {
     auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     RASSERT((status == GL_FRAMEBUFFER_COMPLETE), "Failed adding a stencil to fbo!", status);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 #endif
 }
@@ -23,6 +23,10 @@
 #include "pass/PreBlurElement.hpp"
 #include "pass/ClearPassElement.hpp"
 #include "render/Shader.hpp"
+#include "RasterPool.hpp"
+#include "ReadbackPool.hpp"
+#include "ShaderCache.hpp"
+#include "TextEngine.hpp"
 #include <string>
 #include <xf86drm.h>
 #include <fcntl.h>
@@ -341,6 +345,8 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_drmFD) {
     Debug::log(LOG, "Renderer: {}", (char*)glGetString(GL_RENDERER));
     Debug::log(LOG, "Supported extensions: ({}) {}", std::count(m_szExtensions.begin(), m_szExtensions.end(), ' '), m_szExtensions);
 
+    NShaderCache::init();
+
     m_sExts.EXT_read_format_bgra = m_szExtensions.contains("GL_EXT_read_format_bgra");
 
     RASSERT(m_szExtensions.contains("GL_EXT_texture_format_BGRA8888"), "GL_EXT_texture_format_BGRA8888 support by the GPU driver is required");
@@ -366,8 +372,13 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_iDRMFD(g_pCompositor->m_drmFD) {
 
     initDRMFormats();
 
+    m_pTextEngine = makeUnique<CTextEngine>();
+    m_pRasterPool = makeUnique<CRasterPool>();
+
     initAssets();
 
+    m_pReadbackPool = makeUnique<CReadbackPool>();
+
     static auto P = g_pHookSystem->hookDynamic("preRender", [&](void* self, SCallbackInfo& info, std::any data) { preRender(std::any_cast<PHLMONITOR>(data)); });
 
     RASSERT(eglMakeCurrent(m_pEglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
@@ -599,47 +610,84 @@ void CHyprOpenGLImpl::logShaderError(const GLuint& shader, bool program, bool si
 }
 
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag, bool dynamic, bool silent) {
-    auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert, dynamic, silent);
-    if (dynamic) {
-        if (vertCompiled == 0)
-            return 0;
-    } else
-        RASSERT(vertCompiled, "Compiling shader failed. VERTEX nullptr! Shader source:\n\n{}", vert);
+    GLuint prog = 0;
+    createPrograms({{&prog, &vert, &frag}}, dynamic, silent);
+    return prog;
+}
 
-    auto fragCompiled = compileShader(GL_FRAGMENT_SHADER, frag, dynamic, silent);
-    if (dynamic) {
-        if (fragCompiled == 0)
-            return 0;
-    } else
-        RASSERT(fragCompiled, "Compiling shader failed. FRAGMENT nullptr! Shader source:\n\n{}", frag);
+bool CHyprOpenGLImpl::createPrograms(const std::vector<SProgramSource>& programs, bool dynamic, bool silent) {
+    struct SPending {
+        GLuint vert   = 0;
+        GLuint frag   = 0;
+        bool   cached = false;
+    };
 
-    auto prog = glCreateProgram();
-    glAttachShader(prog, vertCompiled);
-    glAttachShader(prog, fragCompiled);
-    glLinkProgram(prog);
+    std::vector<SPending> pending(programs.size());
 
-    glDetachShader(prog, vertCompiled);
-    glDetachShader(prog, fragCompiled);
-    glDeleteShader(vertCompiled);
-    glDeleteShader(fragCompiled);
+    // issue every compile and link before asking for any status, drivers with KHR_parallel_shader_compile
+    // then build them side by side instead of one after another
+    for (size_t i = 0; i < programs.size(); ++i) {
+        const auto& SRC = programs[i];
+        auto&       p   = pending[i];
 
-    GLint ok;
-    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
-    if (dynamic) {
-        if (ok == GL_FALSE) {
-            logShaderError(prog, true, silent);
-            return 0;
+        *SRC.program = NShaderCache::load(*SRC.vert, *SRC.frag);
+        if (*SRC.program) {
+            p.cached = true;
+            continue;
         }
-    } else {
-        if (ok != GL_TRUE)
-            logShaderError(prog, true);
-        RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
+
+        p.vert = compileShader(GL_VERTEX_SHADER, *SRC.vert);
+        p.frag = compileShader(GL_FRAGMENT_SHADER, *SRC.frag);
+
+        *SRC.program = glCreateProgram();
+#ifndef GLES2
+        glProgramParameteri(*SRC.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        glAttachShader(*SRC.program, p.vert);
+        glAttachShader(*SRC.program, p.frag);
+        glLinkProgram(*SRC.program);
     }
 
-    return prog;
+    bool allOk = true;
+
+    for (size_t i = 0; i < programs.size(); ++i) {
+        const auto& SRC = programs[i];
+        const auto& P   = pending[i];
+
+        if (P.cached)
+            continue;
+
+        const bool VERTOK = shaderStatusOK(P.vert, false, silent);
+        if (!dynamic)
+            RASSERT(VERTOK, "Compiling shader failed. VERTEX nullptr! Shader source:\n\n{}", *SRC.vert);
+
+        const bool FRAGOK = VERTOK && shaderStatusOK(P.frag, false, silent);
+        if (!dynamic)
+            RASSERT(FRAGOK, "Compiling shader failed. FRAGMENT nullptr! Shader source:\n\n{}", *SRC.frag);
+
+        const bool LINKOK = FRAGOK && shaderStatusOK(*SRC.program, true, silent);
+        if (!dynamic)
+            RASSERT(LINKOK, "createProgram() failed! GL_LINK_STATUS not OK!");
+
+        glDetachShader(*SRC.program, P.vert);
+        glDetachShader(*SRC.program, P.frag);
+        glDeleteShader(P.vert);
+        glDeleteShader(P.frag);
+
+        if (!LINKOK) {
+            glDeleteProgram(*SRC.program);
+            *SRC.program = 0;
+            allOk        = false;
+            continue;
+        }
+
+        NShaderCache::save(*SRC.program, *SRC.vert, *SRC.frag);
+    }
+
+    return allOk;
 }
 
-GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, std::string src, bool dynamic, bool silent) {
+GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, const std::string& src) {
     auto shader = glCreateShader(type);
 
     auto shaderSource = src.c_str();
@@ -647,26 +695,28 @@ GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, std::string src, bool
     glShaderSource(shader, 1, (const GLchar**)&shaderSource, nullptr);
     glCompileShader(shader);
 
+    return shader;
+}
+
+bool CHyprOpenGLImpl::shaderStatusOK(const GLuint& shader, bool program, bool silent) {
     GLint ok;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (program)
+        glGetProgramiv(shader, GL_LINK_STATUS, &ok);
+    else
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
 
-    if (dynamic) {
-        if (ok == GL_FALSE) {
-            logShaderError(shader, false, silent);
-            return 0;
-        }
-    } else {
-        if (ok != GL_TRUE)
-            logShaderError(shader, false);
-        RASSERT(ok != GL_FALSE, "compileShader() failed! GL_COMPILE_STATUS not OK!");
-    }
+    if (ok != GL_TRUE)
+        logShaderError(shader, program, silent);
 
-    return shader;
+    return ok == GL_TRUE;
 }
 
 void CHyprOpenGLImpl::beginSimple(PHLMONITOR pMonitor, const CRegion& damage, SP<CRenderbuffer> rb, CFramebuffer* fb) {
     m_RenderData.pMonitor = pMonitor;
 
+    // plugins and whatever ran since the last frame may have touched GL behind our back
+    invalidateGLState();
+
 #ifndef GLES2
     const GLenum RESETSTATUS = glGetGraphicsResetStatus();
     if (RESETSTATUS != GL_NO_ERROR) {
@@ -719,6 +769,9 @@ void CHyprOpenGLImpl::beginSimple(PHLMONITOR pMonitor, const CRegion& damage, SP
 void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFramebuffer* fb, std::optional<CRegion> finalDamage) {
     m_RenderData.pMonitor = pMonitor;
 
+    // plugins and whatever ran since the last frame may have touched GL behind our back
+    invalidateGLState();
+
 #ifndef GLES2
     const GLenum RESETSTATUS = glGetGraphicsResetStatus();
     if (RESETSTATUS != GL_NO_ERROR) {
@@ -853,6 +906,12 @@ void CHyprOpenGLImpl::end() {
     if (m_RenderData.pCurrentMonData->offMainFB.isAllocated())
         m_RenderData.pCurrentMonData->offMainFB.release();
 
+    // uploads until the next frame start from a clean slate
+    invalidateGLState();
+
+    m_glCallsLastFrame = m_glCalls;
+    m_glCalls          = {};
+
     // check for gl errors
     const GLenum ERR = glGetError();
 
@@ -991,20 +1050,37 @@ bool CHyprOpenGLImpl::initShaders() {
         const auto TEXFRAGSRCEXT          = processShader("ext.frag", includes);
         const auto FRAGBLUR1              = processShader("blur1.frag", includes);
         const auto FRAGBLUR2              = processShader("blur2.frag", includes);
+        const auto TEXTVERTSRC            = processShader("text.vert", includes);
+        const auto TEXTFRAGSRC            = processShader("text.frag", includes);
+
+        const auto&                       VERTCM   = m_bCMSupported ? shaders->TEXVERTSRC300 : shaders->TEXVERTSRC;
+        const std::vector<SProgramSource> PROGRAMS = {
+            {&shaders->m_shQUAD.program,         &shaders->TEXVERTSRC, &QUADFRAGSRC},
+            {&shaders->m_shRGBA.program,         &shaders->TEXVERTSRC, &TEXFRAGSRCRGBA},
+            {&shaders->m_shPASSTHRURGBA.program, &shaders->TEXVERTSRC, &TEXFRAGSRCRGBAPASSTHRU},
+            {&shaders->m_shMATTE.program,        &shaders->TEXVERTSRC, &TEXFRAGSRCRGBAMATTE},
+            {&shaders->m_shGLITCH.program,       &shaders->TEXVERTSRC, &FRAGGLITCH},
+            {&shaders->m_shRGBX.program,         &shaders->TEXVERTSRC, &TEXFRAGSRCRGBX},
+            {&shaders->m_shEXT.program,          &shaders->TEXVERTSRC, &TEXFRAGSRCEXT},
+            {&shaders->m_shBLUR1.program,        &shaders->TEXVERTSRC, &FRAGBLUR1},
+            {&shaders->m_shBLUR2.program,        &shaders->TEXVERTSRC, &FRAGBLUR2},
+            {&shaders->m_shBLURPREPARE.program,  &VERTCM,              &FRAGBLURPREPARE},
+            {&shaders->m_shBLURFINISH.program,   &VERTCM,              &FRAGBLURFINISH},
+            {&shaders->m_shSHADOW.program,       &VERTCM,              &FRAGSHADOW},
+            {&shaders->m_shBORDER1.program,      &VERTCM,              &FRAGBORDER1},
+            {&shaders->m_shTEXT.program,         &TEXTVERTSRC,         &TEXTFRAGSRC},
+        };
 
-        prog = createProgram(shaders->TEXVERTSRC, QUADFRAGSRC, isDynamic);
-        if (!prog)
+        if (!createPrograms(PROGRAMS, isDynamic))
             return false;
-        shaders->m_shQUAD.program = prog;
+
+        prog = shaders->m_shQUAD.program;
         getRoundingShaderUniforms(shaders->m_shQUAD);
         shaders->m_shQUAD.proj      = glGetUniformLocation(prog, "proj");
         shaders->m_shQUAD.color     = glGetUniformLocation(prog, "color");
         shaders->m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
 
-        prog = createProgram(shaders->TEXVERTSRC, TEXFRAGSRCRGBA, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shRGBA.program = prog;
+        prog = shaders->m_shRGBA.program;
         getRoundingShaderUniforms(shaders->m_shRGBA);
         shaders->m_shRGBA.proj              = glGetUniformLocation(prog, "proj");
         shaders->m_shRGBA.tex               = glGetUniformLocation(prog, "tex");
@@ -1020,29 +1096,20 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shRGBA.tint              = glGetUniformLocation(prog, "tint");
         shaders->m_shRGBA.useAlphaMatte     = glGetUniformLocation(prog, "useAlphaMatte");
 
-        prog = createProgram(shaders->TEXVERTSRC, TEXFRAGSRCRGBAPASSTHRU, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shPASSTHRURGBA.program   = prog;
+        prog                                = shaders->m_shPASSTHRURGBA.program;
         shaders->m_shPASSTHRURGBA.proj      = glGetUniformLocation(prog, "proj");
         shaders->m_shPASSTHRURGBA.tex       = glGetUniformLocation(prog, "tex");
         shaders->m_shPASSTHRURGBA.texAttrib = glGetAttribLocation(prog, "texcoord");
         shaders->m_shPASSTHRURGBA.posAttrib = glGetAttribLocation(prog, "pos");
 
-        prog = createProgram(shaders->TEXVERTSRC, TEXFRAGSRCRGBAMATTE, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shMATTE.program    = prog;
+        prog                          = shaders->m_shMATTE.program;
         shaders->m_shMATTE.proj       = glGetUniformLocation(prog, "proj");
         shaders->m_shMATTE.tex        = glGetUniformLocation(prog, "tex");
         shaders->m_shMATTE.alphaMatte = glGetUniformLocation(prog, "texMatte");
         shaders->m_shMATTE.texAttrib  = glGetAttribLocation(prog, "texcoord");
         shaders->m_shMATTE.posAttrib  = glGetAttribLocation(prog, "pos");
 
-        prog = createProgram(shaders->TEXVERTSRC, FRAGGLITCH, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shGLITCH.program   = prog;
+        prog                          = shaders->m_shGLITCH.program;
         shaders->m_shGLITCH.proj      = glGetUniformLocation(prog, "proj");
         shaders->m_shGLITCH.tex       = glGetUniformLocation(prog, "tex");
         shaders->m_shGLITCH.texAttrib = glGetAttribLocation(prog, "texcoord");
@@ -1051,10 +1118,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shGLITCH.time      = glGetUniformLocation(prog, "time");
         shaders->m_shGLITCH.fullSize  = glGetUniformLocation(prog, "screenSize");
 
-        prog = createProgram(shaders->TEXVERTSRC, TEXFRAGSRCRGBX, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shRGBX.program = prog;
+        prog = shaders->m_shRGBX.program;
         getRoundingShaderUniforms(shaders->m_shRGBX);
         shaders->m_shRGBX.tex               = glGetUniformLocation(prog, "tex");
         shaders->m_shRGBX.proj              = glGetUniformLocation(prog, "proj");
@@ -1067,10 +1131,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shRGBX.applyTint         = glGetUniformLocation(prog, "applyTint");
         shaders->m_shRGBX.tint              = glGetUniformLocation(prog, "tint");
 
-        prog = createProgram(shaders->TEXVERTSRC, TEXFRAGSRCEXT, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shEXT.program = prog;
+        prog = shaders->m_shEXT.program;
         getRoundingShaderUniforms(shaders->m_shEXT);
         shaders->m_shEXT.tex               = glGetUniformLocation(prog, "tex");
         shaders->m_shEXT.proj              = glGetUniformLocation(prog, "proj");
@@ -1083,10 +1144,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shEXT.applyTint         = glGetUniformLocation(prog, "applyTint");
         shaders->m_shEXT.tint              = glGetUniformLocation(prog, "tint");
 
-        prog = createProgram(shaders->TEXVERTSRC, FRAGBLUR1, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLUR1.program           = prog;
+        prog                                 = shaders->m_shBLUR1.program;
         shaders->m_shBLUR1.tex               = glGetUniformLocation(prog, "tex");
         shaders->m_shBLUR1.alpha             = glGetUniformLocation(prog, "alpha");
         shaders->m_shBLUR1.proj              = glGetUniformLocation(prog, "proj");
@@ -1098,10 +1156,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBLUR1.vibrancy          = glGetUniformLocation(prog, "vibrancy");
         shaders->m_shBLUR1.vibrancy_darkness = glGetUniformLocation(prog, "vibrancy_darkness");
 
-        prog = createProgram(shaders->TEXVERTSRC, FRAGBLUR2, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLUR2.program   = prog;
+        prog                         = shaders->m_shBLUR2.program;
         shaders->m_shBLUR2.tex       = glGetUniformLocation(prog, "tex");
         shaders->m_shBLUR2.alpha     = glGetUniformLocation(prog, "alpha");
         shaders->m_shBLUR2.proj      = glGetUniformLocation(prog, "proj");
@@ -1110,10 +1165,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBLUR2.radius    = glGetUniformLocation(prog, "radius");
         shaders->m_shBLUR2.halfpixel = glGetUniformLocation(prog, "halfpixel");
 
-        prog = createProgram(m_bCMSupported ? shaders->TEXVERTSRC300 : shaders->TEXVERTSRC, FRAGBLURPREPARE, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLURPREPARE.program = prog;
+        prog = shaders->m_shBLURPREPARE.program;
         if (m_bCMSupported)
             getCMShaderUniforms(shaders->m_shBLURPREPARE);
 
@@ -1124,10 +1176,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBLURPREPARE.contrast   = glGetUniformLocation(prog, "contrast");
         shaders->m_shBLURPREPARE.brightness = glGetUniformLocation(prog, "brightness");
 
-        prog = createProgram(m_bCMSupported ? shaders->TEXVERTSRC300 : shaders->TEXVERTSRC, FRAGBLURFINISH, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLURFINISH.program = prog;
+        prog = shaders->m_shBLURFINISH.program;
         // getCMShaderUniforms(shaders->m_shBLURFINISH);
 
         shaders->m_shBLURFINISH.tex        = glGetUniformLocation(prog, "tex");
@@ -1137,12 +1186,9 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBLURFINISH.brightness = glGetUniformLocation(prog, "brightness");
         shaders->m_shBLURFINISH.noise      = glGetUniformLocation(prog, "noise");
 
-        prog = createProgram(m_bCMSupported ? shaders->TEXVERTSRC300 : shaders->TEXVERTSRC, FRAGSHADOW, isDynamic);
-        if (!prog)
-            return false;
+        prog = shaders->m_shSHADOW.program;
         if (m_bCMSupported)
-            shaders->m_shSHADOW.program = prog;
-        getCMShaderUniforms(shaders->m_shSHADOW);
+            getCMShaderUniforms(shaders->m_shSHADOW);
         getRoundingShaderUniforms(shaders->m_shSHADOW);
         shaders->m_shSHADOW.proj        = glGetUniformLocation(prog, "proj");
         shaders->m_shSHADOW.posAttrib   = glGetAttribLocation(prog, "pos");
@@ -1152,10 +1198,7 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shSHADOW.shadowPower = glGetUniformLocation(prog, "shadowPower");
         shaders->m_shSHADOW.color       = glGetUniformLocation(prog, "color");
 
-        prog = createProgram(m_bCMSupported ? shaders->TEXVERTSRC300 : shaders->TEXVERTSRC, FRAGBORDER1, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBORDER1.program = prog;
+        prog = shaders->m_shBORDER1.program;
         if (m_bCMSupported)
             getCMShaderUniforms(shaders->m_shBORDER1);
 
@@ -1175,6 +1218,15 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBORDER1.angle2                = glGetUniformLocation(prog, "angle2");
         shaders->m_shBORDER1.gradientLerp          = glGetUniformLocation(prog, "gradientLerp");
         shaders->m_shBORDER1.alpha                 = glGetUniformLocation(prog, "alpha");
+
+        prog                             = shaders->m_shTEXT.program;
+        shaders->m_shTEXT.proj           = glGetUniformLocation(prog, "proj");
+        shaders->m_shTEXT.tex            = glGetUniformLocation(prog, "tex");
+        shaders->m_shTEXT.color          = glGetUniformLocation(prog, "color");
+        shaders->m_shTEXT.fullSize       = glGetUniformLocation(prog, "fullSize");
+        shaders->m_shTEXT.posAttrib      = glGetAttribLocation(prog, "pos");
+        shaders->m_shTEXT.glyphBoxAttrib = glGetAttribLocation(prog, "glyphBox");
+        shaders->m_shTEXT.glyphUVAttrib  = glGetAttribLocation(prog, "glyphUV");
     } catch (const std::exception& e) {
         if (!m_bShadersInitialized)
             throw e;
@@ -1186,6 +1238,9 @@ bool CHyprOpenGLImpl::initShaders() {
     m_shaders             = shaders;
     m_bShadersInitialized = true;
 
+    // the old programs are gone, their names may be reused
+    invalidateGLState();
+
     Debug::log(LOG, "Shaders initialized successfully.");
     g_pHyprError->destroy();
     return true;
@@ -1196,6 +1251,7 @@ void CHyprOpenGLImpl::applyScreenShader(const std::string& path) {
     static auto PDT = CConfigValue<Hyprlang::INT>("debug:damage_tracking");
 
     m_sFinalScreenShader.destroy();
+    invalidateGLState();
 
     if (path == "" || path == STRVAL_EMPTY)
         return;
@@ -1261,36 +1317,131 @@ void CHyprOpenGLImpl::clear(const CHyprColor& color) {
 }
 
 void CHyprOpenGLImpl::blend(bool enabled) {
+    m_bBlend = enabled;
+
+    if (m_glState.blend == enabled) {
+        m_glCalls.skipped++;
+        return;
+    }
+
     if (enabled) {
         glEnable(GL_BLEND);
         glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); // everything is premultiplied
     } else
         glDisable(GL_BLEND);
 
-    m_bBlend = enabled;
+    m_glState.blend = enabled;
+    m_glCalls.issued++;
+}
+
+void CHyprOpenGLImpl::useProgram(GLuint program) {
+    if (m_glState.program == program) {
+        m_glCalls.skipped++;
+        return;
+    }
+
+    glUseProgram(program);
+    m_glState.program = program;
+    m_glCalls.issued++;
+}
+
+void CHyprOpenGLImpl::activeTexture(GLenum unit) {
+    if (m_glState.activeTexture == unit) {
+        m_glCalls.skipped++;
+        return;
+    }
+
+    glActiveTexture(unit);
+    m_glState.activeTexture = unit;
+    m_glCalls.issued++;
+}
+
+void CHyprOpenGLImpl::bindTexture(GLenum target, GLuint texture) {
+    m_glCalls.issued++;
+
+    // can't know which unit this lands on
+    if (!m_glState.activeTexture) {
+        glBindTexture(target, texture);
+        return;
+    }
+
+    const auto KEY = std::make_pair(*m_glState.activeTexture, target);
+
+    if (auto it = m_glState.textures.find(KEY); it != m_glState.textures.end() && it->second == texture) {
+        m_glCalls.issued--;
+        m_glCalls.skipped++;
+        return;
+    }
+
+    glBindTexture(target, texture);
+    m_glState.textures[KEY] = texture;
+}
+
+void CHyprOpenGLImpl::invalidateGLState() {
+    m_glState = {};
+
+    // raw glUniform* on our programs would desync their caches just the same
+    if (m_shaders) {
+        for (auto* shader : {&m_shaders->m_shQUAD, &m_shaders->m_shRGBA, &m_shaders->m_shPASSTHRURGBA, &m_shaders->m_shMATTE, &m_shaders->m_shRGBX, &m_shaders->m_shEXT,
+                             &m_shaders->m_shBLUR1, &m_shaders->m_shBLUR2, &m_shaders->m_shBLURPREPARE, &m_shaders->m_shBLURFINISH, &m_shaders->m_shSHADOW,
+                             &m_shaders->m_shBORDER1, &m_shaders->m_shGLITCH, &m_shaders->m_shCM, &m_shaders->m_shTEXT}) {
+            shader->invalidateUniformCache();
+        }
+    }
+
+    m_sFinalScreenShader.invalidateUniformCache();
+}
+
+void CHyprOpenGLImpl::onTextureDestroyed(GLuint texture) {
+    // deleting a texture unbinds it from every unit
+    for (auto& [_, bound] : m_glState.textures) {
+        if (bound == texture)
+            bound = 0;
+    }
+}
+
+void CHyprOpenGLImpl::scissorTest(bool enabled) {
+    if (m_glState.scissorTest == enabled) {
+        m_glCalls.skipped++;
+        return;
+    }
+
+    if (enabled)
+        glEnable(GL_SCISSOR_TEST);
+    else
+        glDisable(GL_SCISSOR_TEST);
+
+    m_glState.scissorTest = enabled;
+    m_glCalls.issued++;
 }
 
 void CHyprOpenGLImpl::scissor(const CBox& originalBox, bool transform) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
+    CBox box = originalBox;
+
     if (transform) {
-        CBox       box = originalBox;
-        const auto TR  = wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform));
+        const auto TR = wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform));
         box.transform(TR, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y);
-        glScissor(box.x, box.y, box.width, box.height);
-        glEnable(GL_SCISSOR_TEST);
-        return;
     }
 
-    glScissor(originalBox.x, originalBox.y, originalBox.width, originalBox.height);
-    glEnable(GL_SCISSOR_TEST);
+    const std::array<GLint, 4> SCISSORBOX = {(GLint)box.x, (GLint)box.y, (GLint)box.width, (GLint)box.height};
+
+    if (m_glState.scissorBox != SCISSORBOX) {
+        glScissor(SCISSORBOX[0], SCISSORBOX[1], SCISSORBOX[2], SCISSORBOX[3]);
+        m_glState.scissorBox = SCISSORBOX;
+        m_glCalls.issued++;
+    } else
+        m_glCalls.skipped++;
+
+    scissorTest(true);
 }
 
 void CHyprOpenGLImpl::scissor(const pixman_box32* pBox, bool transform) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
     if (!pBox) {
-        glDisable(GL_SCISSOR_TEST);
+        scissorTest(false);
         return;
     }
 
@@ -1369,17 +1520,17 @@ void CHyprOpenGLImpl::renderRectWithDamage(const CBox& box, const CHyprColor& co
         newBox, wlTransformToHyprutils(invertTransform(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform)), newBox.rot);
     Mat3x3 glMatrix = m_RenderData.projection.copy().multiply(matrix);
 
-    glUseProgram(m_shaders->m_shQUAD.program);
+    useProgram(m_shaders->m_shQUAD.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_shaders->m_shQUAD.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    m_shaders->m_shQUAD.setUniformMatrix3fv(m_shaders->m_shQUAD.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
     glUniformMatrix3fv(m_RenderData.pCurrentMonData->m_shQUAD.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
     // premultiply the color as well as we don't work with straight alpha
-    glUniform4f(m_shaders->m_shQUAD.color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
+    m_shaders->m_shQUAD.setUniform4f(m_shaders->m_shQUAD.color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
 
     CBox transformedBox = box;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -1389,10 +1540,10 @@ void CHyprOpenGLImpl::renderRectWithDamage(const CBox& box, const CHyprColor& co
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
     // Rounded corners
-    glUniform2f(m_shaders->m_shQUAD.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_shaders->m_shQUAD.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(m_shaders->m_shQUAD.radius, round);
-    glUniform1f(m_shaders->m_shQUAD.roundingPower, roundingPower);
+    m_shaders->m_shQUAD.setUniform2f(m_shaders->m_shQUAD.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    m_shaders->m_shQUAD.setUniform2f(m_shaders->m_shQUAD.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    m_shaders->m_shQUAD.setUniform1f(m_shaders->m_shQUAD.radius, round);
+    m_shaders->m_shQUAD.setUniform1f(m_shaders->m_shQUAD.roundingPower, roundingPower);
 
     glVertexAttribPointer(m_shaders->m_shQUAD.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
@@ -1437,10 +1588,10 @@ void CHyprOpenGLImpl::renderTextureWithDamage(SP<CTexture> tex, const CBox& box,
     scissor(nullptr);
 }
 
-void CHyprOpenGLImpl::passCMUniforms(const CShader& shader, const NColorManagement::SImageDescription& imageDescription,
+void CHyprOpenGLImpl::passCMUniforms(CShader& shader, const NColorManagement::SImageDescription& imageDescription,
                                      const NColorManagement::SImageDescription& targetImageDescription, bool modifySDR) {
-    glUniform1i(shader.sourceTF, imageDescription.transferFunction);
-    glUniform1i(shader.targetTF, targetImageDescription.transferFunction);
+    shader.setUniform1i(shader.sourceTF, imageDescription.transferFunction);
+    shader.setUniform1i(shader.targetTF, targetImageDescription.transferFunction);
     const auto sourcePrimaries =
         imageDescription.primariesNameSet || imageDescription.primaries == SPCPRimaries{} ? getPrimaries(imageDescription.primariesNamed) : imageDescription.primaries;
     const auto    targetPrimaries = targetImageDescription.primariesNameSet || targetImageDescription.primaries == SPCPRimaries{} ?
@@ -1455,24 +1606,24 @@ void CHyprOpenGLImpl::passCMUniforms(const CShader& shader, const NColorManageme
         targetPrimaries.red.x,  targetPrimaries.red.y,  targetPrimaries.green.x, targetPrimaries.green.y,
         targetPrimaries.blue.x, targetPrimaries.blue.y, targetPrimaries.white.x, targetPrimaries.white.y,
     };
-    glUniformMatrix4x2fv(shader.sourcePrimaries, 1, false, glSourcePrimaries);
-    glUniformMatrix4x2fv(shader.targetPrimaries, 1, false, glTargetPrimaries);
+    shader.setUniformMatrix4x2fv(shader.sourcePrimaries, 1, false, glSourcePrimaries);
+    shader.setUniformMatrix4x2fv(shader.targetPrimaries, 1, false, glTargetPrimaries);
 
     const float maxLuminance = imageDescription.luminances.max > 0 ? imageDescription.luminances.max : imageDescription.luminances.reference;
-    glUniform1f(shader.maxLuminance, maxLuminance * targetImageDescription.luminances.reference / imageDescription.luminances.reference);
-    glUniform1f(shader.dstMaxLuminance, targetImageDescription.luminances.max > 0 ? targetImageDescription.luminances.max : 10000);
-    glUniform1f(shader.dstRefLuminance, targetImageDescription.luminances.reference);
-    glUniform1f(shader.sdrSaturation,
-                modifySDR && m_RenderData.pMonitor->sdrSaturation > 0 && targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                    m_RenderData.pMonitor->sdrSaturation :
-                    1.0f);
-    glUniform1f(shader.sdrBrightness,
-                modifySDR && m_RenderData.pMonitor->sdrBrightness > 0 && targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                    m_RenderData.pMonitor->sdrBrightness :
-                    1.0f);
-}
-
-void CHyprOpenGLImpl::passCMUniforms(const CShader& shader, const SImageDescription& imageDescription) {
+    shader.setUniform1f(shader.maxLuminance, maxLuminance * targetImageDescription.luminances.reference / imageDescription.luminances.reference);
+    shader.setUniform1f(shader.dstMaxLuminance, targetImageDescription.luminances.max > 0 ? targetImageDescription.luminances.max : 10000);
+    shader.setUniform1f(shader.dstRefLuminance, targetImageDescription.luminances.reference);
+    shader.setUniform1f(shader.sdrSaturation,
+                        modifySDR && m_RenderData.pMonitor->sdrSaturation > 0 && targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
+                            m_RenderData.pMonitor->sdrSaturation :
+                            1.0f);
+    shader.setUniform1f(shader.sdrBrightness,
+                        modifySDR && m_RenderData.pMonitor->sdrBrightness > 0 && targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
+                            m_RenderData.pMonitor->sdrBrightness :
+                            1.0f);
+}
+
+void CHyprOpenGLImpl::passCMUniforms(CShader& shader, const SImageDescription& imageDescription) {
     passCMUniforms(shader, imageDescription, m_RenderData.pMonitor->imageDescription, true);
 }
 
@@ -1538,18 +1689,18 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, const CB
         texType = TEXTURE_RGBX;
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(tex->m_iTarget, tex->m_iTexID);
+    activeTexture(GL_TEXTURE0);
+    bindTexture(tex->m_iTarget, tex->m_iTexID);
 
-    glTexParameteri(tex->m_iTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(tex->m_iTarget, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    tex->setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    tex->setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
     if (m_RenderData.useNearestNeighbor) {
-        glTexParameteri(tex->m_iTarget, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(tex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     } else {
-        glTexParameteri(tex->m_iTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(tex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     }
 
     const auto imageDescription =
@@ -1564,48 +1715,48 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, const CB
     if (!skipCM && !usingFinalShader && (texType == TEXTURE_RGBA || texType == TEXTURE_RGBX))
         shader = &m_shaders->m_shCM;
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
     if (shader == &m_shaders->m_shCM) {
-        glUniform1i(shader->texType, texType);
+        shader->setUniform1i(shader->texType, texType);
         passCMUniforms(*shader, imageDescription);
     }
 
 #ifndef GLES2
-    glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-    glUniform1i(shader->tex, 0);
+    shader->setUniform1i(shader->tex, 0);
 
     if ((usingFinalShader && *PDT == 0) || CRASHING) {
-        glUniform1f(shader->time, m_tGlobalTimer.getSeconds() - shader->initialTime);
+        shader->setUniform1f(shader->time, m_tGlobalTimer.getSeconds() - shader->initialTime);
     } else if (usingFinalShader && shader->time != -1) {
         // Don't let time be unitialised
-        glUniform1f(shader->time, 0.f);
+        shader->setUniform1f(shader->time, 0.f);
     }
 
     if (usingFinalShader && shader->wl_output != -1)
-        glUniform1i(shader->wl_output, m_RenderData.pMonitor->ID);
+        shader->setUniform1i(shader->wl_output, m_RenderData.pMonitor->ID);
     if (usingFinalShader && shader->fullSize != -1)
-        glUniform2f(shader->fullSize, m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
+        shader->setUniform2f(shader->fullSize, m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
 
     if (CRASHING) {
-        glUniform1f(shader->distort, g_pHyprRenderer->m_fCrashingDistort);
-        glUniform2f(shader->fullSize, m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
+        shader->setUniform1f(shader->distort, g_pHyprRenderer->m_fCrashingDistort);
+        shader->setUniform2f(shader->fullSize, m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
     }
 
     if (!usingFinalShader) {
-        glUniform1f(shader->alpha, alpha);
+        shader->setUniform1f(shader->alpha, alpha);
 
         if (discardActive) {
-            glUniform1i(shader->discardOpaque, !!(m_RenderData.discardMode & DISCARD_OPAQUE));
-            glUniform1i(shader->discardAlpha, !!(m_RenderData.discardMode & DISCARD_ALPHA));
-            glUniform1f(shader->discardAlphaValue, m_RenderData.discardOpacity);
+            shader->setUniform1i(shader->discardOpaque, !!(m_RenderData.discardMode & DISCARD_OPAQUE));
+            shader->setUniform1i(shader->discardAlpha, !!(m_RenderData.discardMode & DISCARD_ALPHA));
+            shader->setUniform1f(shader->discardAlphaValue, m_RenderData.discardOpacity);
         } else {
-            glUniform1i(shader->discardOpaque, 0);
-            glUniform1i(shader->discardAlpha, 0);
+            shader->setUniform1i(shader->discardOpaque, 0);
+            shader->setUniform1i(shader->discardAlpha, 0);
         }
     }
 
@@ -1618,24 +1769,24 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, const CB
 
     if (!usingFinalShader) {
         // Rounded corners
-        glUniform2f(shader->topLeft, TOPLEFT.x, TOPLEFT.y);
-        glUniform2f(shader->fullSize, FULLSIZE.x, FULLSIZE.y);
-        glUniform1f(shader->radius, round);
-        glUniform1f(shader->roundingPower, roundingPower);
+        shader->setUniform2f(shader->topLeft, TOPLEFT.x, TOPLEFT.y);
+        shader->setUniform2f(shader->fullSize, FULLSIZE.x, FULLSIZE.y);
+        shader->setUniform1f(shader->radius, round);
+        shader->setUniform1f(shader->roundingPower, roundingPower);
 
         if (allowDim && m_RenderData.currentWindow) {
             if (m_RenderData.currentWindow->m_notRespondingTint->value() > 0) {
                 const auto DIM = m_RenderData.currentWindow->m_notRespondingTint->value();
-                glUniform1i(shader->applyTint, 1);
-                glUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
+                shader->setUniform1i(shader->applyTint, 1);
+                shader->setUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
             } else if (m_RenderData.currentWindow->m_dimPercent->value() > 0) {
-                glUniform1i(shader->applyTint, 1);
+                shader->setUniform1i(shader->applyTint, 1);
                 const auto DIM = m_RenderData.currentWindow->m_dimPercent->value();
-                glUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
+                shader->setUniform3f(shader->tint, 1.f - DIM, 1.f - DIM, 1.f - DIM);
             } else
-                glUniform1i(shader->applyTint, 0);
+                shader->setUniform1i(shader->applyTint, 0);
         } else
-            glUniform1i(shader->applyTint, 0);
+            shader->setUniform1i(shader->applyTint, 0);
     }
 
     const float verts[] = {
@@ -1680,8 +1831,6 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(SP<CTexture> tex, const CB
 
     glDisableVertexAttribArray(shader->posAttrib);
     glDisableVertexAttribArray(shader->texAttrib);
-
-    glBindTexture(tex->m_iTarget, 0);
 }
 
 void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, const CBox& box) {
@@ -1703,18 +1852,18 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, const CBox& box)
 
     CShader*   shader = &m_shaders->m_shPASSTHRURGBA;
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(tex->m_iTarget, tex->m_iTexID);
+    activeTexture(GL_TEXTURE0);
+    bindTexture(tex->m_iTarget, tex->m_iTexID);
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-    glUniform1i(shader->tex, 0);
+    shader->setUniform1i(shader->tex, 0);
 
     glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(shader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -1731,8 +1880,6 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, const CBox& box)
 
     glDisableVertexAttribArray(shader->posAttrib);
     glDisableVertexAttribArray(shader->texAttrib);
-
-    glBindTexture(tex->m_iTarget, 0);
 }
 
 void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFramebuffer& matte) {
@@ -1754,23 +1901,23 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
 
     CShader*   shader = &m_shaders->m_shMATTE;
 
-    glUseProgram(shader->program);
+    useProgram(shader->program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-    glUniform1i(shader->tex, 0);
-    glUniform1i(shader->alphaMatte, 1);
+    shader->setUniform1i(shader->tex, 0);
+    shader->setUniform1i(shader->alphaMatte, 1);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(tex->m_iTarget, tex->m_iTexID);
+    activeTexture(GL_TEXTURE0);
+    bindTexture(tex->m_iTarget, tex->m_iTexID);
 
-    glActiveTexture(GL_TEXTURE0 + 1);
+    activeTexture(GL_TEXTURE0 + 1);
     auto matteTex = matte.getTexture();
-    glBindTexture(matteTex->m_iTarget, matteTex->m_iTexID);
+    bindTexture(matteTex->m_iTarget, matteTex->m_iTexID);
 
     glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(shader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -1787,8 +1934,84 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
 
     glDisableVertexAttribArray(shader->posAttrib);
     glDisableVertexAttribArray(shader->texAttrib);
+}
+
+void CHyprOpenGLImpl::renderShapedText(SP<SShapedText> text, const Vector2D& pos, const CHyprColor& col, const CRegion& damage) {
+    RASSERT(m_RenderData.pMonitor, "Tried to render text without begin()!");
+
+    TRACY_GPU_ZONE("RenderShapedText");
+
+    if (!text || text->quads == 0 || damage.empty())
+        return;
+
+    CBox newBox = {pos, text->size};
+    m_RenderData.renderModif.applyToBox(newBox);
+
+    const auto TRANSFORM = wlTransformToHyprutils(invertTransform(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform));
+    Mat3x3     matrix    = m_RenderData.monitorProjection.projectBox(newBox, TRANSFORM, newBox.rot);
+    Mat3x3     glMatrix  = m_RenderData.projection.copy().multiply(matrix);
+
+    CShader*   shader = &m_shaders->m_shTEXT;
+
+    activeTexture(GL_TEXTURE0);
+    bindTexture(GL_TEXTURE_2D, text->atlas->m_iTexID);
+
+    useProgram(shader->program);
+
+#ifndef GLES2
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+#else
+    glMatrix.transpose();
+    shader->setUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+#endif
+    shader->setUniform1i(shader->tex, 0);
+    shader->setUniform4f(shader->color, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
+    shader->setUniform2f(shader->fullSize, text->size.x, text->size.y);
+
+    glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glEnableVertexAttribArray(shader->posAttrib);
+
+    const float* INSTANCES = text->instances.data();
+
+#ifndef GLES2
+    // one instance per glyph
+    glVertexAttribPointer(shader->glyphBoxAttrib, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), INSTANCES);
+    glVertexAttribPointer(shader->glyphUVAttrib, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), INSTANCES + 4);
+    glVertexAttribDivisor(shader->glyphBoxAttrib, 1);
+    glVertexAttribDivisor(shader->glyphUVAttrib, 1);
+    glEnableVertexAttribArray(shader->glyphBoxAttrib);
+    glEnableVertexAttribArray(shader->glyphUVAttrib);
+#endif
+
+    CRegion damageClip = damage;
+    if (!m_RenderData.clipBox.empty())
+        damageClip.intersect(m_RenderData.clipBox);
+
+    for (auto const& RECT : damageClip.getRects()) {
+        scissor(&RECT);
+#ifndef GLES2
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, text->quads);
+#else
+        // no instancing, every glyph is its own draw with constant attributes
+        for (size_t i = 0; i < text->quads; ++i) {
+            glVertexAttrib4fv(shader->glyphBoxAttrib, INSTANCES + i * 8);
+            glVertexAttrib4fv(shader->glyphUVAttrib, INSTANCES + i * 8 + 4);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+#endif
+    }
 
-    glBindTexture(tex->m_iTarget, 0);
+    scissor(nullptr);
+
+#ifndef GLES2
+    // the attribute slots are shared with every other shader
+    glVertexAttribDivisor(shader->glyphBoxAttrib, 0);
+    glVertexAttribDivisor(shader->glyphUVAttrib, 0);
+    glDisableVertexAttribArray(shader->glyphBoxAttrib);
+    glDisableVertexAttribArray(shader->glyphUVAttrib);
+#endif
+
+    glDisableVertexAttribArray(shader->posAttrib);
 }
 
 // This probably isn't the fastest
@@ -1840,40 +2063,37 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
         PMIRRORSWAPFB->bind();
 
-        glActiveTexture(GL_TEXTURE0);
+        activeTexture(GL_TEXTURE0);
 
         auto currentTex = m_RenderData.currentFB->getTexture();
 
-        glBindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
+        bindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
 
-        glTexParameteri(currentTex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_shaders->m_shBLURPREPARE.program);
+        useProgram(m_shaders->m_shBLURPREPARE.program);
 
         // From FB to sRGB
         const bool skipCM = !m_bCMSupported || m_RenderData.pMonitor->imageDescription == SImageDescription{};
-        glUniform1i(m_shaders->m_shBLURPREPARE.skipCM, skipCM);
+        m_shaders->m_shBLURPREPARE.setUniform1i(m_shaders->m_shBLURPREPARE.skipCM, skipCM);
         if (!skipCM) {
             passCMUniforms(m_shaders->m_shBLURPREPARE, m_RenderData.pMonitor->imageDescription, SImageDescription{});
-            glUniform1f(m_shaders->m_shBLURPREPARE.sdrSaturation,
-                        m_RenderData.pMonitor->sdrSaturation > 0 && m_RenderData.pMonitor->imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                            m_RenderData.pMonitor->sdrSaturation :
-                            1.0f);
-            glUniform1f(m_shaders->m_shBLURPREPARE.sdrBrightness,
-                        m_RenderData.pMonitor->sdrBrightness > 0 && m_RenderData.pMonitor->imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                            m_RenderData.pMonitor->sdrBrightness :
-                            1.0f);
+            const bool  PQ            = m_RenderData.pMonitor->imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ;
+            const float SDRSATURATION = PQ && m_RenderData.pMonitor->sdrSaturation > 0 ? m_RenderData.pMonitor->sdrSaturation : 1.0f;
+            const float SDRBRIGHTNESS = PQ && m_RenderData.pMonitor->sdrBrightness > 0 ? m_RenderData.pMonitor->sdrBrightness : 1.0f;
+            m_shaders->m_shBLURPREPARE.setUniform1f(m_shaders->m_shBLURPREPARE.sdrSaturation, SDRSATURATION);
+            m_shaders->m_shBLURPREPARE.setUniform1f(m_shaders->m_shBLURPREPARE.sdrBrightness, SDRBRIGHTNESS);
         }
 
 #ifndef GLES2
-        glUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+        m_shaders->m_shBLURPREPARE.setUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
         glMatrix.transpose();
-        glUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+        m_shaders->m_shBLURPREPARE.setUniformMatrix3fv(m_shaders->m_shBLURPREPARE.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-        glUniform1f(m_shaders->m_shBLURPREPARE.contrast, *PBLURCONTRAST);
-        glUniform1f(m_shaders->m_shBLURPREPARE.brightness, *PBLURBRIGHTNESS);
-        glUniform1i(m_shaders->m_shBLURPREPARE.tex, 0);
+        m_shaders->m_shBLURPREPARE.setUniform1f(m_shaders->m_shBLURPREPARE.contrast, *PBLURCONTRAST);
+        m_shaders->m_shBLURPREPARE.setUniform1f(m_shaders->m_shBLURPREPARE.brightness, *PBLURBRIGHTNESS);
+        m_shaders->m_shBLURPREPARE.setUniform1i(m_shaders->m_shBLURPREPARE.tex, 0);
 
         glVertexAttribPointer(m_shaders->m_shBLURPREPARE.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
         glVertexAttribPointer(m_shaders->m_shBLURPREPARE.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -1901,32 +2121,34 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         else
             PMIRRORFB->bind();
 
-        glActiveTexture(GL_TEXTURE0);
+        activeTexture(GL_TEXTURE0);
 
         auto currentTex = currentRenderToFB->getTexture();
 
-        glBindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
+        bindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
 
-        glTexParameteri(currentTex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(pShader->program);
+        useProgram(pShader->program);
 
         // prep two shaders
 #ifndef GLES2
-        glUniformMatrix3fv(pShader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+        pShader->setUniformMatrix3fv(pShader->proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
         glMatrix.transpose();
-        glUniformMatrix3fv(pShader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+        pShader->setUniformMatrix3fv(pShader->proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-        glUniform1f(pShader->radius, *PBLURSIZE * a); // this makes the blursize change with a
+        pShader->setUniform1f(pShader->radius, *PBLURSIZE * a); // this makes the blursize change with a
         if (pShader == &m_shaders->m_shBLUR1) {
-            glUniform2f(m_shaders->m_shBLUR1.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
-            glUniform1i(m_shaders->m_shBLUR1.passes, *PBLURPASSES);
-            glUniform1f(m_shaders->m_shBLUR1.vibrancy, *PBLURVIBRANCY);
-            glUniform1f(m_shaders->m_shBLUR1.vibrancy_darkness, *PBLURVIBRANCYDARKNESS);
+            m_shaders->m_shBLUR1.setUniform2f(m_shaders->m_shBLUR1.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f),
+                                              0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
+            m_shaders->m_shBLUR1.setUniform1i(m_shaders->m_shBLUR1.passes, *PBLURPASSES);
+            m_shaders->m_shBLUR1.setUniform1f(m_shaders->m_shBLUR1.vibrancy, *PBLURVIBRANCY);
+            m_shaders->m_shBLUR1.setUniform1f(m_shaders->m_shBLUR1.vibrancy_darkness, *PBLURVIBRANCYDARKNESS);
         } else
-            glUniform2f(m_shaders->m_shBLUR2.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
-        glUniform1i(pShader->tex, 0);
+            m_shaders->m_shBLUR2.setUniform2f(m_shaders->m_shBLUR2.halfpixel, 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f),
+                                              0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
+        pShader->setUniform1i(pShader->tex, 0);
 
         glVertexAttribPointer(pShader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
         glVertexAttribPointer(pShader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -1953,7 +2175,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     // draw the things.
     // first draw is swap -> mirr
     PMIRRORFB->bind();
-    glBindTexture(PMIRRORSWAPFB->getTexture()->m_iTarget, PMIRRORSWAPFB->getTexture()->m_iTexID);
+    bindTexture(PMIRRORSWAPFB->getTexture()->m_iTarget, PMIRRORSWAPFB->getTexture()->m_iTexID);
 
     // damage region will be scaled, make a temp
     CRegion tempDamage{damage};
@@ -1979,26 +2201,26 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         else
             PMIRRORFB->bind();
 
-        glActiveTexture(GL_TEXTURE0);
+        activeTexture(GL_TEXTURE0);
 
         auto currentTex = currentRenderToFB->getTexture();
 
-        glBindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
+        bindTexture(currentTex->m_iTarget, currentTex->m_iTexID);
 
-        glTexParameteri(currentTex->m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glUseProgram(m_shaders->m_shBLURFINISH.program);
+        useProgram(m_shaders->m_shBLURFINISH.program);
 
 #ifndef GLES2
-        glUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+        m_shaders->m_shBLURFINISH.setUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
         glMatrix.transpose();
-        glUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+        m_shaders->m_shBLURFINISH.setUniformMatrix3fv(m_shaders->m_shBLURFINISH.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-        glUniform1f(m_shaders->m_shBLURFINISH.noise, *PBLURNOISE);
-        glUniform1f(m_shaders->m_shBLURFINISH.brightness, *PBLURBRIGHTNESS);
+        m_shaders->m_shBLURFINISH.setUniform1f(m_shaders->m_shBLURFINISH.noise, *PBLURNOISE);
+        m_shaders->m_shBLURFINISH.setUniform1f(m_shaders->m_shBLURFINISH.brightness, *PBLURBRIGHTNESS);
 
-        glUniform1i(m_shaders->m_shBLURFINISH.tex, 0);
+        m_shaders->m_shBLURFINISH.setUniform1i(m_shaders->m_shBLURFINISH.tex, 0);
 
         glVertexAttribPointer(m_shaders->m_shBLURFINISH.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
         glVertexAttribPointer(m_shaders->m_shBLURFINISH.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -2022,9 +2244,6 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
             currentRenderToFB = PMIRRORSWAPFB;
     }
 
-    // finish
-    glBindTexture(PMIRRORFB->getTexture()->m_iTarget, 0);
-
     blend(BLENDBEFORE);
 
     return currentRenderToFB;
@@ -2330,25 +2549,25 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     const auto BLEND = m_bBlend;
     blend(true);
 
-    glUseProgram(m_shaders->m_shBORDER1.program);
+    useProgram(m_shaders->m_shBORDER1.program);
 
     const bool skipCM = !m_bCMSupported || m_RenderData.pMonitor->imageDescription == SImageDescription{};
-    glUniform1i(m_shaders->m_shBORDER1.skipCM, skipCM);
+    m_shaders->m_shBORDER1.setUniform1i(m_shaders->m_shBORDER1.skipCM, skipCM);
     if (!skipCM)
         passCMUniforms(m_shaders->m_shBORDER1, SImageDescription{});
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    m_shaders->m_shBORDER1.setUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    m_shaders->m_shBORDER1.setUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
-    glUniform4fv(m_shaders->m_shBORDER1.gradient, grad.m_colorsOkLabA.size() / 4, (float*)grad.m_colorsOkLabA.data());
-    glUniform1i(m_shaders->m_shBORDER1.gradientLength, grad.m_colorsOkLabA.size() / 4);
-    glUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
-    glUniform1f(m_shaders->m_shBORDER1.alpha, a);
-    glUniform1i(m_shaders->m_shBORDER1.gradient2Length, 0);
+    m_shaders->m_shBORDER1.setUniform4fv(m_shaders->m_shBORDER1.gradient, grad.m_colorsOkLabA.size() / 4, (float*)grad.m_colorsOkLabA.data());
+    m_shaders->m_shBORDER1.setUniform1i(m_shaders->m_shBORDER1.gradientLength, grad.m_colorsOkLabA.size() / 4);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.alpha, a);
+    m_shaders->m_shBORDER1.setUniform1i(m_shaders->m_shBORDER1.gradient2Length, 0);
 
     CBox transformedBox = newBox;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -2357,13 +2576,13 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     const auto TOPLEFT  = Vector2D(transformedBox.x, transformedBox.y);
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
-    glUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)newBox.width, (float)newBox.height);
-    glUniform1f(m_shaders->m_shBORDER1.radius, round);
-    glUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
-    glUniform1f(m_shaders->m_shBORDER1.roundingPower, roundingPower);
-    glUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)newBox.width, (float)newBox.height);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.radius, round);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.roundingPower, roundingPower);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
 
     glVertexAttribPointer(m_shaders->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(m_shaders->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -2428,24 +2647,24 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     const auto BLEND = m_bBlend;
     blend(true);
 
-    glUseProgram(m_shaders->m_shBORDER1.program);
+    useProgram(m_shaders->m_shBORDER1.program);
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    m_shaders->m_shBORDER1.setUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    m_shaders->m_shBORDER1.setUniformMatrix3fv(m_shaders->m_shBORDER1.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
 
-    glUniform4fv(m_shaders->m_shBORDER1.gradient, grad1.m_colorsOkLabA.size() / 4, (float*)grad1.m_colorsOkLabA.data());
-    glUniform1i(m_shaders->m_shBORDER1.gradientLength, grad1.m_colorsOkLabA.size() / 4);
-    glUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad1.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
+    m_shaders->m_shBORDER1.setUniform4fv(m_shaders->m_shBORDER1.gradient, grad1.m_colorsOkLabA.size() / 4, (float*)grad1.m_colorsOkLabA.data());
+    m_shaders->m_shBORDER1.setUniform1i(m_shaders->m_shBORDER1.gradientLength, grad1.m_colorsOkLabA.size() / 4);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.angle, (int)(grad1.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
     if (grad2.m_colorsOkLabA.size() > 0)
-        glUniform4fv(m_shaders->m_shBORDER1.gradient2, grad2.m_colorsOkLabA.size() / 4, (float*)grad2.m_colorsOkLabA.data());
-    glUniform1i(m_shaders->m_shBORDER1.gradient2Length, grad2.m_colorsOkLabA.size() / 4);
-    glUniform1f(m_shaders->m_shBORDER1.angle2, (int)(grad2.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
-    glUniform1f(m_shaders->m_shBORDER1.alpha, a);
-    glUniform1f(m_shaders->m_shBORDER1.gradientLerp, lerp);
+        m_shaders->m_shBORDER1.setUniform4fv(m_shaders->m_shBORDER1.gradient2, grad2.m_colorsOkLabA.size() / 4, (float*)grad2.m_colorsOkLabA.data());
+    m_shaders->m_shBORDER1.setUniform1i(m_shaders->m_shBORDER1.gradient2Length, grad2.m_colorsOkLabA.size() / 4);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.angle2, (int)(grad2.m_angle / (PI / 180.0)) % 360 * (PI / 180.0));
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.alpha, a);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.gradientLerp, lerp);
 
     CBox transformedBox = newBox;
     transformedBox.transform(wlTransformToHyprutils(invertTransform(m_RenderData.pMonitor->transform)), m_RenderData.pMonitor->vecTransformedSize.x,
@@ -2454,13 +2673,13 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     const auto TOPLEFT  = Vector2D(transformedBox.x, transformedBox.y);
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
-    glUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)newBox.width, (float)newBox.height);
-    glUniform1f(m_shaders->m_shBORDER1.radius, round);
-    glUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
-    glUniform1f(m_shaders->m_shBORDER1.roundingPower, roundingPower);
-    glUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    m_shaders->m_shBORDER1.setUniform2f(m_shaders->m_shBORDER1.fullSizeUntransformed, (float)newBox.width, (float)newBox.height);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.radius, round);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.radiusOuter, outerRound == -1 ? round : outerRound);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.roundingPower, roundingPower);
+    m_shaders->m_shBORDER1.setUniform1f(m_shaders->m_shBORDER1.thick, scaledBorderSize);
 
     glVertexAttribPointer(m_shaders->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(m_shaders->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -2516,32 +2735,32 @@ void CHyprOpenGLImpl::renderRoundedShadow(const CBox& box, int round, float roun
 
     blend(true);
 
-    glUseProgram(m_shaders->m_shSHADOW.program);
+    useProgram(m_shaders->m_shSHADOW.program);
     const bool skipCM = !m_bCMSupported || m_RenderData.pMonitor->imageDescription == SImageDescription{};
-    glUniform1i(m_shaders->m_shSHADOW.skipCM, skipCM);
+    m_shaders->m_shSHADOW.setUniform1i(m_shaders->m_shSHADOW.skipCM, skipCM);
     if (!skipCM)
         passCMUniforms(m_shaders->m_shSHADOW, SImageDescription{});
 
 #ifndef GLES2
-    glUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
+    m_shaders->m_shSHADOW.setUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_TRUE, glMatrix.getMatrix().data());
 #else
     glMatrix.transpose();
-    glUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
+    m_shaders->m_shSHADOW.setUniformMatrix3fv(m_shaders->m_shSHADOW.proj, 1, GL_FALSE, glMatrix.getMatrix().data());
 #endif
-    glUniform4f(m_shaders->m_shSHADOW.color, col.r, col.g, col.b, col.a * a);
+    m_shaders->m_shSHADOW.setUniform4f(m_shaders->m_shSHADOW.color, col.r, col.g, col.b, col.a * a);
 
     const auto TOPLEFT     = Vector2D(range + round, range + round);
     const auto BOTTOMRIGHT = Vector2D(newBox.width - (range + round), newBox.height - (range + round));
     const auto FULLSIZE    = Vector2D(newBox.width, newBox.height);
 
     // Rounded corners
-    glUniform2f(m_shaders->m_shSHADOW.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(m_shaders->m_shSHADOW.bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(m_shaders->m_shSHADOW.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(m_shaders->m_shSHADOW.radius, range + round);
-    glUniform1f(m_shaders->m_shSHADOW.roundingPower, roundingPower);
-    glUniform1f(m_shaders->m_shSHADOW.range, range);
-    glUniform1f(m_shaders->m_shSHADOW.shadowPower, SHADOWPOWER);
+    m_shaders->m_shSHADOW.setUniform2f(m_shaders->m_shSHADOW.topLeft, (float)TOPLEFT.x, (float)TOPLEFT.y);
+    m_shaders->m_shSHADOW.setUniform2f(m_shaders->m_shSHADOW.bottomRight, (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
+    m_shaders->m_shSHADOW.setUniform2f(m_shaders->m_shSHADOW.fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    m_shaders->m_shSHADOW.setUniform1f(m_shaders->m_shSHADOW.radius, range + round);
+    m_shaders->m_shSHADOW.setUniform1f(m_shaders->m_shSHADOW.roundingPower, roundingPower);
+    m_shaders->m_shSHADOW.setUniform1f(m_shaders->m_shSHADOW.range, range);
+    m_shaders->m_shSHADOW.setUniform1f(m_shaders->m_shSHADOW.shadowPower, SHADOWPOWER);
 
     glVertexAttribPointer(m_shaders->m_shSHADOW.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
     glVertexAttribPointer(m_shaders->m_shSHADOW.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
@@ -2619,28 +2838,24 @@ void CHyprOpenGLImpl::renderMirrored() {
     g_pHyprRenderer->m_sRenderPass.add(makeShared<CTexPassElement>(data));
 }
 
-void CHyprOpenGLImpl::renderSplash(cairo_t* const CAIRO, cairo_surface_t* const CAIROSURFACE, double offsetY, const Vector2D& size) {
-    static auto           PSPLASHCOLOR = CConfigValue<Hyprlang::INT>("misc:col.splash");
-    static auto           PSPLASHFONT  = CConfigValue<std::string>("misc:splash_font_family");
-    static auto           FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
+// painting below only uses its arguments, so it can run on a raster worker
 
-    const auto            FONTFAMILY = *PSPLASHFONT != STRVAL_EMPTY ? *PSPLASHFONT : *FALLBACKFONT;
-    const auto            FONTSIZE   = (int)(size.y / 76);
-    const auto            COLOR      = CHyprColor(*PSPLASHCOLOR);
+static void paintSplash(cairo_t* const CAIRO, const std::string& text, const std::string& fontFamily, const CHyprColor& color, double offsetY, const Vector2D& size) {
+    const auto            FONTSIZE = (int)(size.y / 76);
 
     PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
     PangoFontDescription* pangoFD    = pango_font_description_new();
 
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
+    pango_font_description_set_family_static(pangoFD, fontFamily.c_str());
     pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
     pango_font_description_set_style(pangoFD, PANGO_STYLE_NORMAL);
     pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
     pango_layout_set_font_description(layoutText, pangoFD);
 
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+    cairo_set_source_rgba(CAIRO, color.r, color.g, color.b, color.a);
 
     int textW = 0, textH = 0;
-    pango_layout_set_text(layoutText, g_pCompositor->m_currentSplash.c_str(), -1);
+    pango_layout_set_text(layoutText, text.c_str(), -1);
     pango_layout_get_size(layoutText, &textW, &textH);
     textW /= PANGO_SCALE;
     textH /= PANGO_SCALE;
@@ -2650,8 +2865,82 @@ void CHyprOpenGLImpl::renderSplash(cairo_t* const CAIRO, cairo_surface_t* const
 
     pango_font_description_free(pangoFD);
     g_object_unref(layoutText);
+}
+
+static cairo_surface_t* paintSplashSurface(const std::string& text, const std::string& fontFamily, const CHyprColor& color, const Vector2D& size) {
+    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size.x, size.y);
+    const auto CAIRO        = cairo_create(CAIROSURFACE);
+
+    // image surfaces start out cleared
+    cairo_set_antialias(CAIRO, CAIRO_ANTIALIAS_GOOD);
+    paintSplash(CAIRO, text, fontFamily, color, 0.02 * size.y, size);
+
+    cairo_destroy(CAIRO);
+    cairo_surface_flush(CAIROSURFACE);
+
+    return CAIROSURFACE;
+}
+
+static cairo_surface_t* paintText(const std::string& text, const CHyprColor& col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
+    const auto            FONTSIZE = pt;
+    const auto            COLOR    = col;
+
+    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1 /* only for measuring */);
+    auto                  CAIRO        = cairo_create(CAIROSURFACE);
+
+    PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
+    PangoFontDescription* pangoFD    = pango_font_description_new();
+
+    pango_font_description_set_family_static(pangoFD, fontFamily.c_str());
+    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
+    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
+    pango_font_description_set_weight(pangoFD, static_cast<PangoWeight>(weight));
+    pango_layout_set_font_description(layoutText, pangoFD);
+
+    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+
+    int textW = 0, textH = 0;
+    pango_layout_set_text(layoutText, text.c_str(), -1);
+
+    if (maxWidth > 0) {
+        pango_layout_set_width(layoutText, maxWidth * PANGO_SCALE);
+        pango_layout_set_ellipsize(layoutText, PANGO_ELLIPSIZE_END);
+    }
+
+    pango_layout_get_size(layoutText, &textW, &textH);
+    textW /= PANGO_SCALE;
+    textH /= PANGO_SCALE;
+
+    pango_font_description_free(pangoFD);
+    g_object_unref(layoutText);
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+
+    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
+    CAIRO        = cairo_create(CAIROSURFACE);
+
+    layoutText = pango_cairo_create_layout(CAIRO);
+    pangoFD    = pango_font_description_new();
+
+    pango_font_description_set_family_static(pangoFD, fontFamily.c_str());
+    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
+    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
+    pango_font_description_set_weight(pangoFD, static_cast<PangoWeight>(weight));
+    pango_layout_set_font_description(layoutText, pangoFD);
+    pango_layout_set_text(layoutText, text.c_str(), -1);
+
+    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+
+    cairo_move_to(CAIRO, 0, 0);
+    pango_cairo_show_layout(CAIRO, layoutText);
+
+    pango_font_description_free(pangoFD);
+    g_object_unref(layoutText);
 
+    cairo_destroy(CAIRO);
     cairo_surface_flush(CAIROSURFACE);
+
+    return CAIROSURFACE;
 }
 
 SP<CTexture> CHyprOpenGLImpl::loadAsset(const std::string& filename) {
@@ -2698,13 +2987,13 @@ SP<CTexture> CHyprOpenGLImpl::loadAsset(const std::string& filename) {
     const GLint glType   = CAIROFORMAT == CAIRO_FORMAT_RGB96F ? GL_FLOAT : GL_UNSIGNED_BYTE;
 
     const auto  DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    glBindTexture(GL_TEXTURE_2D, tex->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    bindTexture(GL_TEXTURE_2D, tex->m_iTexID);
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 #ifndef GLES2
     if (CAIROFORMAT != CAIRO_FORMAT_RGB96F) {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+        tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
     }
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, glIFormat, tex->m_vSize.x, tex->m_vSize.y, 0, glFormat, glType, DATA);
@@ -2714,86 +3003,45 @@ SP<CTexture> CHyprOpenGLImpl::loadAsset(const std::string& filename) {
     return tex;
 }
 
-SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
-    SP<CTexture>          tex = makeShared<CTexture>();
-
-    static auto           FONT = CConfigValue<std::string>("misc:font_family");
-
-    const auto            FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
-    const auto            FONTSIZE   = pt;
-    const auto            COLOR      = col;
-
-    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1920, 1080 /* arbitrary, just for size */);
-    auto                  CAIRO        = cairo_create(CAIROSURFACE);
-
-    PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
-    PangoFontDescription* pangoFD    = pango_font_description_new();
+SP<CTexture> CHyprOpenGLImpl::textureFromCairo(cairo_surface_t* surface) {
+    SP<CTexture> tex = makeShared<CTexture>();
 
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, static_cast<PangoWeight>(weight));
-    pango_layout_set_font_description(layoutText, pangoFD);
+    tex->allocate();
+    tex->m_vSize = {cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface)};
 
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+    const auto DATA = cairo_image_surface_get_data(surface);
+    bindTexture(GL_TEXTURE_2D, tex->m_iTexID);
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+#ifndef GLES2
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+#endif
+    // ARGB32 rows are exactly 4 * width bytes
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->m_vSize.x, tex->m_vSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
 
-    int textW = 0, textH = 0;
-    pango_layout_set_text(layoutText, text.c_str(), -1);
+    return tex;
+}
 
-    if (maxWidth > 0) {
-        pango_layout_set_width(layoutText, maxWidth * PANGO_SCALE);
-        pango_layout_set_ellipsize(layoutText, PANGO_ELLIPSIZE_END);
-    }
+SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
+    static auto FONT = CConfigValue<std::string>("misc:font_family");
 
-    pango_layout_get_size(layoutText, &textW, &textH);
-    textW /= PANGO_SCALE;
-    textH /= PANGO_SCALE;
+    const auto  CAIROSURFACE = paintText(text, col, pt, italic, fontFamily.empty() ? *FONT : fontFamily, maxWidth, weight);
+    auto        tex          = textureFromCairo(CAIROSURFACE);
 
-    pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-    cairo_destroy(CAIRO);
     cairo_surface_destroy(CAIROSURFACE);
 
-    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
-    CAIRO        = cairo_create(CAIROSURFACE);
-
-    layoutText = pango_cairo_create_layout(CAIRO);
-    pangoFD    = pango_font_description_new();
-
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, static_cast<PangoWeight>(weight));
-    pango_layout_set_font_description(layoutText, pangoFD);
-    pango_layout_set_text(layoutText, text.c_str(), -1);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
-    cairo_move_to(CAIRO, 0, 0);
-    pango_cairo_show_layout(CAIRO, layoutText);
-
-    pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-
-    cairo_surface_flush(CAIROSURFACE);
-
-    tex->allocate();
-    tex->m_vSize = {cairo_image_surface_get_width(CAIROSURFACE), cairo_image_surface_get_height(CAIROSURFACE)};
+    return tex;
+}
 
-    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    glBindTexture(GL_TEXTURE_2D, tex->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->m_vSize.x, tex->m_vSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+uint64_t CHyprOpenGLImpl::renderTextAsync(const std::string& text, CHyprColor col, int pt, std::function<void(SP<CTexture>)> done, bool italic, const std::string& fontFamily,
+                                          int maxWidth, int weight) {
+    static auto FONT = CConfigValue<std::string>("misc:font_family");
 
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
+    const auto  FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
 
-    return tex;
+    return m_pRasterPool->submit([=] { return paintText(text, col, pt, italic, FONTFAMILY, maxWidth, weight); },
+                                 [this, done](cairo_surface_t* surface) { done(textureFromCairo(surface)); });
 }
 
 void CHyprOpenGLImpl::initMissingAssetTexture() {
@@ -2824,12 +3072,12 @@ void CHyprOpenGLImpl::initMissingAssetTexture() {
     const GLint glType   = GL_UNSIGNED_BYTE;
 
     const auto  DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    glBindTexture(GL_TEXTURE_2D, tex->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    bindTexture(GL_TEXTURE_2D, tex->m_iTexID);
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 #ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, glFormat, tex->m_vSize.x, tex->m_vSize.y, 0, glFormat, glType, DATA);
 
@@ -2845,10 +3093,11 @@ void CHyprOpenGLImpl::initAssets() {
     m_pLockDeadTexture  = loadAsset("lockdead.png");
     m_pLockDead2Texture = loadAsset("lockdead2.png");
 
-    m_pLockTtyTextTexture = renderText(
-        std::format("Running on tty {}",
-                    g_pCompositor->m_aqBackend->hasSession() && g_pCompositor->m_aqBackend->session->vt > 0 ? std::to_string(g_pCompositor->m_aqBackend->session->vt) : "unknown"),
-        CHyprColor{0.9F, 0.9F, 0.9F, 0.7F}, 20, true);
+    // only shown once the session lock dies, nothing waits on it
+    renderTextAsync(std::format("Running on tty {}",
+                                g_pCompositor->m_aqBackend->hasSession() && g_pCompositor->m_aqBackend->session->vt > 0 ? std::to_string(g_pCompositor->m_aqBackend->session->vt) :
+                                                                                                                          "unknown"),
+                    CHyprColor{0.9F, 0.9F, 0.9F, 0.7F}, 20, [this](SP<CTexture> tex) { m_pLockTtyTextTexture = tex; }, true);
 
     m_pScreencopyDeniedTexture = renderText("Permission denied to share screen", Colors::WHITE, 20);
 
@@ -2882,6 +3131,47 @@ void CHyprOpenGLImpl::ensureBackgroundTexturePresence() {
     }
 }
 
+SP<CTexture> CHyprOpenGLImpl::requestSplash(PHLMONITOR pMonitor) {
+    static auto PSPLASHCOLOR = CConfigValue<Hyprlang::INT>("misc:col.splash");
+    static auto PSPLASHFONT  = CConfigValue<std::string>("misc:splash_font_family");
+    static auto FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
+
+    std::erase_if(m_mMonitorSplashes, [](const auto& e) { return !e.first; });
+
+    auto&      splash = m_mMonitorSplashes[pMonitor];
+    splash.recomposite = false;
+
+    const auto FONTFAMILY = *PSPLASHFONT != STRVAL_EMPTY ? *PSPLASHFONT : *FALLBACKFONT;
+    const auto COLOR      = CHyprColor(*PSPLASHCOLOR);
+    const auto SIZE       = pMonitor->vecPixelSize;
+    const auto KEY        = std::format("{}x{} {} {:x}", SIZE.x, SIZE.y, FONTFAMILY, *PSPLASHCOLOR);
+
+    if (splash.key == KEY || splash.jobKey == KEY)
+        return splash.tex;
+
+    if (splash.job)
+        m_pRasterPool->cancel(splash.job);
+
+    splash.jobKey = KEY;
+    splash.job    = m_pRasterPool->submit(
+        [TEXT = g_pCompositor->m_currentSplash, FONTFAMILY, COLOR, SIZE] { return paintSplashSurface(TEXT, FONTFAMILY, COLOR, SIZE); },
+        [this, MONITOR = PHLMONITORREF{pMonitor}, KEY](cairo_surface_t* surface) {
+            const auto IT = m_mMonitorSplashes.find(MONITOR);
+            if (!MONITOR || IT == m_mMonitorSplashes.end())
+                return;
+
+            IT->second.tex         = textureFromCairo(surface);
+            IT->second.key         = KEY;
+            IT->second.job         = 0;
+            IT->second.recomposite = true;
+            IT->second.jobKey.clear();
+
+            g_pHyprRenderer->damageMonitor(MONITOR.lock());
+        });
+
+    return splash.tex;
+}
+
 void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
     RASSERT(m_RenderData.pMonitor, "Tried to createBGTex without begin()!");
 
@@ -2890,6 +3180,18 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
     static auto PRENDERTEX = CConfigValue<Hyprlang::INT>("misc:disable_hyprland_logo");
     static auto PNOSPLASH  = CConfigValue<Hyprlang::INT>("misc:disable_splash_rendering");
 
+    // whatever gets drawn below, a finished splash has been answered. Left set, clearWithTex would call us every frame.
+    if (const auto IT = m_mMonitorSplashes.find(pMonitor); IT != m_mMonitorSplashes.end()) {
+        IT->second.recomposite = false;
+
+        // turned off while one was being painted
+        if (*PNOSPLASH) {
+            if (IT->second.job)
+                m_pRasterPool->cancel(IT->second.job);
+            m_mMonitorSplashes.erase(IT);
+        }
+    }
+
     if (*PRENDERTEX)
         return;
 
@@ -2902,44 +3204,10 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
     if (!m_pBackgroundTexture) // ?!?!?!
         return;
 
-    // create a new one with cairo
-    SP<CTexture> tex = makeShared<CTexture>();
-
-    tex->allocate();
-
-    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
-    const auto CAIRO        = cairo_create(CAIROSURFACE);
-
-    cairo_set_antialias(CAIRO, CAIRO_ANTIALIAS_GOOD);
-    cairo_save(CAIRO);
-    cairo_set_source_rgba(CAIRO, 0, 0, 0, 0);
-    cairo_set_operator(CAIRO, CAIRO_OPERATOR_SOURCE);
-    cairo_paint(CAIRO);
-    cairo_restore(CAIRO);
-
+    // painted off-thread. Until the one for this size is in, whatever was painted last is used, stretched.
+    SP<CTexture> splash;
     if (!*PNOSPLASH)
-        renderSplash(CAIRO, CAIROSURFACE, 0.02 * pMonitor->vecPixelSize.y, pMonitor->vecPixelSize);
-
-    cairo_surface_flush(CAIROSURFACE);
-
-    tex->m_vSize = pMonitor->vecPixelSize;
-
-    // copy the data to an OpenGL texture we have
-    const GLint glFormat = GL_RGBA;
-    const GLint glType   = GL_UNSIGNED_BYTE;
-
-    const auto  DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    glBindTexture(GL_TEXTURE_2D, tex->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-#ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-#endif
-    glTexImage2D(GL_TEXTURE_2D, 0, glFormat, tex->m_vSize.x, tex->m_vSize.y, 0, glFormat, glType, DATA);
-
-    cairo_surface_destroy(CAIROSURFACE);
-    cairo_destroy(CAIRO);
+        splash = requestSplash(pMonitor);
 
     // render the texture to our fb
     PFB->bind();
@@ -2967,8 +3235,10 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
         renderTextureInternalWithDamage(m_pBackgroundTexture, texbox, 1.0, fakeDamage);
     }
 
-    CBox monbox = {{}, pMonitor->vecPixelSize};
-    renderTextureInternalWithDamage(tex, monbox, 1.0, fakeDamage);
+    if (splash) {
+        CBox monbox = {{}, pMonitor->vecPixelSize};
+        renderTextureInternalWithDamage(splash, monbox, 1.0, fakeDamage);
+    }
 
     // bind back
     if (m_RenderData.currentFB)
@@ -2980,9 +3250,10 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
 void CHyprOpenGLImpl::clearWithTex() {
     RASSERT(m_RenderData.pMonitor, "Tried to render BGtex without begin()!");
 
-    auto TEXIT = m_mMonitorBGFBs.find(m_RenderData.pMonitor);
+    auto       TEXIT    = m_mMonitorBGFBs.find(m_RenderData.pMonitor);
+    const auto SPLASHIT = m_mMonitorSplashes.find(m_RenderData.pMonitor);
 
-    if (TEXIT == m_mMonitorBGFBs.end()) {
+    if (TEXIT == m_mMonitorBGFBs.end() || (SPLASHIT != m_mMonitorSplashes.end() && SPLASHIT->second.recomposite)) {
         createBGTextureForMonitor(m_RenderData.pMonitor.lock());
         TEXIT = m_mMonitorBGFBs.find(m_RenderData.pMonitor);
     }
@@ -7,11 +7,14 @@
 #include "../helpers/math/Math.hpp"
 #include "../helpers/Format.hpp"
 #include "../helpers/sync/SyncTimeline.hpp"
+#include <array>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <string>
 #include <unordered_map>
 #include <map>
+#include <optional>
 
 #include <cairo/cairo.h>
 
@@ -32,6 +35,10 @@
 
 struct gbm_device;
 class CHyprRenderer;
+class CRasterPool;
+class CReadbackPool;
+class CTextEngine;
+struct SShapedText;
 
 inline const float fullVerts[] = {
     1, 0, // top right
@@ -97,6 +104,7 @@ struct SPreparedShaders {
     CShader     m_shBORDER1;
     CShader     m_shGLITCH;
     CShader     m_shCM;
+    CShader     m_shTEXT;
 };
 
 struct SMonitorRenderData {
@@ -165,6 +173,12 @@ class CEGLSync {
     friend class CHyprOpenGLImpl;
 };
 
+// GL calls that went through the state cache
+struct SGLCallStats {
+    uint64_t issued  = 0;
+    uint64_t skipped = 0;
+};
+
 class CGradientValueData;
 
 class CHyprOpenGLImpl {
@@ -189,6 +203,8 @@ class CHyprOpenGLImpl {
     void renderBorder(const CBox&, const CGradientValueData&, const CGradientValueData&, float lerp, int round, float roundingPower, int borderSize, float a = 1.0,
                       int outerRound = -1 /* use round */);
     void renderTextureMatte(SP<CTexture> tex, const CBox& pBox, CFramebuffer& matte);
+    // text from m_pTextEngine, its top left at pos
+    void renderShapedText(SP<SShapedText> text, const Vector2D& pos, const CHyprColor& col, const CRegion& damage);
 
     void setMonitorTransformEnabled(bool enabled);
     void setRenderModifEnabled(bool enabled);
@@ -199,6 +215,14 @@ class CHyprOpenGLImpl {
 
     void blend(bool enabled);
 
+    // state cache: skips calls that wouldn't change anything. Whoever touches this state, or the
+    // uniforms of our shaders, with raw GL in between has to invalidateGLState()
+    void useProgram(GLuint program);
+    void activeTexture(GLenum unit);
+    void bindTexture(GLenum target, GLuint texture);
+    void invalidateGLState();
+    void onTextureDestroyed(GLuint texture);
+
     bool shouldUseNewBlurOptimizations(PHLLS pLayer, PHLWINDOW pWindow);
 
     void clear(const CHyprColor&);
@@ -226,6 +250,9 @@ class CHyprOpenGLImpl {
 
     SP<CTexture> loadAsset(const std::string& file);
     SP<CTexture> renderText(const std::string& text, CHyprColor col, int pt, bool italic = false, const std::string& fontFamily = "", int maxWidth = 0, int weight = 400);
+    // same, painted on m_pRasterPool. done gets the texture on the compositor thread, returns the job's id
+    uint64_t     renderTextAsync(const std::string& text, CHyprColor col, int pt, std::function<void(SP<CTexture>)> done, bool italic = false, const std::string& fontFamily = "",
+                                 int maxWidth = 0, int weight = 400);
 
     void         setDamage(const CRegion& damage, std::optional<CRegion> finalDamage = {});
 
@@ -251,6 +278,9 @@ class CHyprOpenGLImpl {
 
     bool                                        m_bReloadScreenShader = true; // at launch it can be set
 
+    SGLCallStats                                m_glCalls;          // this frame
+    SGLCallStats                                m_glCallsLastFrame; // last finished one
+
     std::map<PHLWINDOWREF, CFramebuffer>        m_mWindowFramebuffers;
     std::map<PHLLSREF, CFramebuffer>            m_mLayerFramebuffers;
     std::map<PHLMONITORREF, SMonitorRenderData> m_mMonitorRenderResources;
@@ -283,7 +313,11 @@ class CHyprOpenGLImpl {
         bool EXT_create_context_robustness      = false;
     } m_sExts;
 
-    SP<CTexture> m_pScreencopyDeniedTexture;
+    SP<CTexture>      m_pScreencopyDeniedTexture;
+
+    UP<CReadbackPool> m_pReadbackPool;
+    UP<CTextEngine>   m_pTextEngine;
+    UP<CRasterPool>   m_pRasterPool;
 
   private:
     enum eEGLContextVersion : uint8_t {
@@ -313,12 +347,44 @@ class CHyprOpenGLImpl {
     CShader                 m_sFinalScreenShader;
     CTimer                  m_tGlobalTimer;
 
+    // what we last set, nullopt / missing is unknown
+    struct {
+        std::optional<GLuint>                       program;
+        std::optional<GLenum>                       activeTexture;
+        std::map<std::pair<GLenum, GLenum>, GLuint> textures; // (unit, target) -> texture
+        std::optional<bool>                         blend;
+        std::optional<bool>                         scissorTest;
+        std::optional<std::array<GLint, 4>>         scissorBox;
+    } m_glState;
+
     SP<CTexture>            m_pMissingAssetTexture, m_pBackgroundTexture, m_pLockDeadTexture, m_pLockDead2Texture, m_pLockTtyTextTexture; // TODO: don't always load lock
 
+    struct SMonitorSplash {
+        SP<CTexture> tex;
+        std::string  key; // size, font and color tex was painted for
+        uint64_t     job = 0;
+        std::string  jobKey;
+        bool         recomposite = false; // tex changed since the bg framebuffer was made
+    };
+    // kept across monitor resource resets, so a mode change keeps its splash until the new one is in
+    std::map<PHLMONITORREF, SMonitorSplash> m_mMonitorSplashes;
+
+    struct SProgramSource {
+        GLuint*            program = nullptr;
+        const std::string* vert    = nullptr;
+        const std::string* frag    = nullptr;
+    };
+
     void                    logShaderError(const GLuint&, bool program = false, bool silent = false);
     GLuint                  createProgram(const std::string&, const std::string&, bool dynamic = false, bool silent = false);
-    GLuint                  compileShader(const GLuint&, std::string, bool dynamic = false, bool silent = false);
+    // creates all of them at once. Failed ones are left 0, with dynamic == false failing is fatal
+    bool                    createPrograms(const std::vector<SProgramSource>&, bool dynamic = false, bool silent = false);
+    GLuint                  compileShader(const GLuint&, const std::string&);
+    bool                    shaderStatusOK(const GLuint&, bool program, bool silent);
     void                    createBGTextureForMonitor(PHLMONITOR);
+    // the monitor's splash texture, painting one for its current size if it doesn't have it yet
+    SP<CTexture>            requestSplash(PHLMONITOR);
+    SP<CTexture>            textureFromCairo(cairo_surface_t*);
     void                    initDRMFormats();
     void                    initEGL(bool gbm);
     EGLDeviceEXT            eglDeviceFromDRMFD(int drmFD);
@@ -331,13 +397,13 @@ class CHyprOpenGLImpl {
     // returns the out FB, can be either Mirror or MirrorSwap
     CFramebuffer* blurMainFramebufferWithDamage(float a, CRegion* damage);
 
-    void          passCMUniforms(const CShader&, const NColorManagement::SImageDescription& imageDescription, const NColorManagement::SImageDescription& targetImageDescription,
+    void          passCMUniforms(CShader&, const NColorManagement::SImageDescription& imageDescription, const NColorManagement::SImageDescription& targetImageDescription,
                                  bool modifySDR = false);
-    void          passCMUniforms(const CShader&, const NColorManagement::SImageDescription& imageDescription);
+    void          passCMUniforms(CShader&, const NColorManagement::SImageDescription& imageDescription);
+    void          scissorTest(bool enabled);
     void renderTextureInternalWithDamage(SP<CTexture>, const CBox& box, float a, const CRegion& damage, int round = 0, float roundingPower = 2.0f, bool discardOpaque = false,
                                          bool noAA = false, bool allowCustomUV = false, bool allowDim = false);
     void renderTexturePrimitive(SP<CTexture> tex, const CBox& box);
-    void renderSplash(cairo_t* const, cairo_surface_t* const, double offset, const Vector2D& size);
 
     void preBlurForCurrentMonitor();
 
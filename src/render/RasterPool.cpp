@@ -0,0 +1,161 @@
+#include "RasterPool.hpp"
+#include "Renderer.hpp"
+#include "../Compositor.hpp"
+#include "../debug/Log.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace Hyprutils::OS;
+
+// painting is bursty (hotplugs, reloads), a couple of threads is plenty
+constexpr unsigned MAX_WORKERS = 2;
+
+static int onRasterPoolReadable(int fd, uint32_t mask, void* data) {
+    ((CRasterPool*)data)->onReadable();
+    return 0;
+}
+
+CRasterPool::CRasterPool() {
+    m_eventFD = CFileDescriptor{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+    if (!m_eventFD.isValid()) {
+        Debug::log(ERR, "CRasterPool: eventfd failed, painting on the compositor thread");
+        return;
+    }
+
+    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_eventFD.get(), WL_EVENT_READABLE, ::onRasterPoolReadable, this);
+
+    const auto WORKERS = std::clamp(std::thread::hardware_concurrency() / 2, 1U, MAX_WORKERS);
+    for (unsigned i = 0; i < WORKERS; ++i) {
+        m_workers.emplace_back([this] { workerMain(); });
+    }
+
+    Debug::log(LOG, "CRasterPool: started {} workers", WORKERS);
+}
+
+CRasterPool::~CRasterPool() {
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+
+    for (auto& w : m_workers) {
+        w.join();
+    }
+
+    for (auto const& r : m_results) {
+        if (r.surface)
+            cairo_surface_destroy(r.surface);
+    }
+
+    if (m_eventSource)
+        wl_event_source_remove(m_eventSource);
+}
+
+void CRasterPool::workerMain() {
+    while (true) {
+        SJob job;
+
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_cv.wait(lk, [this] { return m_stop || !m_queue.empty(); });
+
+            if (m_stop)
+                return;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        auto* const SURFACE = job.paint();
+
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_results.emplace_back(SResult{.id = job.id, .surface = SURFACE});
+        }
+
+        const uint64_t ONE = 1;
+        write(m_eventFD.get(), &ONE, sizeof(ONE));
+    }
+}
+
+uint64_t CRasterPool::submit(FPaint paint, FDone done) {
+    const auto ID = m_nextID++;
+
+    if (m_workers.empty()) {
+        // no workers, paint here but still deliver from the event loop
+        auto* const SURFACE = paint();
+        m_pending[ID]       = std::move(done);
+        g_pEventLoopManager->doLater([this, ID, SURFACE] {
+            {
+                std::lock_guard<std::mutex> lg(m_mutex);
+                m_results.emplace_back(SResult{.id = ID, .surface = SURFACE});
+            }
+            onReadable();
+        });
+        return ID;
+    }
+
+    m_pending[ID] = std::move(done);
+
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_queue.emplace_back(SJob{.id = ID, .paint = std::move(paint)});
+    }
+    m_cv.notify_one();
+
+    return ID;
+}
+
+void CRasterPool::cancel(uint64_t id) {
+    m_pending.erase(id);
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+    std::erase_if(m_queue, [id](const auto& j) { return j.id == id; });
+}
+
+void CRasterPool::onReadable() {
+    if (m_eventFD.isValid()) {
+        uint64_t count = 0;
+        read(m_eventFD.get(), &count, sizeof(count));
+    }
+
+    std::vector<SResult> results;
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        results.swap(m_results);
+    }
+
+    bool madeCurrent = false;
+
+    for (auto const& r : results) {
+        const auto IT = m_pending.find(r.id);
+        if (IT == m_pending.end()) { // cancelled
+            if (r.surface)
+                cairo_surface_destroy(r.surface);
+            continue;
+        }
+
+        const auto DONE = std::move(IT->second);
+        m_pending.erase(IT);
+
+        if (!r.surface || cairo_surface_status(r.surface) != CAIRO_STATUS_SUCCESS) {
+            Debug::log(ERR, "CRasterPool: job {} failed to paint", r.id);
+            if (r.surface)
+                cairo_surface_destroy(r.surface);
+            continue;
+        }
+
+        if (!madeCurrent) {
+            g_pHyprRenderer->makeEGLCurrent();
+            madeCurrent = true;
+        }
+
+        cairo_surface_flush(r.surface);
+        DONE(r.surface);
+        cairo_surface_destroy(r.surface);
+    }
+}
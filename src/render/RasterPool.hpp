@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <hyprutils/os/FileDescriptor.hpp>
+#include "../defines.hpp"
+
+#include <cairo/cairo.h>
+
+struct wl_event_source;
+
+/*
+    Cairo / Pango painting off the compositor thread.
+
+    A job's paint function runs on one of a few worker threads and returns an image surface. Finished
+    surfaces come back through an eventfd on the event loop, where the job's done callback gets them
+    with the EGL context current, for one upload. Paint functions must only use what they captured.
+*/
+class CRasterPool {
+  public:
+    CRasterPool();
+    ~CRasterPool();
+
+    // runs on a worker, returns an image surface or nullptr on failure
+    using FPaint = std::function<cairo_surface_t*()>;
+    // runs on the compositor thread, the surface is destroyed after it returns. Not called on failure.
+    using FDone = std::function<void(cairo_surface_t*)>;
+
+    // returns the job's id, never 0
+    uint64_t submit(FPaint paint, FDone done);
+
+    // done won't be called, the paint may still run if it already started
+    void     cancel(uint64_t id);
+
+    // called by the event loop once results are in
+    void     onReadable();
+
+  private:
+    struct SJob {
+        uint64_t id = 0;
+        FPaint   paint;
+    };
+
+    struct SResult {
+        uint64_t         id      = 0;
+        cairo_surface_t* surface = nullptr;
+    };
+
+    void                                workerMain();
+
+    std::vector<std::thread>            m_workers;
+    Hyprutils::OS::CFileDescriptor      m_eventFD;
+    wl_event_source*                    m_eventSource = nullptr;
+
+    // compositor thread only
+    std::unordered_map<uint64_t, FDone> m_pending;
+    uint64_t                            m_nextID = 1;
+
+    // shared with the workers
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cv;
+    std::deque<SJob>                    m_queue;
+    std::vector<SResult>                m_results;
+    bool                                m_stop = false;
+};
@@ -0,0 +1,182 @@
+#include "ReadbackPool.hpp"
+#include "OpenGL.hpp"
+#include "Renderer.hpp"
+#include "../helpers/Format.hpp"
+#include "../helpers/Monitor.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// pooled slots unused for this long are freed
+constexpr auto SLOT_TIMEOUT = std::chrono::seconds(5);
+// a 4K slot is ~64MB with its PBO, past this many, captures get one-off slots
+constexpr size_t MAX_POOLED_SLOTS = 8;
+
+CReadbackPool::SSlot::~SSlot() {
+#ifndef GLES2
+    if (pbo)
+        glDeleteBuffers(1, &pbo);
+#endif
+}
+
+bool CReadbackPool::pboSupported() {
+#ifdef GLES2
+    return false;
+#else
+    if (!m_pboSupported.has_value()) {
+        // the context can still be GLES 2.0 if 3.x creation failed
+        const auto VERSION = (const char*)glGetString(GL_VERSION);
+        m_pboSupported     = VERSION && !std::string{VERSION}.starts_with("OpenGL ES 2");
+    }
+
+    return *m_pboSupported;
+#endif
+}
+
+SP<CReadbackPool::SSlot> CReadbackPool::acquire(PHLMONITOR pMonitor, uint32_t drmFormat, const Vector2D& size) {
+    const auto NOW = Time::steadyNow();
+
+    std::erase_if(m_slots, [&NOW](const auto& s) { return !s->busy && (!s->monitor || NOW - s->lastUsed > SLOT_TIMEOUT); });
+
+    auto it = std::ranges::find_if(m_slots, [&](const auto& s) { return !s->busy && s->monitor == pMonitor && s->drmFormat == drmFormat && s->size == size; });
+
+    SP<SSlot> slot;
+
+    if (it != m_slots.end())
+        slot = *it;
+    else {
+        slot            = makeShared<SSlot>();
+        slot->monitor   = pMonitor;
+        slot->drmFormat = drmFormat;
+        slot->size      = size;
+        slot->pooled    = m_slots.size() < MAX_POOLED_SLOTS;
+
+        if (!slot->fb.alloc(size.x, size.y, drmFormat)) {
+            Debug::log(ERR, "CReadbackPool: failed to allocate a {}x{} framebuffer", size.x, size.y);
+            return nullptr;
+        }
+
+        if (slot->pooled)
+            m_slots.emplace_back(slot);
+    }
+
+    slot->busy     = true;
+    slot->lastUsed = NOW;
+
+    return slot;
+}
+
+void CReadbackPool::release(SP<SSlot> slot) {
+    slot->busy     = false;
+    slot->lastUsed = Time::steadyNow();
+}
+
+void CReadbackPool::readAsync(SP<SSlot> slot, const CBox& box, const SPixelFormat* format, FReadbackDone done, std::optional<CRegion> region) {
+    const uint32_t STRIDE   = NFormatUtils::minStride(format, box.w);
+    const size_t   SIZE     = (size_t)STRIDE * box.h;
+    const auto     GLFORMAT = format->flipRB ? GL_BGRA_EXT : GL_RGBA;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+#ifndef GLES2
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, slot->fb.getFBID());
+#else
+    glBindFramebuffer(GL_FRAMEBUFFER, slot->fb.getFBID());
+#endif
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    // reads the box, or the region's rects into their spot, to base (a pointer or an offset into the bound PBO)
+    const auto readPixels = [&](uint8_t* base) {
+        if (!region.has_value()) {
+            glReadPixels(box.x, box.y, box.w, box.h, GLFORMAT, format->glType, base);
+            return;
+        }
+
+#ifndef GLES2
+        glPixelStorei(GL_PACK_ROW_LENGTH, box.w);
+
+        for (auto const& r : region->copy().intersect(CBox{0, 0, box.w, box.h}).getRects()) {
+            glReadPixels(box.x + r.x1, box.y + r.y1, r.x2 - r.x1, r.y2 - r.y1, GLFORMAT, format->glType, base + (size_t)r.y1 * STRIDE + (size_t)r.x1 * format->bytesPerBlock);
+        }
+
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+#endif
+    };
+
+    if (!pboSupported()) {
+        // no GL_PACK_ROW_LENGTH either, read everything
+        region.reset();
+
+        std::vector<uint8_t> pixels(SIZE);
+        readPixels(pixels.data());
+
+#ifndef GLES2
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+#else
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+#endif
+
+        done(pixels.data(), STRIDE);
+        release(slot);
+        return;
+    }
+
+#ifndef GLES2
+    if (!slot->pbo)
+        glGenBuffers(1, &slot->pbo);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    if (slot->pboSize < SIZE) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, SIZE, nullptr, GL_STREAM_READ);
+        slot->pboSize = SIZE;
+    }
+
+    // with a pack buffer bound, this only queues the copy
+    readPixels(nullptr);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    auto sync = g_pHyprOpenGL->createEGLSync();
+
+    if (!sync || !sync->fd().isValid()) {
+        // no fence, mapping will wait for the GPU
+        finishRead(slot, SIZE, STRIDE, done);
+        return;
+    }
+
+    g_pEventLoopManager->doOnReadable(sync->fd().duplicate(), [this, slot, SIZE, STRIDE, done, sync]() { finishRead(slot, SIZE, STRIDE, done); });
+#endif
+}
+
+void CReadbackPool::finishRead(SP<SSlot> slot, size_t size, uint32_t stride, const FReadbackDone& done) {
+#ifndef GLES2
+    g_pHyprRenderer->makeEGLCurrent();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    const auto PIXELS = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (!PIXELS)
+        Debug::log(ERR, "CReadbackPool: failed to map a pixel pack buffer");
+
+    done(PIXELS, stride);
+
+    if (PIXELS)
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+
+    release(slot);
+}
+
+void CReadbackPool::copyRegion(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, const CRegion& region, uint32_t bpp) {
+    for (auto const& r : region.getRects()) {
+        for (int y = r.y1; y < r.y2; ++y) {
+            memcpy(dst + (size_t)y * dstStride + (size_t)r.x1 * bpp, src + (size_t)y * srcStride + (size_t)r.x1 * bpp, (size_t)(r.x2 - r.x1) * bpp);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <vector>
+#include "../defines.hpp"
+#include "../helpers/time/Time.hpp"
+#include "Framebuffer.hpp"
+
+class CMonitor;
+struct SPixelFormat;
+
+/*
+    Framebuffers + pixel pack buffers for shm captures, pooled per (monitor, format, size).
+
+    A capture renders into an acquired slot's framebuffer and hands it to readAsync(), which queues
+    the glReadPixels into the slot's PBO, fences it, and maps the PBO once the fence signals,
+    without stalling the render thread on the GPU. On GLES2 the readback is synchronous.
+*/
+class CReadbackPool {
+  public:
+    struct SSlot {
+        WP<CMonitor>    monitor;
+        uint32_t        drmFormat = 0;
+        Vector2D        size;
+
+        CFramebuffer    fb;
+        GLuint          pbo     = 0;
+        size_t          pboSize = 0;
+
+        bool            busy   = false;
+        bool            pooled = true;
+        Time::steady_tp lastUsed;
+
+        ~SSlot();
+    };
+
+    // pixels is nullptr if the readback failed, rows are stride bytes apart
+    using FReadbackDone = std::function<void(const uint8_t* pixels, uint32_t stride)>;
+
+    // a framebuffer to render the capture into, nullptr if it can't be allocated
+    SP<SSlot>   acquire(PHLMONITOR pMonitor, uint32_t drmFormat, const Vector2D& size);
+
+    // reads box of the slot's framebuffer. done runs once the copy landed, with the EGL context current.
+    // The slot goes back to the pool afterwards. With a region (relative to box), only those rects are
+    // read, at their place in the box's layout.
+    void        readAsync(SP<SSlot> slot, const CBox& box, const SPixelFormat* format, FReadbackDone done, std::optional<CRegion> region = {});
+
+    // gives the slot back without reading it
+    void        release(SP<SSlot> slot);
+
+    // copies the rects of region between two images of the same layout, bpp bytes per pixel
+    static void copyRegion(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, const CRegion& region, uint32_t bpp);
+
+  private:
+    void                   finishRead(SP<SSlot> slot, size_t size, uint32_t stride, const FReadbackDone& done);
+    bool                   pboSupported();
+
+    std::vector<SP<SSlot>> m_slots;
+    std::optional<bool>    m_pboSupported;
+};
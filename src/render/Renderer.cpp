@@ -1,5 +1,6 @@
 #include "Renderer.hpp"
 #include "../Compositor.hpp"
+#include "../desktop/WindowHitIndex.hpp"
 #include "../helpers/math/Math.hpp"
 #include "../helpers/sync/SyncReleaser.hpp"
 #include <algorithm>
@@ -23,6 +24,7 @@
 #include "../protocols/core/Compositor.hpp"
 #include "../protocols/DRMSyncobj.hpp"
 #include "../protocols/LinuxDMABUF.hpp"
+#include "../protocols/Screencopy.hpp"
 #include "../helpers/sync/SyncTimeline.hpp"
 #include "../hyprerror/HyprError.hpp"
 #include "../debug/HyprDebugOverlay.hpp"
@@ -1384,6 +1386,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor) {
     }
 
     EMIT_HOOK_EVENT("render", RENDER_LAST_MOMENT);
+    g_pHyprOpenGL->invalidateGLState(); // listeners may draw with raw GL
 
     endRender();
 
@@ -1883,6 +1886,8 @@ void CHyprRenderer::damageWindow(PHLWINDOW pWindow, bool forceFull) {
     if (g_pCompositor->m_unsafeState)
         return;
 
+    g_pCompositor->m_windowHitIndex->invalidate(pWindow);
+
     CBox       windowBox        = pWindow->getFullWindowBoundingBox();
     const auto PWINDOWWORKSPACE = pWindow->m_workspace;
     if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_renderOffset->isBeingAnimated() && !pWindow->m_pinned)
@@ -2260,6 +2265,11 @@ bool CHyprRenderer::beginRender(PHLMONITOR pMonitor, CRegion& damage, eRenderMod
 
     if (mode == RENDER_MODE_NORMAL) {
         damage = pMonitor->damage.getBufferDamage(HL_BUFFER_AGE);
+
+        // screencopy clients track what changed between their copies
+        if (PROTO::screencopy)
+            PROTO::screencopy->onMonitorDamage(pMonitor, pMonitor->damage.getBufferDamage(1));
+
         pMonitor->damage.rotate();
     }
 
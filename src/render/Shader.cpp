@@ -1,10 +1,15 @@
 #include "Shader.hpp"
+#include "OpenGL.hpp"
+#include <array>
+#include <cstring>
 
 CShader::~CShader() {
     destroy();
 }
 
 void CShader::destroy() {
+    m_muUniformValues.clear();
+
     if (program == 0)
         return;
 
@@ -12,3 +17,75 @@ void CShader::destroy() {
 
     program = 0;
 }
+
+void CShader::invalidateUniformCache() {
+    // keeps the buffers, an empty one never matches
+    for (auto& [_, value] : m_muUniformValues) {
+        value.clear();
+    }
+}
+
+bool CShader::uniformChanged(GLint location, const void* data, size_t size, uint8_t tag) {
+    // -1 is a uniform the program doesn't have, GL ignores those
+    if (location == -1) {
+        g_pHyprOpenGL->m_glCalls.skipped++;
+        return false;
+    }
+
+    auto& cached = m_muUniformValues[location];
+
+    if (cached.size() == size + 1 && cached[0] == tag && std::memcmp(cached.data() + 1, data, size) == 0) {
+        g_pHyprOpenGL->m_glCalls.skipped++;
+        return false;
+    }
+
+    cached.resize(size + 1);
+    cached[0] = tag;
+    std::memcpy(cached.data() + 1, data, size);
+
+    g_pHyprOpenGL->m_glCalls.issued++;
+    return true;
+}
+
+void CShader::setUniform1i(GLint location, GLint v0) {
+    if (uniformChanged(location, &v0, sizeof(v0)))
+        glUniform1i(location, v0);
+}
+
+void CShader::setUniform1f(GLint location, GLfloat v0) {
+    if (uniformChanged(location, &v0, sizeof(v0)))
+        glUniform1f(location, v0);
+}
+
+void CShader::setUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    const std::array<GLfloat, 2> VALUE = {v0, v1};
+    if (uniformChanged(location, VALUE.data(), sizeof(VALUE)))
+        glUniform2f(location, v0, v1);
+}
+
+void CShader::setUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    const std::array<GLfloat, 3> VALUE = {v0, v1, v2};
+    if (uniformChanged(location, VALUE.data(), sizeof(VALUE)))
+        glUniform3f(location, v0, v1, v2);
+}
+
+void CShader::setUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    const std::array<GLfloat, 4> VALUE = {v0, v1, v2, v3};
+    if (uniformChanged(location, VALUE.data(), sizeof(VALUE)))
+        glUniform4f(location, v0, v1, v2, v3);
+}
+
+void CShader::setUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    if (uniformChanged(location, value, sizeof(GLfloat) * 4 * count))
+        glUniform4fv(location, count, value);
+}
+
+void CShader::setUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    if (uniformChanged(location, value, sizeof(GLfloat) * 9 * count, transpose))
+        glUniformMatrix3fv(location, count, transpose, value);
+}
+
+void CShader::setUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    if (uniformChanged(location, value, sizeof(GLfloat) * 8 * count, transpose))
+        glUniformMatrix4x2fv(location, count, transpose, value);
+}
@@ -2,6 +2,7 @@
 
 #include "../defines.hpp"
 #include <unordered_map>
+#include <vector>
 
 class CShader {
   public:
@@ -75,8 +76,27 @@ class CShader {
     GLint brightness = -1;
     GLint noise      = -1;
 
+    // Text
+    GLint glyphBoxAttrib = -1;
+    GLint glyphUVAttrib  = -1;
+
     void  destroy();
 
+    // glUniform* that skip the call if the program already has the value. Raw glUniform* on the same shader needs an invalidateGLState() after
+    void setUniform1i(GLint location, GLint v0);
+    void setUniform1f(GLint location, GLfloat v0);
+    void setUniform2f(GLint location, GLfloat v0, GLfloat v1);
+    void setUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+    void setUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+    void setUniform4fv(GLint location, GLsizei count, const GLfloat* value);
+    void setUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+    void setUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+    // forget the cached values, the next set of each uniform is sent
+    void invalidateUniformCache();
+
   private:
-    std::unordered_map<std::string, GLint> m_muUniforms;
+    bool                                            uniformChanged(GLint location, const void* data, size_t size, uint8_t tag = 0);
+
+    std::unordered_map<std::string, GLint>          m_muUniforms;
+    std::unordered_map<GLint, std::vector<uint8_t>> m_muUniformValues;
 };
@@ -0,0 +1,206 @@
+#include "ShaderCache.hpp"
+#include "../helpers/fs/FsUtils.hpp"
+#include "../debug/Log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+
+#ifndef GLES2
+
+constexpr char   CACHE_MAGIC[8] = {'H', 'L', 'S', 'H', 'B', 'I', 'N', '1'};
+constexpr size_t MAX_ENTRIES    = 128;
+
+struct SEntryHeader {
+    char     magic[8];
+    uint64_t driverHash = 0;
+    // of the sources, to tell collisions of the file name apart
+    uint64_t checkHash = 0;
+    uint32_t format    = 0;
+    uint32_t length    = 0;
+};
+
+static struct {
+    bool                  enabled    = false;
+    uint64_t              driverHash = 0;
+    std::filesystem::path dir;
+} state;
+
+static uint64_t fnv1a(const std::string& str, uint64_t hash) {
+    for (const unsigned char c : str) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t hashSources(const std::string& vert, const std::string& frag, uint64_t seed) {
+    // the separator keeps "ab" + "c" and "a" + "bc" apart
+    return fnv1a(frag, fnv1a(std::string{'\0'}, fnv1a(vert, fnv1a(std::to_string(state.driverHash), seed))));
+}
+
+static std::filesystem::path entryPath(const std::string& vert, const std::string& frag) {
+    return state.dir / std::format("{:016x}.bin", hashSources(vert, frag, 0xcbf29ce484222325ULL));
+}
+
+static void prune() {
+    std::error_code                                                                ec;
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+
+    for (auto const& e : std::filesystem::directory_iterator(state.dir, ec)) {
+        if (e.path().extension() == ".bin")
+            entries.emplace_back(e.last_write_time(ec), e.path());
+    }
+
+    if (entries.size() <= MAX_ENTRIES)
+        return;
+
+    // entries are touched on every hit, drop the ones unused for longest
+    std::ranges::sort(entries, [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < entries.size() - MAX_ENTRIES; ++i) {
+        std::filesystem::remove(entries[i].second, ec);
+    }
+}
+
+void NShaderCache::init() {
+    state.enabled = false;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        Debug::log(LOG, "ShaderCache: driver has no program binary formats, not caching shaders");
+        return;
+    }
+
+    const auto CACHEHOME = NFsUtils::getCacheHome();
+    if (!CACHEHOME) {
+        Debug::log(WARN, "ShaderCache: no cache home, not caching shaders");
+        return;
+    }
+
+    state.dir = std::filesystem::path{*CACHEHOME} / "shaders";
+
+    std::error_code ec;
+    std::filesystem::create_directories(state.dir, ec);
+    if (ec) {
+        Debug::log(WARN, "ShaderCache: couldn't create {}: {}", state.dir.string(), ec.message());
+        return;
+    }
+
+    const auto GLSTRING = [](GLenum name) {
+        const auto STR = (const char*)glGetString(name);
+        return std::string{STR ? STR : ""};
+    };
+
+    state.driverHash = fnv1a(GLSTRING(GL_VENDOR) + '\n' + GLSTRING(GL_RENDERER) + '\n' + GLSTRING(GL_VERSION), 0xcbf29ce484222325ULL);
+    state.enabled    = true;
+
+    prune();
+
+    Debug::log(LOG, "ShaderCache: caching program binaries in {}", state.dir.string());
+}
+
+GLuint NShaderCache::load(const std::string& vert, const std::string& frag) {
+    if (!state.enabled)
+        return 0;
+
+    const auto    PATH = entryPath(vert, frag);
+    std::ifstream file(PATH, std::ios::binary);
+    if (!file.good())
+        return 0;
+
+    SEntryHeader header;
+    if (!file.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.driverHash != state.driverHash ||
+        header.checkHash != hashSources(vert, frag, 0x84222325cbf29ce4ULL) || header.length == 0) {
+        std::error_code ec;
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    std::vector<uint8_t> binary(header.length);
+    if (!file.read((char*)binary.data(), binary.size()))
+        return 0;
+
+    file.close();
+
+    const auto PROG = glCreateProgram();
+    glProgramBinary(PROG, header.format, binary.data(), binary.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(PROG, GL_LINK_STATUS, &ok);
+
+    std::error_code ec;
+    if (ok != GL_TRUE) {
+        // a driver update that kept its version string, most likely
+        Debug::log(LOG, "ShaderCache: driver rejected {}, dropping it", PATH.string());
+        glDeleteProgram(PROG);
+        std::filesystem::remove(PATH, ec);
+        return 0;
+    }
+
+    std::filesystem::last_write_time(PATH, std::filesystem::file_time_type::clock::now(), ec);
+
+    return PROG;
+}
+
+void NShaderCache::save(GLuint program, const std::string& vert, const std::string& frag) {
+    if (!state.enabled || !program)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<uint8_t> binary(length);
+    GLenum               format  = 0;
+    GLsizei              written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+
+    SEntryHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.driverHash = state.driverHash;
+    header.checkHash  = hashSources(vert, frag, 0x84222325cbf29ce4ULL);
+    header.format     = format;
+    header.length     = written;
+
+    const auto PATH = entryPath(vert, frag);
+    const auto TMP  = std::filesystem::path{PATH.string() + ".tmp"};
+
+    {
+        std::ofstream file(TMP, std::ios::binary | std::ios::trunc);
+        if (!file.good() || !file.write((const char*)&header, sizeof(header)) || !file.write((const char*)binary.data(), written)) {
+            Debug::log(WARN, "ShaderCache: couldn't write {}", TMP.string());
+            std::error_code ec;
+            std::filesystem::remove(TMP, ec);
+            return;
+        }
+    }
+
+    // so another instance never reads half an entry
+    std::error_code ec;
+    std::filesystem::rename(TMP, PATH, ec);
+    if (ec)
+        std::filesystem::remove(TMP, ec);
+}
+
+#else
+
+void NShaderCache::init() {
+    ;
+}
+
+GLuint NShaderCache::load(const std::string& vert, const std::string& frag) {
+    return 0;
+}
+
+void NShaderCache::save(GLuint program, const std::string& vert, const std::string& frag) {
+    ;
+}
+
+#endif
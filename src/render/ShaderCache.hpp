@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include "../defines.hpp"
+
+/*
+    Linked program binaries on disk, in $XDG_CACHE_HOME/hyprland/shaders/, so launches and shader
+    reloads skip compiling whatever was built before.
+
+    Entries are keyed by the driver (vendor, renderer and version strings) and the program's sources,
+    a driver update or a changed shader simply misses. Binaries the driver rejects are dropped.
+    Not available on GLES2.
+*/
+namespace NShaderCache {
+    // needs a current context
+    void   init();
+
+    // a linked program, or 0 on a miss
+    GLuint load(const std::string& vert, const std::string& frag);
+
+    // stores a linked program that was created with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    void   save(GLuint program, const std::string& vert, const std::string& frag);
+};
@@ -0,0 +1,277 @@
+#include "TextEngine.hpp"
+#include "OpenGL.hpp"
+#include "../config/ConfigValue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <pango/pangocairo.h>
+
+// runs are small, this is for the text that's on screen plus some churn
+constexpr size_t MAX_RUNS = 512;
+// styles come from config and monitor scales, past this many the least recently used one goes
+constexpr size_t MAX_STYLES     = 16;
+constexpr int    MAX_ATLAS_SIDE = 4096;
+// transparent border around every glyph, so quads never pick up their neighbours
+constexpr int GLYPH_PAD = 1;
+
+CTextEngine::SAtlas::~SAtlas() {
+    for (auto const& f : fonts) {
+        g_object_unref(f);
+    }
+}
+
+CTextEngine::CTextEngine() {
+    m_cairoSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    m_cairo        = cairo_create(m_cairoSurface);
+    m_layout       = pango_cairo_create_layout(m_cairo);
+}
+
+CTextEngine::~CTextEngine() {
+    m_runIndex.clear();
+    m_runs.clear();
+    m_styles.clear();
+
+    g_object_unref(m_layout);
+    cairo_destroy(m_cairo);
+    cairo_surface_destroy(m_cairoSurface);
+}
+
+const CTextEngine::SStats& CTextEngine::stats() {
+    return m_stats;
+}
+
+SP<CTextEngine::SAtlas> CTextEngine::createAtlas(int side) {
+    auto atlas  = makeShared<SAtlas>();
+    atlas->side = side;
+    atlas->tex  = makeShared<CTexture>();
+    atlas->tex->allocate();
+    atlas->tex->m_vSize = {side, side};
+
+    // cleared, glyphs only ever cover parts of it
+    const std::vector<uint8_t> ZEROES((size_t)side * side * 4, 0);
+
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, atlas->tex->m_iTexID);
+    atlas->tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    atlas->tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    atlas->tex->setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    atlas->tex->setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#ifndef GLES2
+    atlas->tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    atlas->tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, side, side, 0, GL_RGBA, GL_UNSIGNED_BYTE, ZEROES.data());
+
+    m_stats.atlases++;
+
+    return atlas;
+}
+
+CTextEngine::SStyleEntry& CTextEngine::styleEntry(const STextStyle& style) {
+    m_useCounter++;
+
+    for (auto& s : m_styles) {
+        if (s.style == style) {
+            s.lastUsed = m_useCounter;
+            return s;
+        }
+    }
+
+    if (m_styles.size() >= MAX_STYLES)
+        m_styles.erase(std::ranges::min_element(m_styles, {}, &SStyleEntry::lastUsed));
+
+    // room for ~16x16 glyphs, more if it fills up
+    const int SIDE = std::clamp((int)std::bit_ceil((unsigned)std::max(style.size, 1) * 16), 256, MAX_ATLAS_SIDE);
+
+    return m_styles.emplace_back(SStyleEntry{.style = style, .atlas = createAtlas(SIDE), .lastUsed = m_useCounter});
+}
+
+const CTextEngine::SGlyph* CTextEngine::glyph(SAtlas& atlas, PangoFont* font, uint32_t glyphID) {
+    const SGlyphKey KEY = {font, glyphID};
+
+    if (const auto IT = atlas.glyphs.find(KEY); IT != atlas.glyphs.end()) {
+        m_stats.glyphHits++;
+        return &IT->second;
+    }
+
+    m_stats.glyphMisses++;
+
+    PangoRectangle ink;
+    pango_font_get_glyph_extents(font, glyphID, &ink, nullptr);
+
+    if (std::ranges::find(atlas.fonts, font) == atlas.fonts.end())
+        atlas.fonts.emplace_back((PangoFont*)g_object_ref(font));
+
+    SGlyph result;
+
+    if (ink.width <= 0 || ink.height <= 0) // spaces and friends
+        return &atlas.glyphs.emplace(KEY, result).first->second;
+
+    const int X = PANGO_PIXELS_FLOOR(ink.x) - GLYPH_PAD;
+    const int Y = PANGO_PIXELS_FLOOR(ink.y) - GLYPH_PAD;
+    const int W = PANGO_PIXELS_CEIL(ink.x + ink.width) + GLYPH_PAD - X;
+    const int H = PANGO_PIXELS_CEIL(ink.y + ink.height) + GLYPH_PAD - Y;
+
+    if (W > atlas.side || H > atlas.side)
+        return nullptr;
+
+    if (atlas.shelfX + W > atlas.side) {
+        atlas.shelfX = 0;
+        atlas.shelfY += atlas.shelfH;
+        atlas.shelfH = 0;
+    }
+
+    if (atlas.shelfY + H > atlas.side)
+        return nullptr;
+
+    const int POSX = atlas.shelfX;
+    const int POSY = atlas.shelfY;
+    atlas.shelfX += W;
+    atlas.shelfH = std::max(atlas.shelfH, H);
+
+    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, W, H);
+    const auto CAIRO        = cairo_create(CAIROSURFACE);
+
+    PangoGlyphInfo   glyphInfo   = {};
+    PangoGlyphString glyphString = {};
+    int              cluster     = 0;
+    glyphInfo.glyph              = glyphID;
+    glyphString.num_glyphs       = 1;
+    glyphString.glyphs           = &glyphInfo;
+    glyphString.log_clusters     = &cluster;
+
+    // white, callers tint it
+    cairo_set_source_rgba(CAIRO, 1, 1, 1, 1);
+    cairo_move_to(CAIRO, -X, -Y);
+    pango_cairo_show_glyph_string(CAIRO, font, &glyphString);
+    cairo_surface_flush(CAIROSURFACE);
+
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, atlas.tex->m_iTexID);
+    // ARGB32 rows are exactly 4 * W bytes, no unpack row length needed
+    glTexSubImage2D(GL_TEXTURE_2D, 0, POSX, POSY, W, H, GL_RGBA, GL_UNSIGNED_BYTE, cairo_image_surface_get_data(CAIROSURFACE));
+
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+
+    result.bearing       = {X, Y};
+    result.size          = {W, H};
+    result.uvTopLeft     = Vector2D{POSX, POSY} / atlas.side;
+    result.uvBottomRight = Vector2D{POSX + W, POSY + H} / atlas.side;
+
+    return &atlas.glyphs.emplace(KEY, result).first->second;
+}
+
+SP<SShapedText> CTextEngine::shapeInto(const std::string& text, const STextStyle& style, int maxWidth, SAtlas& atlas) {
+    PangoFontDescription* pangoFD = pango_font_description_new();
+    pango_font_description_set_family(pangoFD, style.family.c_str());
+    pango_font_description_set_absolute_size(pangoFD, style.size * PANGO_SCALE);
+    pango_font_description_set_style(pangoFD, style.italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
+    pango_font_description_set_weight(pangoFD, static_cast<PangoWeight>(style.weight));
+    pango_layout_set_font_description(m_layout, pangoFD);
+    pango_font_description_free(pangoFD);
+
+    pango_layout_set_width(m_layout, maxWidth > 0 ? maxWidth * PANGO_SCALE : -1);
+    pango_layout_set_ellipsize(m_layout, maxWidth > 0 ? PANGO_ELLIPSIZE_END : PANGO_ELLIPSIZE_NONE);
+    pango_layout_set_text(m_layout, text.c_str(), -1);
+
+    auto run = makeShared<SShapedText>();
+
+    int  w = 0, h = 0;
+    pango_layout_get_pixel_size(m_layout, &w, &h);
+    run->size  = {w, h};
+    run->atlas = atlas.tex;
+
+    PangoLayoutIter* iter = pango_layout_get_iter(m_layout);
+
+    do {
+        PangoLayoutRun* layoutRun = pango_layout_iter_get_run_readonly(iter);
+        if (!layoutRun) // end of a line
+            continue;
+
+        PangoRectangle logical;
+        pango_layout_iter_get_run_extents(iter, nullptr, &logical);
+
+        const int BASELINE = pango_layout_iter_get_baseline(iter);
+        int       penX     = logical.x;
+
+        for (int i = 0; i < layoutRun->glyphs->num_glyphs; ++i) {
+            const auto& INFO = layoutRun->glyphs->glyphs[i];
+            const auto  PENX = penX + INFO.geometry.x_offset;
+            penX += INFO.geometry.width;
+
+            if (INFO.glyph == PANGO_GLYPH_EMPTY)
+                continue;
+
+            const auto* PGLYPH = glyph(atlas, layoutRun->item->analysis.font, INFO.glyph);
+            if (!PGLYPH) {
+                pango_layout_iter_free(iter);
+                return nullptr;
+            }
+
+            if (PGLYPH->size.x == 0)
+                continue;
+
+            const auto POS = Vector2D{PANGO_PIXELS(PENX), PANGO_PIXELS(BASELINE + INFO.geometry.y_offset)} + PGLYPH->bearing;
+
+            run->instances.insert(run->instances.end(),
+                                  {(float)POS.x, (float)POS.y, (float)PGLYPH->size.x, (float)PGLYPH->size.y, (float)PGLYPH->uvTopLeft.x, (float)PGLYPH->uvTopLeft.y,
+                                   (float)PGLYPH->uvBottomRight.x, (float)PGLYPH->uvBottomRight.y});
+            run->quads++;
+        }
+    } while (pango_layout_iter_next_run(iter));
+
+    pango_layout_iter_free(iter);
+
+    return run;
+}
+
+SP<SShapedText> CTextEngine::shape(const std::string& text, const STextStyle& style, int maxWidth) {
+    static auto FONT = CConfigValue<std::string>("misc:font_family");
+
+    STextStyle  resolved = style;
+    if (resolved.family.empty())
+        resolved.family = *FONT;
+
+    auto&      entry = styleEntry(resolved);
+
+    const auto KEY = std::format("{}\n{}\n{}\n{}\n{}\n{}", resolved.family, resolved.size, resolved.weight, resolved.italic, maxWidth, text);
+
+    if (const auto IT = m_runIndex.find(KEY); IT != m_runIndex.end()) {
+        if (IT->second->run->atlas == entry.atlas->tex) {
+            m_stats.runHits++;
+            m_runs.splice(m_runs.begin(), m_runs, IT->second);
+            return IT->second->run;
+        }
+
+        // its atlas was outgrown
+        m_runs.erase(IT->second);
+        m_runIndex.erase(IT);
+    }
+
+    m_stats.runMisses++;
+
+    auto run = shapeInto(text, resolved, maxWidth, *entry.atlas);
+
+    while (!run && entry.atlas->side < MAX_ATLAS_SIDE) {
+        Debug::log(LOG, "CTextEngine: atlas for {} {}px is full, growing it to {}px", resolved.family, resolved.size, entry.atlas->side * 2);
+        entry.atlas = createAtlas(entry.atlas->side * 2);
+        run         = shapeInto(text, resolved, maxWidth, *entry.atlas);
+    }
+
+    if (!run) {
+        Debug::log(ERR, "CTextEngine: text doesn't fit a {}px atlas, not drawing it", MAX_ATLAS_SIDE);
+        run        = makeShared<SShapedText>();
+        run->atlas = entry.atlas->tex;
+        return run;
+    }
+
+    m_runs.emplace_front(SRunEntry{.key = KEY, .run = run});
+    m_runIndex[KEY] = m_runs.begin();
+
+    while (m_runs.size() > MAX_RUNS) {
+        m_runIndex.erase(m_runs.back().key);
+        m_runs.pop_back();
+    }
+
+    return run;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../defines.hpp"
+#include "Texture.hpp"
+
+typedef struct _cairo         cairo_t;
+typedef struct _cairo_surface cairo_surface_t;
+typedef struct _PangoFont     PangoFont;
+typedef struct _PangoLayout   PangoLayout;
+
+/*
+    Text drawn from glyph atlases instead of a texture per string.
+
+    Each style (family, size, weight, style) gets an atlas texture that glyphs are rasterized into
+    the first time they're used. Strings are shaped once into runs of quads into that atlas, cached
+    by style, width and text, and drawn in one instanced call by CHyprOpenGLImpl::renderShapedText.
+
+    When an atlas fills up, the style moves to a new, bigger one. Runs still in flight keep the old
+    atlas alive, cached runs on it get shaped again on their next use.
+*/
+
+struct STextStyle {
+    std::string family;
+    int         size   = 12; // px
+    int         weight = 400;
+    bool        italic = false;
+
+    bool        operator==(const STextStyle&) const = default;
+};
+
+struct SShapedText {
+    Vector2D           size;
+    SP<CTexture>       atlas;
+    size_t             quads = 0;
+    // per quad: x, y, w, h in px from the top left of the text, then u0, v0, u1, v1 in the atlas
+    std::vector<float> instances;
+};
+
+class CTextEngine {
+  public:
+    CTextEngine();
+    ~CTextEngine();
+
+    struct SStats {
+        uint64_t runHits     = 0;
+        uint64_t runMisses   = 0;
+        uint64_t glyphHits   = 0;
+        uint64_t glyphMisses = 0;
+        uint64_t atlases     = 0; // ever created, a style outgrowing its atlas makes a new one
+    };
+
+    // family empty means misc:font_family. With maxWidth > 0, longer text is ellipsized
+    SP<SShapedText> shape(const std::string& text, const STextStyle& style, int maxWidth = 0);
+
+    const SStats&   stats();
+
+  private:
+    struct SGlyphKey {
+        PangoFont* font  = nullptr;
+        uint32_t   glyph = 0;
+
+        bool       operator==(const SGlyphKey&) const = default;
+    };
+
+    struct SGlyphKeyHash {
+        size_t operator()(const SGlyphKey& k) const {
+            return std::hash<void*>{}(k.font) ^ (std::hash<uint32_t>{}(k.glyph) << 1);
+        }
+    };
+
+    struct SGlyph {
+        Vector2D bearing; // top left of the quad from the pen position on the baseline
+        Vector2D size;    // 0 for glyphs with nothing to draw
+        Vector2D uvTopLeft, uvBottomRight;
+    };
+
+    struct SAtlas {
+        ~SAtlas();
+
+        SP<CTexture>                                         tex;
+        int                                                  side = 0;
+
+        // shelf packing: rows of glyphs, a new row once one doesn't fit the current
+        int                                                  shelfX = 0, shelfY = 0, shelfH = 0;
+
+        std::unordered_map<SGlyphKey, SGlyph, SGlyphKeyHash> glyphs;
+        std::vector<PangoFont*>                              fonts; // referenced, glyph keys point into them
+    };
+
+    struct SStyleEntry {
+        STextStyle style;
+        SP<SAtlas> atlas;
+        uint64_t   lastUsed = 0;
+    };
+
+    struct SRunEntry {
+        std::string     key;
+        SP<SShapedText> run;
+    };
+
+    SStyleEntry&                                                    styleEntry(const STextStyle& style);
+    SP<SAtlas>                                                      createAtlas(int side);
+    const SGlyph*                                                   glyph(SAtlas& atlas, PangoFont* font, uint32_t glyphID);
+    SP<SShapedText>                                                 shapeInto(const std::string& text, const STextStyle& style, int maxWidth, SAtlas& atlas);
+
+    std::vector<SStyleEntry>                                        m_styles;
+    std::list<SRunEntry>                                            m_runs; // most recently used first
+    std::unordered_map<std::string, std::list<SRunEntry>::iterator> m_runIndex;
+
+    cairo_surface_t*                                                m_cairoSurface = nullptr;
+    cairo_t*                                                        m_cairo        = nullptr;
+    PangoLayout*                                                    m_layout       = nullptr;
+
+    uint64_t                                                        m_useCounter = 0;
+    SStats                                                          m_stats;
+};
@@ -2,7 +2,11 @@
 #include "Renderer.hpp"
 #include "../Compositor.hpp"
 #include "../protocols/types/Buffer.hpp"
+#include "ReadbackPool.hpp"
 #include "../helpers/Format.hpp"
+#include "../helpers/math/RegionSimplify.hpp"
+#include "../config/ConfigValue.hpp"
+#include <algorithm>
 #include <cstring>
 
 CTexture::CTexture() = default;
@@ -69,19 +73,18 @@ void CTexture::createFromShm(uint32_t drmFormat, uint8_t* pixels, uint32_t strid
     m_isSynchronous = true;
     allocate();
 
-    GLCALL(glBindTexture(GL_TEXTURE_2D, m_iTexID));
-    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_iTexID);
+    setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 #ifndef GLES2
     if (format->flipRB) {
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE));
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED));
+        setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
     }
 #endif
     GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / format->bytesPerBlock));
     GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, format->glInternalFormat ? format->glInternalFormat : format->glFormat, size_.x, size_.y, 0, format->glFormat, format->glType, pixels));
     GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0));
-    GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
 
     if (m_bKeepDataCopy) {
         m_vDataCopy.resize(stride * size_.y);
@@ -103,34 +106,44 @@ void CTexture::createFromDma(const Aquamarine::SDMABUFAttrs& attrs, void* image)
     allocate();
     m_pEglImage = image;
 
-    GLCALL(glBindTexture(GL_TEXTURE_2D, m_iTexID));
-    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_iTexID);
+    setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     GLCALL(g_pHyprOpenGL->m_sProc.glEGLImageTargetTexture2DOES(m_iTarget, image));
-    GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
 }
 
 void CTexture::update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, const CRegion& damage) {
+    upload(drmFormat, pixels, stride, damage, {});
+
+    if (m_bKeepDataCopy) {
+        m_vDataCopy.resize(stride * m_vSize.y);
+        memcpy(m_vDataCopy.data(), pixels, stride * m_vSize.y);
+    }
+}
+
+void CTexture::upload(uint32_t drmFormat, const uint8_t* pixels, uint32_t stride, const CRegion& damage, const Vector2D& origin) {
+    static auto PRECTCOST = CConfigValue<Hyprlang::INT>("render:upload_rect_cost");
+
     g_pHyprRenderer->makeEGLCurrent();
 
     const auto format = NFormatUtils::getPixelFormatFromDRM(drmFormat);
     ASSERT(format);
 
-    glBindTexture(GL_TEXTURE_2D, m_iTexID);
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, m_iTexID);
 
-    auto rects = damage.copy().intersect(CBox{{}, m_vSize}).getRects();
+    auto rects = NRegionSimplify::simplify(damage.copy().intersect(CBox{{}, m_vSize}), std::max<Hyprlang::INT>(*PRECTCOST, 0)).getRects();
 
 #ifndef GLES2
     if (format->flipRB) {
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE));
-        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED));
+        setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
     }
 #endif
 
     for (auto const& rect : rects) {
         GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / format->bytesPerBlock));
-        GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, rect.x1));
-        GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, rect.y1));
+        GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, rect.x1 - (int)origin.x));
+        GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, rect.y1 - (int)origin.y));
 
         int width  = rect.x2 - rect.x1;
         int height = rect.y2 - rect.y1;
@@ -140,29 +153,101 @@ void CTexture::update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, cons
     GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0));
     GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, 0));
     GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, 0));
+}
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+// whole pixels per row, with rows 4-byte aligned like GL_UNPACK_ALIGNMENT wants them
+static uint32_t stagingStride(const CBox& box, uint32_t bpp) {
+    uint32_t width = box.w;
+    while ((width * bpp) % 4)
+        ++width;
 
-    if (m_bKeepDataCopy) {
-        m_vDataCopy.resize(stride * m_vSize.y);
-        memcpy(m_vDataCopy.data(), pixels, stride * m_vSize.y);
+    return width * bpp;
+}
+
+void CTexture::queueUpdate(uint32_t drmFormat, const uint8_t* pixels, uint32_t stride, const CRegion& damage) {
+    // a different layout can't be merged with what's queued
+    if (!m_pendingDamage.empty() && (drmFormat != m_iPendingFormat || stride != m_iPendingStride))
+        flushPendingUpload();
+
+    const auto format = NFormatUtils::getPixelFormatFromDRM(drmFormat);
+    ASSERT(format);
+
+    const auto DAMAGE = damage.copy().intersect(CBox{{}, m_vSize});
+    if (DAMAGE.empty())
+        return;
+
+    m_pendingDamage.add(DAMAGE);
+    m_iPendingFormat = drmFormat;
+    m_iPendingStride = stride;
+
+    // only the box around the pending damage is staged. The upload can merge rects across undamaged pixels
+    // inside it, so when the box changes it's staged whole from pixels, which hold the surface's current content
+    const auto BOX           = m_pendingDamage.getExtents();
+    const auto BPP           = format->bytesPerBlock;
+    const auto STAGINGSTRIDE = stagingStride(BOX, BPP);
+    CRegion    toCopy        = DAMAGE;
+
+    if (BOX != m_stagingBox) {
+        m_stagingBox = BOX;
+        m_vStaging.resize((size_t)STAGINGSTRIDE * BOX.h);
+        toCopy = CRegion{BOX};
     }
+
+    CReadbackPool::copyRegion(pixels + (size_t)BOX.y * stride + (size_t)BOX.x * BPP, stride, m_vStaging.data(), STAGINGSTRIDE, toCopy.translate(-BOX.pos()), BPP);
+}
+
+void CTexture::flushPendingUpload() {
+    if (m_pendingDamage.empty())
+        return;
+
+    const auto format = NFormatUtils::getPixelFormatFromDRM(m_iPendingFormat);
+    ASSERT(format);
+
+    upload(m_iPendingFormat, m_vStaging.data(), stagingStride(m_stagingBox, format->bytesPerBlock), m_pendingDamage, m_stagingBox.pos());
+    m_pendingDamage.clear();
+
+    // don't keep a copy of the surface around between commits
+    m_vStaging   = {};
+    m_stagingBox = {};
 }
 
 void CTexture::destroyTexture() {
     if (m_iTexID) {
         GLCALL(glDeleteTextures(1, &m_iTexID));
+        g_pHyprOpenGL->onTextureDestroyed(m_iTexID);
         m_iTexID = 0;
     }
 
+    m_vTexParams.clear();
+
     if (m_pEglImage)
         g_pHyprOpenGL->m_sProc.eglDestroyImageKHR(g_pHyprOpenGL->m_pEglDisplay, m_pEglImage);
     m_pEglImage = nullptr;
 }
 
 void CTexture::allocate() {
-    if (!m_iTexID)
-        GLCALL(glGenTextures(1, &m_iTexID));
+    if (m_iTexID)
+        return;
+
+    GLCALL(glGenTextures(1, &m_iTexID));
+    m_vTexParams.clear();
+}
+
+void CTexture::setTexParameter(GLenum pname, GLint param) {
+    auto it = std::ranges::find(m_vTexParams, pname, &std::pair<GLenum, GLint>::first);
+
+    if (it != m_vTexParams.end() && it->second == param) {
+        g_pHyprOpenGL->m_glCalls.skipped++;
+        return;
+    }
+
+    GLCALL(glTexParameteri(m_iTarget, pname, param));
+    g_pHyprOpenGL->m_glCalls.issued++;
+
+    if (it != m_vTexParams.end())
+        it->second = param;
+    else
+        m_vTexParams.emplace_back(pname, param);
 }
 
 const std::vector<uint8_t>& CTexture::dataCopy() {
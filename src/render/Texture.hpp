@@ -3,9 +3,9 @@
 #include "../defines.hpp"
 #include <aquamarine/buffer/Buffer.hpp>
 #include <hyprutils/math/Misc.hpp>
+#include <hyprutils/math/Region.hpp>
 
 class IHLBuffer;
-HYPRUTILS_FORWARD(Math, CRegion);
 
 enum eTextureType : int8_t {
     TEXTURE_INVALID = -1, // Invalid
@@ -33,7 +33,12 @@ class CTexture {
     void                        destroyTexture();
     void                        allocate();
     void                        update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, const CRegion& damage);
+    // copies the damaged part of pixels aside, for the next flushPendingUpload() to upload and free
+    void                        queueUpdate(uint32_t drmFormat, const uint8_t* pixels, uint32_t stride, const CRegion& damage);
+    void                        flushPendingUpload();
     const std::vector<uint8_t>& dataCopy();
+    // glTexParameteri on m_iTarget, skipped if the texture already has the value. Has to be bound
+    void                        setTexParameter(GLenum pname, GLint param);
 
     eTextureType                m_iType         = TEXTURE_RGBA;
     GLenum                      m_iTarget       = GL_TEXTURE_2D;
@@ -48,8 +53,19 @@ class CTexture {
   private:
     void                 createFromShm(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, const Vector2D& size);
     void                 createFromDma(const Aquamarine::SDMABUFAttrs&, void* image);
+    // pixels starts at origin in the texture
+    void                 upload(uint32_t drmFormat, const uint8_t* pixels, uint32_t stride, const CRegion& damage, const Vector2D& origin);
 
     bool                 m_bKeepDataCopy = false;
 
     std::vector<uint8_t> m_vDataCopy;
+
+    // queued shm updates, coalesced until the texture gets drawn. Staging holds the pixels of m_stagingBox
+    std::vector<uint8_t> m_vStaging;
+    CBox                 m_stagingBox;
+    CRegion              m_pendingDamage;
+    uint32_t             m_iPendingFormat = 0;
+    uint32_t             m_iPendingStride = 0;
+
+    std::vector<std::pair<GLenum, GLint>> m_vTexParams;
 };
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <pango/pangocairo.h>
 #include "../pass/TexPassElement.hpp"
 #include "../pass/RectPassElement.hpp"
+#include "../pass/TextPassElement.hpp"
+#include "../TextEngine.hpp"
 #include "../Renderer.hpp"
 #include "../../managers/input/InputManager.hpp"
 
@@ -15,7 +17,19 @@ static SP<CTexture> m_tGradientInactive       = makeShared<CTexture>();
 static SP<CTexture> m_tGradientLockedActive   = makeShared<CTexture>();
 static SP<CTexture> m_tGradientLockedInactive = makeShared<CTexture>();
 
-constexpr int       BAR_TEXT_PAD = 2;
+// shaped through the text engine, which caches it for the next frames
+static SP<SShapedText> shapeTitle(const std::string& title, bool active, float barWidth, float scale) {
+    static auto FALLBACKFONT             = CConfigValue<std::string>("misc:font_family");
+    static auto PTITLEFONTFAMILY         = CConfigValue<std::string>("group:groupbar:font_family");
+    static auto PTITLEFONTSIZE           = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
+    static auto PTITLEFONTWEIGHTACTIVE   = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_active");
+    static auto PTITLEFONTWEIGHTINACTIVE = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_inactive");
+
+    const auto  FONTWEIGHT = (CFontWeightConfigValueData*)(active ? PTITLEFONTWEIGHTACTIVE : PTITLEFONTWEIGHTINACTIVE).ptr()->getData();
+    const auto  FONTFAMILY = *PTITLEFONTFAMILY != STRVAL_EMPTY ? *PTITLEFONTFAMILY : *FALLBACKFONT;
+
+    return g_pHyprOpenGL->m_pTextEngine->shape(title, {.family = FONTFAMILY, .size = (int)(*PTITLEFONTSIZE * scale), .weight = (int)FONTWEIGHT->m_value}, barWidth - 2);
+}
 
 CHyprGroupBarDecoration::CHyprGroupBarDecoration(PHLWINDOW pWindow) : IHyprWindowDecoration(pWindow), m_pWindow(pWindow) {
     static auto PGRADIENTS = CConfigValue<Hyprlang::INT>("group:groupbar:enabled");
@@ -122,6 +136,7 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
     static auto PINNERGAP                  = CConfigValue<Hyprlang::INT>("group:groupbar:gaps_in");
     static auto PKEEPUPPERGAP              = CConfigValue<Hyprlang::INT>("group:groupbar:keep_upper_gap");
     static auto PTEXTOFFSET                = CConfigValue<Hyprlang::INT>("group:groupbar:text_offset");
+    static auto PTEXTCOLOR                 = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
     auto* const GROUPCOLACTIVE             = (CGradientValueData*)(PGROUPCOLACTIVE.ptr())->getData();
     auto* const GROUPCOLINACTIVE           = (CGradientValueData*)(PGROUPCOLINACTIVE.ptr())->getData();
     auto* const GROUPCOLACTIVELOCKED       = (CGradientValueData*)(PGROUPCOLACTIVELOCKED.ptr())->getData();
@@ -229,27 +244,21 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
             }
 
             if (*PRENDERTITLES) {
-                CTitleTex* pTitleTex = textureFromTitle(m_dwGroupMembers[WINDOWINDEX]->m_title);
-
-                if (!pTitleTex)
-                    pTitleTex =
-                        m_sTitleTexs.titleTexs
-                            .emplace_back(makeUnique<CTitleTex>(m_dwGroupMembers[WINDOWINDEX].lock(),
-                                                                Vector2D{m_fBarWidth * pMonitor->scale, (*PTITLEFONTSIZE + 2L * BAR_TEXT_PAD) * pMonitor->scale}, pMonitor->scale))
-                            .get();
-
-                const auto titleTex = m_dwGroupMembers[WINDOWINDEX] == g_pCompositor->m_lastWindow ? pTitleTex->texActive : pTitleTex->texInactive;
-                rect.y += std::ceil(((rect.height - titleTex->m_vSize.y) / 2.0) - (*PTEXTOFFSET * pMonitor->scale));
-                rect.height = titleTex->m_vSize.y;
-                rect.width  = titleTex->m_vSize.x;
-                rect.x += std::round(((m_fBarWidth * pMonitor->scale) / 2.0) - (titleTex->m_vSize.x / 2.0));
+                const bool ACTIVE = m_dwGroupMembers[WINDOWINDEX] == g_pCompositor->m_lastWindow;
+                const auto TITLE  = shapeTitle(m_dwGroupMembers[WINDOWINDEX]->m_title, ACTIVE, m_fBarWidth * pMonitor->scale, pMonitor->scale);
+
+                rect.y += std::ceil(((rect.height - TITLE->size.y) / 2.0) - (*PTEXTOFFSET * pMonitor->scale));
+                rect.height = TITLE->size.y;
+                rect.width  = TITLE->size.x;
+                rect.x += std::round(((m_fBarWidth * pMonitor->scale) / 2.0) - (TITLE->size.x / 2.0));
                 rect.round();
 
-                CTexPassElement::SRenderData data;
-                data.tex = titleTex;
-                data.box = rect;
-                data.a   = a;
-                g_pHyprRenderer->m_sRenderPass.add(makeShared<CTexPassElement>(data));
+                CTextPassElement::STextData data;
+                data.text  = TITLE;
+                data.pos   = rect.pos();
+                data.color = CHyprColor(*PTEXTCOLOR);
+                data.color.a *= a;
+                g_pHyprRenderer->m_sRenderPass.add(makeShared<CTextPassElement>(data));
             }
         }
 
@@ -258,41 +267,6 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
         else
             xoff += *PINNERGAP + m_fBarWidth;
     }
-
-    if (*PRENDERTITLES)
-        invalidateTextures();
-}
-
-CTitleTex* CHyprGroupBarDecoration::textureFromTitle(const std::string& title) {
-    for (auto const& tex : m_sTitleTexs.titleTexs) {
-        if (tex->szContent == title)
-            return tex.get();
-    }
-
-    return nullptr;
-}
-
-void CHyprGroupBarDecoration::invalidateTextures() {
-    m_sTitleTexs.titleTexs.clear();
-}
-
-CTitleTex::CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize, const float monitorScale) : szContent(pWindow->m_title), pWindowOwner(pWindow) {
-    static auto      FALLBACKFONT     = CConfigValue<std::string>("misc:font_family");
-    static auto      PTITLEFONTFAMILY = CConfigValue<std::string>("group:groupbar:font_family");
-    static auto      PTITLEFONTSIZE   = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
-    static auto      PTEXTCOLOR       = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
-
-    static auto      PTITLEFONTWEIGHTACTIVE   = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_active");
-    static auto      PTITLEFONTWEIGHTINACTIVE = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_inactive");
-
-    const auto       FONTWEIGHTACTIVE   = (CFontWeightConfigValueData*)(PTITLEFONTWEIGHTACTIVE.ptr())->getData();
-    const auto       FONTWEIGHTINACTIVE = (CFontWeightConfigValueData*)(PTITLEFONTWEIGHTINACTIVE.ptr())->getData();
-
-    const CHyprColor COLOR      = CHyprColor(*PTEXTCOLOR);
-    const auto       FONTFAMILY = *PTITLEFONTFAMILY != STRVAL_EMPTY ? *PTITLEFONTFAMILY : *FALLBACKFONT;
-
-    texActive   = g_pHyprOpenGL->renderText(pWindow->m_title, COLOR, *PTITLEFONTSIZE * monitorScale, false, FONTFAMILY, bufferSize.x - 2, FONTWEIGHTACTIVE->m_value);
-    texInactive = g_pHyprOpenGL->renderText(pWindow->m_title, COLOR, *PTITLEFONTSIZE * monitorScale, false, FONTFAMILY, bufferSize.x - 2, FONTWEIGHTINACTIVE->m_value);
 }
 
 static void renderGradientTo(SP<CTexture> tex, CGradientValueData* grad) {
@@ -329,13 +303,13 @@ static void renderGradientTo(SP<CTexture> tex, CGradientValueData* grad) {
     // copy the data to an OpenGL texture we have
     const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
     tex->allocate();
-    glBindTexture(GL_TEXTURE_2D, tex->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    g_pHyprOpenGL->bindTexture(GL_TEXTURE_2D, tex->m_iTexID);
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
 #ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
 #endif
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, bufferSize.x, bufferSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
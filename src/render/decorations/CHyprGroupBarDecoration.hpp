@@ -7,18 +7,6 @@
 #include <string>
 #include "../../helpers/memory/Memory.hpp"
 
-class CTitleTex {
-  public:
-    CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize, const float monitorScale);
-    ~CTitleTex() = default;
-
-    SP<CTexture> texActive;
-    SP<CTexture> texInactive;
-    std::string  szContent;
-
-    PHLWINDOWREF pWindowOwner;
-};
-
 void refreshGroupBarGradients();
 
 class CHyprGroupBarDecoration : public IHyprWindowDecoration {
@@ -58,18 +46,10 @@ class CHyprGroupBarDecoration : public IHyprWindowDecoration {
     float                     m_fBarWidth;
     float                     m_fBarHeight;
 
-    CTitleTex*                textureFromTitle(const std::string&);
-    void                      invalidateTextures();
-
     CBox                      assignedBoxGlobal();
 
     bool                      onBeginWindowDragOnDeco(const Vector2D&);
     bool                      onEndWindowDragOnDeco(const Vector2D&, PHLWINDOW);
     bool                      onMouseButtonOnDeco(const Vector2D&, const IPointer::SButtonEvent&);
     bool                      onScrollOnDeco(const Vector2D&, const IPointer::SAxisEvent);
-
-    struct STitleTexs {
-        // STitleTexs*                            overriden = nullptr; // TODO: make shit shared in-group to decrease VRAM usage.
-        std::vector<UP<CTitleTex>> titleTexs;
-    } m_sTitleTexs;
 };
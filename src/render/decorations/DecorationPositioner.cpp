@@ -59,6 +59,9 @@ Vector2D CDecorationPositioner::getEdgeDefinedPoint(uint32_t edges, PHLWINDOW pW
 }
 
 void CDecorationPositioner::uncacheDecoration(IHyprWindowDecoration* deco) {
+    if (const auto PWINDOW = deco->m_pWindow.lock(); PWINDOW)
+        PWINDOW->invalidateGeometry();
+
     std::erase_if(m_vWindowPositioningDatas, [&](const auto& data) { return !data->pWindow.lock() || data->pDecoration == deco; });
 
     const auto WIT = std::find_if(m_mWindowDatas.begin(), m_mWindowDatas.end(), [&](const auto& other) { return other.first.lock() == deco->m_pWindow.lock(); });
@@ -112,6 +115,8 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
     if (!validMapped(pWindow))
         return;
 
+    pWindow->invalidateGeometry();
+
     const auto WIT = std::find_if(m_mWindowDatas.begin(), m_mWindowDatas.end(), [&](const auto& other) { return other.first.lock() == pWindow; });
     if (WIT == m_mWindowDatas.end())
         return;
@@ -173,6 +178,14 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
     }
 
     WINDOWDATA->reserved = {{reservedXL, reservedYT}, {reservedXR, reservedYB}};
+    pWindow->invalidateGeometry();
+
+    // decorations may read the window's decoration boxes from onPositioningReply, so the cache can't outlive a reply
+    const auto reply = [pWindow](SWindowPositioningData* wd, const SDecorationPositioningReply& positioningReply) {
+        wd->lastReply = positioningReply;
+        pWindow->invalidateGeometry();
+        wd->pDecoration->onPositioningReply(positioningReply);
+    };
 
     float stickyOffsetXL = 0, stickyOffsetYT = 0, stickyOffsetXR = 0, stickyOffsetYB = 0;
 
@@ -201,15 +214,13 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
                     stickyOffsetYB += wd->positioningInfo.desiredExtents.bottomRight.y;
             }
 
-            wd->lastReply = {};
-            wd->pDecoration->onPositioningReply({});
+            reply(wd, {});
             continue;
         }
 
         if (wd->positioningInfo.policy == DECORATION_POSITION_STICKY) {
             if (EDGESNO != 1 && EDGESNO != 4) {
-                wd->lastReply = {};
-                wd->pDecoration->onPositioningReply({});
+                reply(wd, {});
                 continue;
             }
 
@@ -263,30 +274,31 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
                     stickyOffsetYB += desiredSize;
             }
 
-            wd->lastReply = {{pos, size}, EPHEMERAL};
-            wd->pDecoration->onPositioningReply(wd->lastReply);
+            reply(wd, {{pos, size}, EPHEMERAL});
 
             continue;
         } else {
             // invalid
-            wd->lastReply = {};
-            wd->pDecoration->onPositioningReply({});
+            reply(wd, {});
             continue;
         }
     }
 
     if (WINDOWDATA->extents != SBoxExtents{{stickyOffsetXL + reservedXL, stickyOffsetYT + reservedYT}, {stickyOffsetXR + reservedXR, stickyOffsetYB + reservedYB}}) {
         WINDOWDATA->extents = {{stickyOffsetXL + reservedXL, stickyOffsetYT + reservedYT}, {stickyOffsetXR + reservedXR, stickyOffsetYB + reservedYB}};
+        pWindow->invalidateGeometry();
         g_pLayoutManager->getCurrentLayout()->recalculateWindow(pWindow);
     }
 }
 
 void CDecorationPositioner::onWindowUnmap(PHLWINDOW pWindow) {
+    pWindow->invalidateGeometry();
     std::erase_if(m_vWindowPositioningDatas, [&](const auto& data) { return data->pWindow.lock() == pWindow; });
     m_mWindowDatas.erase(pWindow);
 }
 
 void CDecorationPositioner::onWindowMap(PHLWINDOW pWindow) {
+    pWindow->invalidateGeometry();
     m_mWindowDatas[pWindow] = {};
 }
 
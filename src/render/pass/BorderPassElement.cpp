@@ -19,3 +19,7 @@ bool CBorderPassElement::needsLiveBlur() {
 bool CBorderPassElement::needsPrecomputeBlur() {
     return false;
 }
+
+bool CBorderPassElement::usesGLStateCache() {
+    return true;
+}
@@ -21,6 +21,7 @@ class CBorderPassElement : public IPassElement {
     virtual void        draw(const CRegion& damage);
     virtual bool        needsLiveBlur();
     virtual bool        needsPrecomputeBlur();
+    virtual bool        usesGLStateCache();
 
     virtual const char* passName() {
         return "CBorderPassElement";
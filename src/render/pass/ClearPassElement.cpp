@@ -17,6 +17,10 @@ bool CClearPassElement::needsPrecomputeBlur() {
     return false;
 }
 
+bool CClearPassElement::usesGLStateCache() {
+    return true;
+}
+
 std::optional<CBox> CClearPassElement::boundingBox() {
     return CBox{{}, {INT16_MAX, INT16_MAX}};
 }
@@ -13,6 +13,7 @@ class CClearPassElement : public IPassElement {
     virtual void                draw(const CRegion& damage);
     virtual bool                needsLiveBlur();
     virtual bool                needsPrecomputeBlur();
+    virtual bool                usesGLStateCache();
     virtual std::optional<CBox> boundingBox();
     virtual CRegion             opaqueRegion();
 
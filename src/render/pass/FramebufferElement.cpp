@@ -47,6 +47,10 @@ bool CFramebufferElement::needsPrecomputeBlur() {
     return false;
 }
 
+bool CFramebufferElement::usesGLStateCache() {
+    return true;
+}
+
 bool CFramebufferElement::undiscardable() {
     return true;
 }
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <ranges>
 #include "../../config/ConfigValue.hpp"
+#include "../../helpers/math/RegionSimplify.hpp"
 #include "../../desktop/WLSurface.hpp"
 #include "../../managers/SeatManager.hpp"
 #include "../../managers/eventLoop/EventLoopManager.hpp"
@@ -109,10 +110,11 @@ void CRenderPass::clear() {
 
 CRegion CRenderPass::render(const CRegion& damage_) {
     static auto PDEBUGPASS = CConfigValue<Hyprlang::INT>("debug:pass");
+    static auto PRECTCOST  = CConfigValue<Hyprlang::INT>("render:damage_rect_cost");
 
     const auto  WILLBLUR = std::ranges::any_of(m_vPassElements, [](const auto& el) { return el->element->needsLiveBlur(); });
 
-    damage = *PDEBUGPASS ? CRegion{CBox{{}, {INT32_MAX, INT32_MAX}}} : damage_.copy();
+    damage = *PDEBUGPASS ? CRegion{CBox{{}, {INT32_MAX, INT32_MAX}}} : NRegionSimplify::simplify(damage_, std::max<Hyprlang::INT>(*PRECTCOST, 0));
     if (*PDEBUGPASS) {
         occludedRegions.clear();
         totalLiveBlurRegion = CRegion{};
@@ -173,6 +175,9 @@ CRegion CRenderPass::render(const CRegion& damage_) {
     if (m_vPassElements.empty())
         return {};
 
+    // render hooks may have drawn with raw GL while the pass was built
+    g_pHyprOpenGL->invalidateGLState();
+
     for (auto& el : m_vPassElements) {
         if (el->discard) {
             el->element->discard();
@@ -181,6 +186,9 @@ CRegion CRenderPass::render(const CRegion& damage_) {
 
         g_pHyprOpenGL->m_RenderData.damage = el->elementDamage;
         el->element->draw(el->elementDamage);
+
+        if (!el->element->usesGLStateCache())
+            g_pHyprOpenGL->invalidateGLState();
     }
 
     if (*PDEBUGPASS) {
@@ -12,6 +12,10 @@ bool IPassElement::disableSimplification() {
     return false;
 }
 
+bool IPassElement::usesGLStateCache() {
+    return false;
+}
+
 void IPassElement::discard() {
     ;
 }
@@ -16,4 +16,5 @@ class IPassElement {
     virtual std::optional<CBox> boundingBox();  // in monitor-local logical coordinates
     virtual CRegion             opaqueRegion(); // in monitor-local logical coordinates
     virtual bool                disableSimplification();
+    virtual bool                usesGLStateCache(); // draws only through CHyprOpenGLImpl. Otherwise its GL state cache is dropped after draw()
 };
@@ -15,6 +15,10 @@ bool CPreBlurElement::needsPrecomputeBlur() {
     return false;
 }
 
+bool CPreBlurElement::usesGLStateCache() {
+    return true;
+}
+
 bool CPreBlurElement::disableSimplification() {
     return true;
 }
@@ -9,6 +9,7 @@ class CPreBlurElement : public IPassElement {
     virtual void        draw(const CRegion& damage);
     virtual bool        needsLiveBlur();
     virtual bool        needsPrecomputeBlur();
+    virtual bool        usesGLStateCache();
     virtual bool        disableSimplification();
     virtual bool        undiscardable();
 
@@ -28,6 +28,10 @@ bool CRectPassElement::needsPrecomputeBlur() {
     return data.color.a < 1.F && data.xray && data.blur;
 }
 
+bool CRectPassElement::usesGLStateCache() {
+    return true;
+}
+
 std::optional<CBox> CRectPassElement::boundingBox() {
     return data.box.copy().scale(1.F / g_pHyprOpenGL->m_RenderData.pMonitor->scale).round();
 }
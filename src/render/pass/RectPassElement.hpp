@@ -19,6 +19,7 @@ class CRectPassElement : public IPassElement {
     virtual void                draw(const CRegion& damage);
     virtual bool                needsLiveBlur();
     virtual bool                needsPrecomputeBlur();
+    virtual bool                usesGLStateCache();
     virtual std::optional<CBox> boundingBox();
     virtual CRegion             opaqueRegion();
 
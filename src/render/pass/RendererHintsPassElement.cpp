@@ -18,6 +18,10 @@ bool CRendererHintsPassElement::needsPrecomputeBlur() {
     return false;
 }
 
+bool CRendererHintsPassElement::usesGLStateCache() {
+    return true;
+}
+
 bool CRendererHintsPassElement::undiscardable() {
     return true;
 }
@@ -15,6 +15,7 @@ class CRendererHintsPassElement : public IPassElement {
     virtual void        draw(const CRegion& damage);
     virtual bool        needsLiveBlur();
     virtual bool        needsPrecomputeBlur();
+    virtual bool        usesGLStateCache();
     virtual bool        undiscardable();
 
     virtual const char* passName() {
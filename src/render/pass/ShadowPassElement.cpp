@@ -16,4 +16,8 @@ bool CShadowPassElement::needsLiveBlur() {
 
 bool CShadowPassElement::needsPrecomputeBlur() {
     return false;
+}
+
+bool CShadowPassElement::usesGLStateCache() {
+    return true;
 }
\ No newline at end of file
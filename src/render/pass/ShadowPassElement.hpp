@@ -16,6 +16,7 @@ class CShadowPassElement : public IPassElement {
     virtual void        draw(const CRegion& damage);
     virtual bool        needsLiveBlur();
     virtual bool        needsPrecomputeBlur();
+    virtual bool        usesGLStateCache();
 
     virtual const char* passName() {
         return "CShadowPassElement";
@@ -51,6 +51,9 @@ void CSurfacePassElement::draw(const CRegion& damage) {
     if (!TEXTURE->m_iTexID)
         return;
 
+    // shm damage since the last time this was drawn
+    TEXTURE->flushPendingUpload();
+
     const auto INTERACTIVERESIZEINPROGRESS = data.pWindow && g_pInputManager->currentlyDraggedWindow && g_pInputManager->dragMode == MBIND_RESIZE;
     TRACY_GPU_ZONE("RenderSurface");
 
@@ -209,6 +212,10 @@ bool CSurfacePassElement::needsPrecomputeBlur() {
     return BLUR && NEWOPTIM;
 }
 
+bool CSurfacePassElement::usesGLStateCache() {
+    return true;
+}
+
 std::optional<CBox> CSurfacePassElement::boundingBox() {
     return getTexBox();
 }
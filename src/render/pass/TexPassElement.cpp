@@ -22,6 +22,10 @@ void CTexPassElement::draw(const CRegion& damage) {
 
     if (data.replaceProjection)
         g_pHyprOpenGL->m_RenderData.monitorProjection = *data.replaceProjection;
+
+    // surface textures drawn directly, like the dnd icon, can have shm damage queued
+    data.tex->flushPendingUpload();
+
     g_pHyprOpenGL->renderTextureInternalWithDamage(data.tex, data.box, data.a, data.damage.empty() ? damage : data.damage, data.round, data.roundingPower);
     if (data.replaceProjection)
         g_pHyprOpenGL->m_RenderData.monitorProjection = g_pHyprOpenGL->m_RenderData.pMonitor->projMatrix;
@@ -35,6 +39,10 @@ bool CTexPassElement::needsPrecomputeBlur() {
     return false; // TODO?
 }
 
+bool CTexPassElement::usesGLStateCache() {
+    return true;
+}
+
 std::optional<CBox> CTexPassElement::boundingBox() {
     return data.box.copy().scale(1.F / g_pHyprOpenGL->m_RenderData.pMonitor->scale).round();
 }
@@ -26,6 +26,7 @@ class CTexPassElement : public IPassElement {
     virtual void                draw(const CRegion& damage);
     virtual bool                needsLiveBlur();
     virtual bool                needsPrecomputeBlur();
+    virtual bool                usesGLStateCache();
     virtual std::optional<CBox> boundingBox();
     virtual CRegion             opaqueRegion();
     virtual void                discard();
@@ -0,0 +1,32 @@
+#include "TextPassElement.hpp"
+#include "../OpenGL.hpp"
+#include "../TextEngine.hpp"
+
+CTextPassElement::CTextPassElement(const CTextPassElement::STextData& data_) : data(data_) {
+    ;
+}
+
+void CTextPassElement::draw(const CRegion& damage) {
+    if (!data.clipBox.empty())
+        g_pHyprOpenGL->m_RenderData.clipBox = data.clipBox;
+
+    g_pHyprOpenGL->renderShapedText(data.text, data.pos, data.color, damage);
+
+    g_pHyprOpenGL->m_RenderData.clipBox = {};
+}
+
+bool CTextPassElement::needsLiveBlur() {
+    return false;
+}
+
+bool CTextPassElement::needsPrecomputeBlur() {
+    return false;
+}
+
+bool CTextPassElement::usesGLStateCache() {
+    return true;
+}
+
+std::optional<CBox> CTextPassElement::boundingBox() {
+    return CBox{data.pos, data.text->size}.scale(1.F / g_pHyprOpenGL->m_RenderData.pMonitor->scale).round();
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "PassElement.hpp"
+
+struct SShapedText;
+
+class CTextPassElement : public IPassElement {
+  public:
+    struct STextData {
+        SP<SShapedText> text;
+        Vector2D        pos; // top left, in monitor-local pixels
+        CHyprColor      color;
+        CBox            clipBox;
+    };
+
+    CTextPassElement(const STextData& data);
+    virtual ~CTextPassElement() = default;
+
+    virtual void                draw(const CRegion& damage);
+    virtual bool                needsLiveBlur();
+    virtual bool                needsPrecomputeBlur();
+    virtual bool                usesGLStateCache();
+    virtual std::optional<CBox> boundingBox();
+
+    virtual const char*         passName() {
+        return "CTextPassElement";
+    }
+
+  private:
+    STextData data;
+};
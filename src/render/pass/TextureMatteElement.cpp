@@ -22,4 +22,8 @@ bool CTextureMatteElement::needsLiveBlur() {
 
 bool CTextureMatteElement::needsPrecomputeBlur() {
     return false;
+}
+
+bool CTextureMatteElement::usesGLStateCache() {
+    return true;
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ class CTextureMatteElement : public IPassElement {
     virtual void        draw(const CRegion& damage);
     virtual bool        needsLiveBlur();
     virtual bool        needsPrecomputeBlur();
+    virtual bool        usesGLStateCache();
 
     virtual const char* passName() {
         return "CTextureMatteElement";
@@ -0,0 +1,9 @@
+precision highp float;
+varying vec2 v_texcoord;
+uniform sampler2D tex;
+uniform vec4 color; // premultiplied
+
+void main() {
+    // glyphs are white with coverage in alpha, colored ones (emoji) keep their color where color is white
+    gl_FragColor = texture2D(tex, v_texcoord) * color;
+}
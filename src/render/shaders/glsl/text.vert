@@ -0,0 +1,13 @@
+uniform mat3 proj;
+uniform vec2 fullSize;
+attribute vec2 pos;
+// per glyph: x, y, w, h in px from the top left of the text, then its rect in the atlas
+attribute vec4 glyphBox;
+attribute vec4 glyphUV;
+varying vec2 v_texcoord;
+
+void main() {
+    vec2 textPos = (glyphBox.xy + pos * glyphBox.zw) / fullSize;
+    gl_Position = vec4(proj * vec3(textPos, 1.0), 1.0);
+    v_texcoord = mix(glyphUV.xy, glyphUV.zw, pos);
+}
@@ -28,11 +28,14 @@ static int onX11Event(int fd, uint32_t mask, void* data) {
 }
 
 SP<CXWaylandSurface> CXWM::windowForXID(xcb_window_t wid) {
-    for (auto const& s : surfaces) {
-        if (s->xID == wid)
-            return s;
-    }
+    auto it = surfacesByXID.find(wid);
+    if (it == surfacesByXID.end())
+        return nullptr;
+
+    if (const auto XSURF = it->second.lock(); XSURF && XSURF->xID == wid)
+        return XSURF;
 
+    surfacesByXID.erase(it);
     return nullptr;
 }
 
@@ -40,12 +43,14 @@ void CXWM::handleCreate(xcb_create_notify_event_t* e) {
     if (isWMWindow(e->window))
         return;
 
-    const auto XSURF = surfaces.emplace_back(SP<CXWaylandSurface>(new CXWaylandSurface(e->window, CBox{e->x, e->y, e->width, e->height}, e->override_redirect)));
-    XSURF->self      = XSURF;
+    const auto XSURF         = surfaces.emplace_back(SP<CXWaylandSurface>(new CXWaylandSurface(e->window, CBox{e->x, e->y, e->width, e->height}, e->override_redirect)));
+    XSURF->self              = XSURF;
+    surfacesByXID[e->window] = XSURF;
     Debug::log(LOG, "[xwm] New XSurface at {:x} with xid of {}", (uintptr_t)XSURF.get(), e->window);
 
     const auto WINDOW = CWindow::create(XSURF);
     g_pCompositor->m_windows.emplace_back(WINDOW);
+    g_pCompositor->indexWindow(WINDOW);
     WINDOW->m_self = WINDOW;
     Debug::log(LOG, "[xwm] New XWayland window at {:x} for surf {:x}", (uintptr_t)WINDOW.get(), (uintptr_t)XSURF.get());
 }
@@ -57,6 +62,7 @@ void CXWM::handleDestroy(xcb_destroy_notify_event_t* e) {
         return;
 
     XSURF->events.destroy.emit();
+    surfacesByXID.erase(e->window);
     std::erase_if(surfaces, [XSURF](const auto& other) { return XSURF == other; });
 }
 
@@ -178,6 +184,9 @@ std::string CXWM::getAtomName(uint32_t atom) {
         return ha.first;
     }
 
+    if (auto it = atomNames.find(atom); it != atomNames.end())
+        return it->second;
+
     // Get the name of the atom
     auto const atom_name_cookie = xcb_get_atom_name(connection, atom);
     auto*      atom_name_reply  = xcb_get_atom_name_reply(connection, atom_name_cookie, nullptr);
@@ -185,11 +194,13 @@ std::string CXWM::getAtomName(uint32_t atom) {
     if (!atom_name_reply)
         return "Unknown";
 
-    auto const name_len = xcb_get_atom_name_name_length(atom_name_reply);
-    auto*      name     = xcb_get_atom_name_name(atom_name_reply);
+    auto const  name_len = xcb_get_atom_name_name_length(atom_name_reply);
+    auto*       name     = xcb_get_atom_name_name(atom_name_reply);
+    std::string atomName{name, (size_t)name_len};
     free(atom_name_reply);
 
-    return {name, name_len};
+    atomNames[atom] = atomName;
+    return atomName;
 }
 
 void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_reply_t* reply) {
@@ -308,16 +319,39 @@ void CXWM::handlePropertyNotify(xcb_property_notify_event_t* e) {
     if (!XSURF)
         return;
 
-    xcb_get_property_cookie_t cookie = xcb_get_property(connection, 0, XSURF->xID, e->atom, XCB_ATOM_ANY, 0, 2048);
-    xcb_get_property_reply_t* reply  = xcb_get_property_reply(connection, cookie, nullptr);
-    if (!reply) {
-        Debug::log(ERR, "[xwm] Failed to read property notify cookie");
-        return;
-    }
+    // the reply is read once it's in, see readPendingProperties
+    pendingProperties.emplace_back(SPendingProperty{XSURF, e->atom, xcb_get_property(connection, 0, XSURF->xID, e->atom, XCB_ATOM_ANY, 0, 2048)});
+}
 
-    readProp(XSURF, e->atom, reply);
+void CXWM::readPendingProperties(bool block) {
+    while (!pendingProperties.empty()) {
+        const auto                PENDING = pendingProperties.front();
+        xcb_get_property_reply_t* reply   = nullptr;
 
-    free(reply);
+        if (block)
+            reply = xcb_get_property_reply(connection, PENDING.cookie, nullptr);
+        else {
+            xcb_generic_error_t* error = nullptr;
+            // replies come in order, if this one isn't here the rest aren't either
+            if (!xcb_poll_for_reply(connection, PENDING.cookie.sequence, (void**)&reply, &error))
+                break;
+
+            free(error);
+        }
+
+        // readProp can end up back here
+        pendingProperties.pop_front();
+
+        if (!reply) {
+            Debug::log(ERR, "[xwm] Failed to read property notify cookie");
+            continue;
+        }
+
+        if (const auto XSURF = PENDING.surface.lock(); XSURF)
+            readProp(XSURF, PENDING.atom, reply);
+
+        free(reply);
+    }
 }
 
 void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
@@ -549,12 +583,17 @@ xcb_atom_t CXWM::mimeToAtom(const std::string& mime) {
     if (mime == "text/plain")
         return HYPRATOMS["TEXT"];
 
+    if (auto it = mimeAtoms.find(mime); it != mimeAtoms.end())
+        return it->second;
+
     xcb_intern_atom_cookie_t cookie = xcb_intern_atom(connection, 0, mime.length(), mime.c_str());
     xcb_intern_atom_reply_t* reply  = xcb_intern_atom_reply(connection, cookie, nullptr);
     if (!reply)
         return XCB_ATOM_NONE;
     xcb_atom_t atom = reply->atom;
     free(reply);
+    mimeAtoms[mime] = atom;
+    atomNames[atom] = mime;
     return atom;
 }
 
@@ -564,6 +603,9 @@ std::string CXWM::mimeFromAtom(xcb_atom_t atom) {
     if (atom == HYPRATOMS["TEXT"])
         return "text/plain";
 
+    if (auto it = atomNames.find(atom); it != atomNames.end())
+        return it->second;
+
     xcb_get_atom_name_cookie_t cookie = xcb_get_atom_name(connection, atom);
     xcb_get_atom_name_reply_t* reply  = xcb_get_atom_name_reply(connection, cookie, nullptr);
     if (!reply)
@@ -572,6 +614,7 @@ std::string CXWM::mimeFromAtom(xcb_atom_t atom) {
     char*       buf = xcb_get_atom_name_name(reply); // not a C string
     std::string SZNAME{buf, len};
     free(reply);
+    atomNames[atom] = SZNAME;
     return SZNAME;
 }
 
@@ -775,8 +818,14 @@ int CXWM::onEvent(int fd, uint32_t mask) {
 
     while (42069) {
         xcb_generic_event_t* event = xcb_poll_for_event(connection);
-        if (!event)
-            break;
+        if (!event) {
+            readPendingProperties(false);
+
+            // polling for replies can read events off the socket, those won't wake us up again
+            event = xcb_poll_for_queued_event(connection);
+            if (!event)
+                break;
+        }
 
         count++;
 
@@ -785,6 +834,10 @@ int CXWM::onEvent(int fd, uint32_t mask) {
             continue;
         }
 
+        // handlers read properties (size hints on map, state on messages), the ones notified before have to be in
+        if ((event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK) != XCB_PROPERTY_NOTIFY)
+            readPendingProperties(true);
+
         switch (event->response_type & XCB_EVENT_RESPONSE_TYPE_MASK) {
             case XCB_CREATE_NOTIFY: handleCreate((xcb_create_notify_event_t*)event); break;
             case XCB_DESTROY_NOTIFY: handleDestroy((xcb_destroy_notify_event_t*)event); break;
@@ -816,9 +869,16 @@ void CXWM::gatherResources() {
     xcb_prefetch_extension_data(connection, &xcb_composite_id);
     xcb_prefetch_extension_data(connection, &xcb_res_id);
 
+    // ask for all of them first, then wait once
+    std::vector<xcb_intern_atom_cookie_t> cookies;
+    cookies.reserve(HYPRATOMS.size());
+    for (auto const& ATOM : HYPRATOMS) {
+        cookies.emplace_back(xcb_intern_atom(connection, 0, ATOM.first.length(), ATOM.first.c_str()));
+    }
+
+    size_t i = 0;
     for (auto& ATOM : HYPRATOMS) {
-        xcb_intern_atom_cookie_t cookie = xcb_intern_atom(connection, 0, ATOM.first.length(), ATOM.first.c_str());
-        xcb_intern_atom_reply_t* reply  = xcb_intern_atom_reply(connection, cookie, nullptr);
+        xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(connection, cookies[i++], nullptr);
 
         if (!reply) {
             Debug::log(ERR, "[xwm] Atom failed: {}", ATOM.first);
@@ -1082,9 +1142,16 @@ void CXWM::readWindowData(SP<CXWaylandSurface> surf) {
         HYPRATOMS["WM_PROTOCOLS"],
     };
 
+    std::array<xcb_get_property_cookie_t, interestingProps.size()> cookies;
+    for (size_t i = 0; i < interestingProps.size(); i++) {
+        cookies[i] = xcb_get_property(connection, 0, surf->xID, interestingProps[i], XCB_ATOM_ANY, 0, 2048);
+    }
+
+    // older notify replies come first, and must not override what's read here
+    readPendingProperties(true);
+
     for (size_t i = 0; i < interestingProps.size(); i++) {
-        xcb_get_property_cookie_t cookie = xcb_get_property(connection, 0, surf->xID, interestingProps[i], XCB_ATOM_ANY, 0, 2048);
-        xcb_get_property_reply_t* reply  = xcb_get_property_reply(connection, cookie, nullptr);
+        xcb_get_property_reply_t* reply = xcb_get_property_reply(connection, cookies[i], nullptr);
         if (!reply) {
             Debug::log(ERR, "[xwm] Failed to get window property");
             continue;
@@ -1095,11 +1162,14 @@ void CXWM::readWindowData(SP<CXWaylandSurface> surf) {
 }
 
 SP<CXWaylandSurface> CXWM::windowForWayland(SP<CWLSurfaceResource> surf) {
-    for (auto& s : surfaces) {
-        if (s->surface == surf)
-            return s;
-    }
+    auto it = surfacesByWayland.find(surf.get());
+    if (it == surfacesByWayland.end())
+        return nullptr;
 
+    if (const auto XSURF = it->second.lock(); XSURF && XSURF->surface == surf)
+        return XSURF;
+
+    surfacesByWayland.erase(it);
     return nullptr;
 }
 
@@ -1107,14 +1177,13 @@ void CXWM::associate(SP<CXWaylandSurface> surf, SP<CWLSurfaceResource> wlSurf) {
     if (surf->surface)
         return;
 
-    auto existing = std::find_if(surfaces.begin(), surfaces.end(), [wlSurf](const auto& e) { return e->surface == wlSurf; });
-
-    if (existing != surfaces.end()) {
+    if (windowForWayland(wlSurf)) {
         Debug::log(WARN, "[xwm] associate() called but surface is already associated to {:x}, ignoring...", (uintptr_t)surf.get());
         return;
     }
 
-    surf->surface = wlSurf;
+    surf->surface                   = wlSurf;
+    surfacesByWayland[wlSurf.get()] = surf;
     surf->ensureListeners();
 
     readWindowData(surf);
@@ -1129,6 +1198,7 @@ void CXWM::dissociate(SP<CXWaylandSurface> surf) {
     if (surf->mapped)
         surf->unmap();
 
+    surfacesByWayland.erase(surf->surface.get());
     surf->surface.reset();
     surf->events.resourceChange.emit();
 
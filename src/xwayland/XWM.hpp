@@ -12,6 +12,9 @@
 #include <xcb/xcb_errors.h>
 #include <hyprutils/os/FileDescriptor.hpp>
 
+#include <deque>
+#include <unordered_map>
+
 struct wl_event_source;
 class CXWaylandSurfaceResource;
 struct SXSelection;
@@ -170,6 +173,8 @@ class CXWM {
     void         getTransferData(SXSelection& sel);
     std::string  getAtomName(uint32_t atom);
     void         readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_reply_t* reply);
+    // reads the replies to property notifies that are in. With block, waits for all of them.
+    void         readPendingProperties(bool block);
 
     SXSelection* getSelection(xcb_atom_t atom);
 
@@ -211,6 +216,21 @@ class CXWM {
         CHyprSignalListener newXShellSurface;
     } listeners;
 
+    // entries are checked on lookup, XSurface can reset the wl surface on its own
+    std::unordered_map<xcb_window_t, WP<CXWaylandSurface>>        surfacesByXID;
+    std::unordered_map<CWLSurfaceResource*, WP<CXWaylandSurface>> surfacesByWayland;
+
+    // atoms never change once interned, no need to ask twice
+    std::unordered_map<xcb_atom_t, std::string>                   atomNames;
+    std::unordered_map<std::string, xcb_atom_t>                   mimeAtoms;
+
+    struct SPendingProperty {
+        WP<CXWaylandSurface>      surface;
+        xcb_atom_t                atom = 0;
+        xcb_get_property_cookie_t cookie;
+    };
+    std::deque<SPendingProperty> pendingProperties; // in request order
+
     friend class CXWaylandSurface;
     friend class CXWayland;
     friend class CXDataSource;